@@ -0,0 +1,353 @@
+// yggdrasilleon-bench: times every entry point of Algorithms.hpp on
+// synthetic graph families from 1e2 to 1e7 edges.
+//
+// Benchmarks are named <algorithm>/<family>/<edges>. Runs use a disabled
+// StepLog so only the algorithm itself is measured. Algorithms whose cost
+// explodes on a given graph (Floyd-Warshall's V^3) are only registered
+// where they finish in reasonable time.
+// Floyd-Warshall is also timed once per min-plus kernel the CPU supports
+// (floydWarshall-scalar, floydWarshall-avx2, ...).
+// dijkstra runs on the radix heap and primMST on the indexed 4-ary heap;
+// the -lazy entries time them on a lazy-deletion std::priority_queue and
+// dijkstra-quad on the 4-ary heap (see PriorityQueue.hpp).
+// bidirectionalDijkstra and aStar route from the first vertex to the middle
+// one and report the share of vertices they settle (settled_fraction).
+// contractionHierarchy and landmarkAStar answer the same queries from a
+// route index built once per graph; its build time is reported as prep_ms.
+// The hierarchy is only built on the road-like families (grid, chain).
+// YGGDRASILLEON_BENCH_MAX_EDGES caps the largest size (default 1e7).
+
+#include "Algorithms.hpp"
+#include "ContractionHierarchy.hpp"
+#include "FloydWarshall.hpp"
+#include "Generators.hpp"
+#include "BenchSupport.hpp"
+#include "Landmarks.hpp"
+#include "PointToPoint.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+
+namespace {
+
+// ---- Synthetic graph families ----
+// Each family aims for roughly `edges` undirected edges with weights 1..100.
+// Grid, Erdos-Renyi and power-law come from the engine's generators;
+// complete graphs and chains are built here.
+
+GeneratorParams generatorFor(GeneratorKind kind, std::size_t nodes, std::size_t edges) {
+    GeneratorParams params;
+    params.kind = kind;
+    params.nodes = nodes;
+    params.edges = edges;
+    params.seed = edges * 7919 + 17;
+    return params;
+}
+
+std::size_t completeVertices(std::size_t edges) {
+    return (std::size_t)std::ceil((1.0 + std::sqrt(1.0 + 8.0 * edges)) / 2.0);
+}
+
+EdgeList buildComplete(std::size_t edges) {
+    EdgeList list;
+    list.nodeCount = completeVertices(edges);
+    std::mt19937_64 rng(edges);
+    for (NodeId u = 0; u < list.nodeCount; ++u) {
+        for (NodeId v = u + 1; v < list.nodeCount; ++v) {
+            list.from.push_back(u);
+            list.to.push_back(v);
+            list.weights.push_back((int)(rng() % 100) + 1);
+        }
+    }
+    return list;
+}
+
+EdgeList buildChain(std::size_t edges) {
+    EdgeList list;
+    list.nodeCount = edges + 1;
+    std::mt19937_64 rng(edges);
+    for (NodeId v = 0; v < edges; ++v) {
+        list.from.push_back(v);
+        list.to.push_back(v + 1);
+        list.weights.push_back((int)(rng() % 100) + 1);
+    }
+    return list;
+}
+
+struct Family {
+    const char *name;
+    std::size_t (*vertices)(std::size_t edges); // vertex count for an edge target
+    EdgeList (*build)(std::size_t edges);
+};
+
+const Family families[] = {
+    {"grid",
+     [](std::size_t edges) { return std::max<std::size_t>(4, edges / 2); },
+     [](std::size_t edges) {
+         EdgeList list;
+         generateEdges(generatorFor(GeneratorKind::Grid, std::max<std::size_t>(4, edges / 2), edges), list);
+         return list;
+     }},
+    {"erdos-renyi",
+     [](std::size_t edges) { return std::max<std::size_t>(2, edges / 4); },
+     [](std::size_t edges) {
+         EdgeList list;
+         generateEdges(generatorFor(GeneratorKind::ErdosRenyi, std::max<std::size_t>(2, edges / 4), edges), list);
+         return list;
+     }},
+    {"power-law",
+     [](std::size_t edges) { return std::max<std::size_t>(5, edges / 4); },
+     [](std::size_t edges) {
+         EdgeList list;
+         generateEdges(generatorFor(GeneratorKind::BarabasiAlbert, std::max<std::size_t>(5, edges / 4), edges), list);
+         return list;
+     }},
+    {"complete", completeVertices, buildComplete},
+    {"chain", [](std::size_t edges) { return edges + 1; }, buildChain},
+};
+
+// A family's graph with the generator's layout (empty if it has none).
+// Route indexes are built by the first benchmark that queries them and
+// kept with the graph, as a long-running service would keep them.
+struct Snapshot {
+    CsrGraph graph;
+    std::shared_ptr<const std::vector<Point>> coordinates;
+    mutable std::unique_ptr<RouteSearch> search{};
+    mutable std::unique_ptr<ContractionHierarchy> hierarchy{};
+    mutable std::unique_ptr<ContractionHierarchy::Query> hierarchyQuery{};
+    mutable std::unique_ptr<LandmarkIndex> landmarks{};
+    mutable double searchMs = 0, hierarchyMs = 0, landmarksMs = 0;
+};
+
+// Benchmarks are registered family by family, size by size, so consecutive
+// runs share the graph; only the most recent snapshot is kept alive.
+const Snapshot &snapshotFor(const Family &family, std::size_t edges) {
+    static std::string cachedKey;
+    static std::unique_ptr<Snapshot> cached;
+
+    std::string key = std::string(family.name) + "/" + std::to_string(edges);
+    if (key != cachedKey) {
+        cached.reset();
+        EdgeList list = family.build(edges);
+        auto coordinates = std::make_shared<const std::vector<Point>>(std::move(list.coordinates));
+        cached = std::make_unique<Snapshot>(Snapshot{toCsr(list), std::move(coordinates)});
+        cachedKey = key;
+    }
+    return *cached;
+}
+
+const CsrGraph &graphFor(const Family &family, std::size_t edges) {
+    return snapshotFor(family, edges).graph;
+}
+
+// ---- Algorithms under test ----
+struct Algorithm {
+    const char *name;
+    std::function<void(const CsrGraph &, const std::string &start, StepLog &)> run;
+    // whether a graph with V vertices and E edges is worth running
+    std::function<bool(std::size_t V, std::size_t E)> feasible;
+};
+
+bool always(std::size_t, std::size_t) { return true; }
+
+const Algorithm algorithms[] = {
+    {"dfs",           [](const CsrGraph &g, const std::string &s, StepLog &l) { dfs(g, s, l); }, always},
+    {"bfs",           [](const CsrGraph &g, const std::string &s, StepLog &l) { bfs(g, s, l); }, always},
+    {"dijkstra",      [](const CsrGraph &g, const std::string &s, StepLog &l) { dijkstra(g, s, l); }, always},
+    {"dijkstra-lazy", [](const CsrGraph &g, const std::string &s, StepLog &l) { dijkstra<LazyHeap>(g, s, l); }, always},
+    {"dijkstra-quad", [](const CsrGraph &g, const std::string &s, StepLog &l) { dijkstra<QuadHeap>(g, s, l); }, always},
+    {"deltaStepping", [](const CsrGraph &g, const std::string &s, StepLog &l) { deltaStepping(g, s, l); }, always},
+    {"bellmanFord",   [](const CsrGraph &g, const std::string &s, StepLog &l) { bellmanFord(g, s, l); }, always},
+    {"floydWarshall", [](const CsrGraph &g, const std::string &, StepLog &l) { floydWarshall(g, l); },
+                      [](std::size_t V, std::size_t) { return V <= 1024; }},
+    {"primMST",       [](const CsrGraph &g, const std::string &s, StepLog &l) { primMST(g, s, l); }, always},
+    {"primMST-lazy",  [](const CsrGraph &g, const std::string &s, StepLog &l) { primMST<LazyHeap>(g, s, l); }, always},
+    {"kruskalMST",    [](const CsrGraph &g, const std::string &, StepLog &l) { kruskalMST(g, l); }, always},
+    {"boruvkaMST",    [](const CsrGraph &g, const std::string &, StepLog &l) { boruvkaMST(g, l); }, always},
+    {"detectCycles",  [](const CsrGraph &g, const std::string &, StepLog &l) { detectCycles(g, l); }, always},
+    {"strongComponents", [](const CsrGraph &g, const std::string &, StepLog &l) { stronglyConnectedComponents(g, l); },
+                      always},
+};
+
+// Milliseconds `build` takes
+template <typename Build>
+double timed(Build build) {
+    auto begin = std::chrono::steady_clock::now();
+    build();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+// Point-to-point searches, from the first vertex to the middle one, run
+// without steps to report how much of the graph each query settles.
+// `prepare` builds the index a search needs (if the snapshot has none yet)
+// and returns how long that took; the searches without an index reuse one
+// RouteSearch, as RouteIndex does for the GUI and CLI.
+struct RouteAlgorithm {
+    const char *name;
+    bool (*run)(const Snapshot &snapshot, CsrGraph::Vertex source, CsrGraph::Vertex target, Route &out);
+    double (*prepare)(const Snapshot &snapshot) = nullptr;
+    bool (*feasible)(const Family &family, std::size_t edges) = nullptr;
+};
+
+// The snapshot's RouteSearch, set up with its coordinates
+double prepareSearch(const Snapshot &s) {
+    if (!s.search) {
+        s.searchMs = timed([&] {
+            s.search = std::make_unique<RouteSearch>(s.graph);
+            s.search->setCoordinates(s.coordinates);
+        });
+    }
+    return s.searchMs;
+}
+
+const RouteAlgorithm routeAlgorithms[] = {
+    {"bidirectionalDijkstra",
+     [](const Snapshot &s, CsrGraph::Vertex from, CsrGraph::Vertex to, Route &r) {
+         return s.search->bidirectional(from, to, r);
+     },
+     prepareSearch},
+    // straight-line heuristic on grids, plain Dijkstra stopping at the target elsewhere
+    {"aStar",
+     [](const Snapshot &s, CsrGraph::Vertex from, CsrGraph::Vertex to, Route &r) {
+         return s.search->aStar(from, to, s.search->euclidean(to), r);
+     },
+     prepareSearch},
+    {"contractionHierarchy",
+     [](const Snapshot &s, CsrGraph::Vertex from, CsrGraph::Vertex to, Route &r) {
+         s.hierarchyQuery->route(from, to, r);
+         return true;
+     },
+     [](const Snapshot &s) {
+         if (!s.hierarchy) {
+             s.hierarchy = std::make_unique<ContractionHierarchy>();
+             s.hierarchyMs = timed([&] { s.hierarchy->build(s.graph); });
+             s.hierarchyQuery = std::make_unique<ContractionHierarchy::Query>(*s.hierarchy);
+         }
+         return s.hierarchyMs;
+     },
+     // dense and power-law graphs stay mostly uncontracted (see ContractionHierarchy.hpp)
+     [](const Family &family, std::size_t edges) {
+         std::string name = family.name;
+         return (name == "grid" || name == "chain") && edges <= 1000000;
+     }},
+    {"landmarkAStar",
+     [](const Snapshot &s, CsrGraph::Vertex from, CsrGraph::Vertex to, Route &r) {
+         return s.search->aStar(from, to, s.landmarks->heuristic(to), r);
+     },
+     [](const Snapshot &s) {
+         if (!s.landmarks) {
+             s.landmarks = std::make_unique<LandmarkIndex>();
+             s.landmarksMs = timed([&] { s.landmarks->build(s.graph); });
+         }
+         return prepareSearch(s) + s.landmarksMs;
+     }},
+};
+
+void runBenchmark(benchmark::State &state, const Family *family, std::size_t edgeTarget,
+                  const Algorithm *algorithm) {
+    const CsrGraph &graph = graphFor(*family, edgeTarget);
+    const std::string start = graph.vertexCount() ? graph.name(0) : std::string();
+    StepLog steps(false);
+
+    resetPeakRss();
+    AllocationScope allocations;
+    for (auto _ : state) {
+        algorithm->run(graph, start, steps);
+        benchmark::ClobberMemory();
+    }
+    reportCounters(state, graph.edgeCount(), allocations.stats());
+    state.counters["vertices"] = (double)graph.vertexCount();
+}
+
+void runRouteBenchmark(benchmark::State &state, const Family *family, std::size_t edgeTarget,
+                       const RouteAlgorithm *algorithm) {
+    const Snapshot &snapshot = snapshotFor(*family, edgeTarget);
+    const CsrGraph &graph = snapshot.graph;
+    const CsrGraph::Vertex target = (CsrGraph::Vertex)(graph.vertexCount() / 2);
+    const double prepMs = algorithm->prepare ? algorithm->prepare(snapshot) : 0;
+    Route route;
+
+    resetPeakRss();
+    AllocationScope allocations;
+    for (auto _ : state) {
+        algorithm->run(snapshot, 0, target, route);
+        benchmark::ClobberMemory();
+    }
+    reportCounters(state, graph.edgeCount(), allocations.stats());
+    state.counters["vertices"] = (double)graph.vertexCount();
+    state.counters["settled_fraction"] = graph.vertexCount() ? (double)route.settled / graph.vertexCount() : 0;
+    if (algorithm->prepare) state.counters["prep_ms"] = prepMs;
+}
+
+// Same as the floydWarshall entry, with the min-plus kernel pinned
+void runFloydWarshallKernel(benchmark::State &state, const Family *family, std::size_t edgeTarget, FwKernel kernel) {
+    const CsrGraph &graph = graphFor(*family, edgeTarget);
+    StepLog steps(false);
+
+    fwSelectKernel(kernel);
+    resetPeakRss();
+    AllocationScope allocations;
+    for (auto _ : state) {
+        floydWarshall(graph, steps);
+        benchmark::ClobberMemory();
+    }
+    fwSelectKernel(FwKernel::Auto);
+    reportCounters(state, graph.edgeCount(), allocations.stats());
+    state.counters["vertices"] = (double)graph.vertexCount();
+}
+
+std::size_t maxEdges() {
+    if (const char *env = std::getenv("YGGDRASILLEON_BENCH_MAX_EDGES")) {
+        double v = std::atof(env);
+        if (v >= 1) return (std::size_t)v;
+    }
+    return 10000000;
+}
+
+void registerAll() {
+    const std::size_t limit = maxEdges();
+    for (const Family &family : families) {
+        for (std::size_t edges = 100; edges <= limit; edges *= 10) {
+            std::size_t vertices = family.vertices(edges);
+            for (const Algorithm &algorithm : algorithms) {
+                if (!algorithm.feasible(vertices, edges)) continue;
+                std::string name = std::string(algorithm.name) + "/" + family.name + "/" + std::to_string(edges);
+                benchmark::RegisterBenchmark(name.c_str(), runBenchmark, &family, edges, &algorithm)
+                    ->Unit(benchmark::kMillisecond)
+                    ->UseRealTime();
+            }
+            for (const RouteAlgorithm &algorithm : routeAlgorithms) {
+                if (algorithm.feasible && !algorithm.feasible(family, edges)) continue;
+                std::string name = std::string(algorithm.name) + "/" + family.name + "/" + std::to_string(edges);
+                benchmark::RegisterBenchmark(name.c_str(), runRouteBenchmark, &family, edges, &algorithm)
+                    ->Unit(benchmark::kMillisecond)
+                    ->UseRealTime();
+            }
+            if (vertices > 1024) continue;
+            for (FwKernel kernel : {FwKernel::Scalar, FwKernel::Avx2, FwKernel::Avx512}) {
+                if (!fwKernelSupported(kernel)) continue;
+                std::string name = std::string("floydWarshall-") + fwKernelName(kernel) + "/" + family.name + "/" +
+                                   std::to_string(edges);
+                benchmark::RegisterBenchmark(name.c_str(), runFloydWarshallKernel, &family, edges, kernel)
+                    ->Unit(benchmark::kMillisecond)
+                    ->UseRealTime();
+            }
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    registerAll();
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
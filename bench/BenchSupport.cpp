@@ -0,0 +1,136 @@
+#include "BenchSupport.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+// ---- Allocation counting ----
+static std::atomic<int> scopes{0};
+static std::atomic<std::uint64_t> allocCount{0};
+static std::atomic<std::uint64_t> allocBytes{0};
+
+static void *countedAlloc(std::size_t size) {
+    if (scopes.load(std::memory_order_relaxed) > 0) {
+        allocCount.fetch_add(1, std::memory_order_relaxed);
+        allocBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+    return std::malloc(size ? size : 1);
+}
+
+// Over-aligned types (alignas above the default) come through here;
+// aligned_alloc wants the size to be a multiple of the alignment
+static void *countedAlignedAlloc(std::size_t size, std::align_val_t alignment) {
+    const std::size_t align = (std::size_t)alignment;
+    if (scopes.load(std::memory_order_relaxed) > 0) {
+        allocCount.fetch_add(1, std::memory_order_relaxed);
+        allocBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+    const std::size_t rounded = (size + align - 1) / align * align;
+    return std::aligned_alloc(align, rounded ? rounded : align);
+}
+
+void *operator new(std::size_t size) {
+    if (void *p = countedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+void *operator new[](std::size_t size) {
+    if (void *p = countedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept { return countedAlloc(size); }
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept { return countedAlloc(size); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+    if (void *p = countedAlignedAlloc(size, alignment)) return p;
+    throw std::bad_alloc();
+}
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+    if (void *p = countedAlignedAlloc(size, alignment)) return p;
+    throw std::bad_alloc();
+}
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    return countedAlignedAlloc(size, alignment);
+}
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    return countedAlignedAlloc(size, alignment);
+}
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+static AllocationStats snapshot() {
+    return { allocCount.load(std::memory_order_relaxed), allocBytes.load(std::memory_order_relaxed) };
+}
+
+AllocationScope::AllocationScope() {
+    scopes.fetch_add(1, std::memory_order_relaxed);
+    begin = snapshot();
+}
+
+AllocationScope::~AllocationScope() {
+    scopes.fetch_sub(1, std::memory_order_relaxed);
+}
+
+AllocationStats AllocationScope::stats() const {
+    AllocationStats now = snapshot();
+    return { now.count - begin.count, now.bytes - begin.bytes };
+}
+
+// ---- Resident set size ----
+void resetPeakRss() {
+#if defined(__linux__)
+    // "5" resets the peak RSS (VmHWM) to the current RSS
+    if (FILE *f = std::fopen("/proc/self/clear_refs", "w")) {
+        std::fputs("5", f);
+        std::fclose(f);
+    }
+#endif
+}
+
+std::size_t peakRssBytes() {
+#if defined(__linux__)
+    if (FILE *f = std::fopen("/proc/self/status", "r")) {
+        char line[256];
+        std::size_t kb = 0;
+        while (std::fgets(line, sizeof line, f)) {
+            if (std::strncmp(line, "VmHWM:", 6) == 0) {
+                kb = std::strtoull(line + 6, nullptr, 10);
+                break;
+            }
+        }
+        std::fclose(f);
+        if (kb) return kb * 1024;
+    }
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return (std::size_t)usage.ru_maxrss;        // bytes
+#else
+    return (std::size_t)usage.ru_maxrss * 1024; // kilobytes
+#endif
+#else
+    return 0;
+#endif
+}
+
+void reportCounters(benchmark::State &state, std::size_t edges, const AllocationStats &allocs) {
+    using benchmark::Counter;
+    const double iterations = (double)state.iterations();
+    state.counters["edges/s"] = Counter(iterations * edges, Counter::kIsRate);
+    state.counters["allocs/iter"] = Counter((double)allocs.count, Counter::kAvgIterations);
+    state.counters["alloc_bytes/iter"] = Counter((double)allocs.bytes, Counter::kAvgIterations, Counter::kIs1024);
+    state.counters["peak_rss_MB"] = Counter((double)peakRssBytes() / (1024.0 * 1024.0));
+}
@@ -0,0 +1,38 @@
+#ifndef BENCHSUPPORT_HPP
+#define BENCHSUPPORT_HPP
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+
+// Shared helpers for the yggdrasilleon-bench suites.
+//
+// BenchSupport.cpp replaces the global operator new/delete so every heap
+// allocation made while an AllocationScope is alive is counted.
+
+struct AllocationStats {
+    std::uint64_t count = 0;
+    std::uint64_t bytes = 0;
+};
+
+// Counts allocations (all threads) for its lifetime
+class AllocationScope {
+public:
+    AllocationScope();
+    ~AllocationScope();
+    AllocationStats stats() const; // so far
+
+private:
+    AllocationStats begin;
+};
+
+// Peak resident set size in bytes. resetPeakRss() rebases it to the current
+// RSS where the kernel allows it (Linux clear_refs), so a following
+// peakRssBytes() covers only what ran in between.
+void resetPeakRss();
+std::size_t peakRssBytes();
+
+// Attach edges/s, allocs/iter, alloc_bytes/iter and peak_rss_MB to state
+void reportCounters(benchmark::State &state, std::size_t edges, const AllocationStats &allocs);
+
+#endif // BENCHSUPPORT_HPP
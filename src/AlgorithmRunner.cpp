@@ -0,0 +1,68 @@
+#include "AlgorithmRunner.hpp"
+
+AlgorithmRunner::~AlgorithmRunner() {
+    cancel();
+    join();
+}
+
+void AlgorithmRunner::start(Job job) {
+    cancel();
+    join();
+
+    control.reset();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        chunks.clear();
+        running = true;
+    }
+
+    worker = std::thread([this, job = std::move(job)]() {
+        StepLog steps;
+        steps.setSink([this](StepLog &&chunk) {
+            if (control.isCancelled()) return; // steps of a cancelled run are discarded
+            std::lock_guard<std::mutex> lock(mutex);
+            chunks.push_back(std::move(chunk));
+        }, MaxChunk);
+
+        job(steps, &control);
+        steps.flush();
+        control.report(1, 1);
+
+        // cleared under the lock so poll() never misses the final step
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+    });
+}
+
+void AlgorithmRunner::cancel() {
+    control.cancel();
+    std::lock_guard<std::mutex> lock(mutex);
+    chunks.clear();
+    current.clear();
+    cursor = 0;
+}
+
+AlgorithmRunner::Poll AlgorithmRunner::poll(Step &step) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (cursor >= current.size()) {
+        if (chunks.empty()) return running ? Poll::Waiting : Poll::Finished;
+        current = std::move(chunks.front());
+        chunks.pop_front();
+        cursor = 0;
+    }
+
+    const StepEvent &event = current[cursor++];
+    step.event = &event;
+    step.payload = current.payload(event);
+    step.isFinal = cursor == current.size() && chunks.empty() && !running;
+    return Poll::Step;
+}
+
+bool AlgorithmRunner::isRunning() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return running;
+}
+
+void AlgorithmRunner::join() {
+    if (worker.joinable()) worker.join();
+}
@@ -0,0 +1,67 @@
+#ifndef ALGORITHMRUNNER_HPP
+#define ALGORITHMRUNNER_HPP
+
+#include "Algorithms.hpp"
+#include "RunControl.hpp"
+#include "StepLog.hpp"
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// AlgorithmRunner: runs one algorithm at a time on a worker thread.
+// The worker's StepLog is handed over in chunks through a mutex-guarded
+// queue which the GUI drains from its animation timer while the algorithm
+// is still running.
+class AlgorithmRunner {
+public:
+    // The job receives the step log to append to and the control it must poll
+    using Job = std::function<void(StepLog&, RunControl*)>;
+
+    enum class Poll { Step, Waiting, Finished };
+
+    // A step handed out by poll(); valid until the next poll(), start() or cancel()
+    struct Step {
+        const StepEvent *event = nullptr;
+        Span<std::uint32_t> payload;
+        bool isFinal = false; // last step of a completed run
+    };
+
+    AlgorithmRunner() = default;
+    ~AlgorithmRunner();
+
+    AlgorithmRunner(const AlgorithmRunner&) = delete;
+    AlgorithmRunner &operator=(const AlgorithmRunner&) = delete;
+
+    // Cancel and join any previous run, then start job on a fresh worker
+    void start(Job job);
+
+    // Ask the running job to stop and drop all steps not yet taken
+    void cancel();
+
+    // Take the next step (GUI thread only). Poll::Waiting means the worker
+    // has not produced anything new yet; Poll::Finished means the run is over.
+    Poll poll(Step &step);
+
+    bool isRunning() const;
+    int progress() const { return control.progress(); } // 0..1000
+
+private:
+    static constexpr std::size_t MaxChunk = 4096;
+
+    void join();
+
+    std::thread worker;
+    RunControl control;
+
+    mutable std::mutex mutex;
+    std::deque<StepLog> chunks; // guarded by mutex
+    bool running = false;       // guarded by mutex
+
+    // consumer side: chunk currently being replayed
+    StepLog current;
+    std::size_t cursor = 0;
+};
+
+#endif // ALGORITHMRUNNER_HPP
@@ -1,319 +1,675 @@
 #include "Algorithms.hpp"
+#include "BellmanFord.hpp"
+#include "DeltaStepping.hpp"
+#include "FloydWarshall.hpp"
+#include "DepthFirst.hpp"
+#include "Parallel.hpp"
+#include "ParallelBfs.hpp"
+#include "PointToPoint.hpp"
+#include "RouteIndex.hpp"
+#include "SpanningForest.hpp"
+#include "StrongComponents.hpp"
 #include <queue>
 #include <set>
 #include <map>
-#include <sstream>
+#include <tuple>
 
 #include <unordered_set>
 #include <stack>
 
+using Vertex = CsrGraph::Vertex;
+
+// Look up the start vertex; report and return npos if it is not in the graph
+static Vertex resolveStart(const CsrGraph &graph, const std::string &start, StepLog &steps) {
+    Vertex s = graph.find(start);
+    if (s == CsrGraph::npos) steps.push(StepKind::StartNotFound);
+    return s;
+}
+
+static Vertex resolveGoal(const CsrGraph &graph, const std::string &goal, StepLog &steps) {
+    Vertex t = graph.find(goal);
+    if (t == CsrGraph::npos) steps.push(StepKind::GoalNotFound);
+    return t;
+}
+
+static void started(StepLog &steps, AlgorithmKind kind, Vertex start = CsrGraph::npos) {
+    steps.push(StepKind::Started, start, CsrGraph::npos, (std::int64_t)kind);
+}
+
+static void completed(StepLog &steps, AlgorithmKind kind) {
+    steps.push(StepKind::Completed, CsrGraph::npos, CsrGraph::npos, (std::int64_t)kind);
+}
+
+static bool cancelled(const RunControl *control) {
+    return control && control->isCancelled();
+}
+
+static void report(RunControl *control, std::size_t done, std::size_t total) {
+    if (control) control->report(done, total);
+}
+
+// ------------------ Graph entry points (snapshot, then run on CSR) ------------------
+void dfs(const Graph &graph, const std::string &start, StepLog &steps, RunControl *control) {
+    dfs(CsrGraph(graph), start, steps, control);
+}
+
+void bfs(const Graph &graph, const std::string &start, StepLog &steps, RunControl *control) {
+    bfs(CsrGraph(graph), start, steps, control);
+}
+
+void dijkstra(const Graph &graph, const std::string &start, StepLog &steps, RunControl *control) {
+    dijkstra(CsrGraph(graph), start, steps, control);
+}
+
+void bellmanFord(const Graph &graph, const std::string &start, StepLog &steps, RunControl *control,
+                 const std::string &goal) {
+    bellmanFord(CsrGraph(graph), start, steps, control, goal);
+}
+
+void deltaStepping(const Graph &graph, const std::string &start, StepLog &steps, RunControl *control) {
+    deltaStepping(CsrGraph(graph), start, steps, control);
+}
+
+void bidirectionalDijkstra(const Graph &graph, const std::string &start, const std::string &goal, StepLog &steps,
+                           RunControl *control) {
+    bidirectionalDijkstra(CsrGraph(graph), start, goal, steps, control);
+}
+
+void aStar(const Graph &graph, const std::string &start, const std::string &goal, StepLog &steps,
+           RunControl *control, const std::vector<Point> *coordinates) {
+    aStar(CsrGraph(graph), start, goal, steps, control, coordinates);
+}
+
+void floydWarshall(const Graph &graph, StepLog &steps, RunControl *control) {
+    floydWarshall(CsrGraph(graph), steps, control);
+}
+
+void primMST(const Graph &graph, const std::string &start, StepLog &steps, RunControl *control) {
+    primMST(CsrGraph(graph), start, steps, control);
+}
+
+void kruskalMST(const Graph &graph, StepLog &steps, RunControl *control) {
+    kruskalMST(CsrGraph(graph), steps, control);
+}
+
+void boruvkaMST(const Graph &graph, StepLog &steps, RunControl *control) {
+    boruvkaMST(CsrGraph(graph), steps, control);
+}
+
+void detectCycles(const Graph &graph, StepLog &steps, RunControl *control) {
+    detectCycles(CsrGraph(graph), steps, control);
+}
+
+void stronglyConnectedComponents(const Graph &graph, StepLog &steps, RunControl *control) {
+    stronglyConnectedComponents(CsrGraph(graph), steps, control);
+}
+
 // ------------------ DFS ------------------
-void dfs(const Graph &graph, const std::string &start, StepCallback callback) {
-    std::unordered_set<std::string> visited;
-    std::function<void(const std::string&)> visit = [&](const std::string &node){
-        visited.insert(node);
-        callback("Visited: " + node);
-        for (auto &edge : graph.neighbors(node)) {
-            if (!visited.count(edge.to)) {
-                visit(edge.to);
-            }
+void dfs(const CsrGraph &graph, const std::string &start, StepLog &steps, RunControl *control) {
+    Vertex s = resolveStart(graph, start, steps);
+    if (s == CsrGraph::npos) return;
+    started(steps, AlgorithmKind::DFS, s);
+
+    struct Visitor : DfsVisitor {
+        StepLog &steps;
+        RunControl *control;
+        std::size_t total;
+        std::size_t visitedCount = 0;
+
+        bool discover(Vertex node) {
+            steps.push(StepKind::Visited, node);
+            report(control, ++visitedCount, total);
+            return !cancelled(control);
         }
-    };
-    callback("Starting DFS from " + start);
-    visit(start);
+    } visitor{{}, steps, control, graph.vertexCount()};
+
+    DepthFirstSearch search(graph);
+    search.search(s, visitor);
 }
 
 // ------------------ BFS ------------------
-void bfs(const Graph &graph, const std::string &start, StepCallback callback) {
-    std::unordered_set<std::string> visited;
-    std::queue<std::string> q;
-    visited.insert(start);
-    q.push(start);
-    callback("Starting BFS from " + start);
-
-    while (!q.empty()) {
-        std::string node = q.front(); q.pop();
-        callback("Visited: " + node);
-        for (auto &edge : graph.neighbors(node)) {
-            if (!visited.count(edge.to)) {
-                visited.insert(edge.to);
-                q.push(edge.to);
-                callback("Queued: " + edge.to);
-            }
-        }
+void bfs(const CsrGraph &graph, const std::string &start, StepLog &steps, RunControl *control) {
+    Vertex s = resolveStart(graph, start, steps);
+    if (s == CsrGraph::npos) return;
+    started(steps, AlgorithmKind::BFS, s);
+
+    if (!steps.isEnabled()) {
+        // no Visited/Queued order to preserve: run the parallel kernel
+        BfsTree tree;
+        bfsTree(graph, s, tree, control);
+        return;
     }
-}
 
-// ------------------ Dijkstra ------------------
-void dijkstra(const Graph &graph, const std::string &start, StepCallback callback) {
-    std::unordered_map<std::string, int> dist;
-    for (auto &node : graph.nodes()) dist[node] = std::numeric_limits<int>::max();
-    dist[start] = 0;
-
-    using P = std::pair<int, std::string>;
-    std::priority_queue<P, std::vector<P>, std::greater<P>> pq;
-    pq.push({0, start});
-    callback("Starting Dijkstra from " + start);
-
-    while (!pq.empty()) {
-        auto [d, node] = pq.top(); pq.pop();
-        if (d > dist[node]) continue;
-        callback("Processing: " + node + " (distance " + std::to_string(d) + ")");
-        for (auto &edge : graph.neighbors(node)) {
-            int w = edge.weight.value_or(1);
-            if (dist[edge.to] > dist[node] + w) {
-                dist[edge.to] = dist[node] + w;
-                pq.push({dist[edge.to], edge.to});
-                callback("Updating: " + edge.to + " to " + std::to_string(dist[edge.to]));
+    std::vector<char> visited(graph.vertexCount(), 0);
+    std::queue<Vertex> q;
+    visited[s] = 1;
+    q.push(s);
+
+    std::size_t processed = 0;
+    while (!q.empty() && !cancelled(control)) {
+        Vertex node = q.front(); q.pop();
+        steps.push(StepKind::Visited, node);
+        report(control, ++processed, graph.vertexCount());
+        for (std::size_t a = graph.arcBegin(node); a < graph.arcEnd(node); ++a) {
+            Vertex to = graph.target(a);
+            if (!visited[to]) {
+                visited[to] = 1;
+                q.push(to);
+                steps.push(StepKind::Queued, to, CsrGraph::npos, 0, (std::uint32_t)a);
             }
         }
     }
 }
 
-// ------------------ Bellman-Ford Implementation :
-void bellmanFord(const Graph &graph, const std::string &start, StepCallback callback) {
-    using ll = long long;
-    const ll INF = std::numeric_limits<ll>::max() / 4;
-
-    std::unordered_map<std::string, ll> dist;
-    std::unordered_map<std::string, std::string> prev; // parent tracker
-
-    for (auto &node : graph.nodes()) dist[node] = INF;
-    dist[start] = 0;
-
-    callback("Starting Bellman-Ford from " + start);
-
-    int N = (int)graph.nodes().size();
-    for (int iter = 0; iter < N - 1; ++iter) {
-        bool changed = false;
-        for (auto &edge : graph.edges()) {
-            ll w = (edge.weight) ? static_cast<ll>(*edge.weight) : 1LL;
-            if (dist[edge.from] != INF && dist[edge.to] > dist[edge.from] + w) {
-                dist[edge.to] = dist[edge.from] + w;
-                prev[edge.to] = edge.from; // track path
-
-                // emit step for GUI highlighting: entire path from start to current
-                std::string pathNode = edge.to;
-                std::string pathStr = pathNode;
-                while (prev.count(pathNode)) {
-                    pathNode = prev[pathNode];
-                    pathStr = pathNode + " -> " + pathStr;
-                }
-                callback("Path: " + pathStr + " = " + std::to_string(dist[edge.to]));
+bool bfsTree(const CsrGraph &graph, Vertex source, BfsTree &out, RunControl *control, unsigned threads) {
+    return bfsDirectionOptimizing(graph, source, out.level, out.parent, control, threads);
+}
 
-                // highlight edge
-                callback("Edge update highlight: " + edge.from + " -> " + edge.to);
+// ------------------ Dijkstra ------------------
+void dijkstra(const CsrGraph &graph, const std::string &start, StepLog &steps, RunControl *control) {
+    // the radix heap pops equal distances in another order, which only steps show
+    if (steps.isEnabled()) dijkstra<QuadHeap>(graph, start, steps, control);
+    else dijkstra<RadixHeap>(graph, start, steps, control);
+}
 
-                changed = true;
-            }
+template <template <typename> class Queue>
+void dijkstra(const CsrGraph &graph, const std::string &start, StepLog &steps, RunControl *control) {
+    Vertex s = resolveStart(graph, start, steps);
+    if (s == CsrGraph::npos) return;
+    started(steps, AlgorithmKind::Dijkstra, s);
+
+    // A negative arc reopens settled vertices, and a reachable negative
+    // cycle would do so forever: the label-correcting engine takes over
+    for (std::size_t a = 0; a < graph.arcCount(); ++a) {
+        if (graph.weight(a) >= 0) continue;
+        ShortestPathTree tree;
+        if (ssspBellmanFord(graph, s, tree, control, steps.isEnabled() ? &steps : nullptr) && tree.negativeCycle) {
+            steps.push(StepKind::NegativeCycle);
+            steps.push(StepKind::ResetColors);
         }
-        if (!changed) break;
+        return;
     }
 
-    // Detect negative cycles
-    for (auto &edge : graph.edges()) {
-        ll w = (edge.weight) ? static_cast<ll>(*edge.weight) : 1LL;
-        if (dist[edge.from] != INF && dist[edge.to] > dist[edge.from] + w) {
-            callback("❌ Negative weight cycle detected! Aborting visualization.");
-            callback("RESET_COLORS");
-            return;
+    std::vector<long long> dist(graph.vertexCount(), PathDistances::Unreachable);
+    Queue<long long> queue(graph.vertexCount());
+    dist[s] = 0;
+    queue.push(s, 0);
+
+    std::size_t settled = 0;
+    while (!queue.empty() && !cancelled(control)) {
+        auto [d, node] = queue.pop();
+        steps.push(StepKind::Processing, node, CsrGraph::npos, d);
+        report(control, ++settled, graph.vertexCount());
+        for (std::size_t a = graph.arcBegin(node); a < graph.arcEnd(node); ++a) {
+            Vertex to = graph.target(a);
+            long long candidate = d + graph.weight(a);
+            if (candidate < dist[to]) {
+                dist[to] = candidate;
+                queue.push(to, candidate);
+                steps.push(StepKind::DistanceUpdate, to, node, candidate, (std::uint32_t)a);
+            }
         }
     }
+}
 
-    // Highlight all shortest paths from start to reachable nodes
-    for (auto &node : graph.nodes()) {
-        if (node == start || dist[node] == INF) continue;
+template void dijkstra<LazyHeap>(const CsrGraph &, const std::string &, StepLog &, RunControl *);
+template void dijkstra<QuadHeap>(const CsrGraph &, const std::string &, StepLog &, RunControl *);
+template void dijkstra<RadixHeap>(const CsrGraph &, const std::string &, StepLog &, RunControl *);
+
+// ------------------ Delta-stepping ------------------
+void deltaStepping(const CsrGraph &graph, const std::string &start, StepLog &steps, RunControl *control) {
+    Vertex s = resolveStart(graph, start, steps);
+    if (s == CsrGraph::npos) return;
+    started(steps, AlgorithmKind::DeltaStepping, s);
+
+    // recorded steps come from a single thread, in bucket order
+    PathDistances out;
+    const bool finished = steps.isEnabled() ? ssspDeltaStepping(graph, s, out, 0, control, 1, &steps)
+                                            : ssspDeltaStepping(graph, s, out, 0, control);
+    if (finished && out.negativeCycle) {
+        steps.push(StepKind::NegativeCycle);
+        steps.push(StepKind::ResetColors);
+    }
+}
 
-        std::string cur = node;
-        while (prev.count(cur)) {
-            std::string p = prev[cur];
-            callback("Edge update highlight: " + p + " -> " + cur);
-            cur = p;
-        }
+bool shortestDistances(const CsrGraph &graph, Vertex source, PathDistances &out, RunControl *control,
+                       unsigned threads) {
+    return ssspDeltaStepping(graph, source, out, 0, control, threads);
+}
+
+// ------------------ Point-to-point routes ------------------
+// Final steps of a route search: the route itself, or why there is none
+static void routeResult(StepLog &steps, const Route &route, AlgorithmKind kind) {
+    if (route.negativeCycle) {
+        steps.push(StepKind::NegativeCycle);
+        steps.push(StepKind::ResetColors);
+        return;
+    }
+    if (route.path.empty()) {
+        steps.push(StepKind::NoRoute);
+    } else if (steps.isEnabled()) {
+        std::vector<std::uint32_t> path(route.path.begin(), route.path.end());
+        steps.push(StepKind::RouteFound, Span<std::uint32_t>(path.data(), path.size()), route.distance);
     }
+    completed(steps, kind);
+}
 
-    callback("✅ Bellman-Ford completed successfully!");
+void bidirectionalDijkstra(const CsrGraph &graph, const std::string &start, const std::string &goal, StepLog &steps,
+                           RunControl *control) {
+    Vertex s = resolveStart(graph, start, steps);
+    if (s == CsrGraph::npos) return;
+    Vertex t = resolveGoal(graph, goal, steps);
+    if (t == CsrGraph::npos) return;
+    started(steps, AlgorithmKind::BidirectionalDijkstra, s);
+
+    Route route;
+    if (routeBidirectional(graph, s, t, route, control, steps.isEnabled() ? &steps : nullptr))
+        routeResult(steps, route, AlgorithmKind::BidirectionalDijkstra);
 }
 
+void aStar(const CsrGraph &graph, const std::string &start, const std::string &goal, StepLog &steps,
+           RunControl *control, const std::vector<Point> *coordinates) {
+    Vertex s = resolveStart(graph, start, steps);
+    if (s == CsrGraph::npos) return;
+    Vertex t = resolveGoal(graph, goal, steps);
+    if (t == CsrGraph::npos) return;
+    started(steps, AlgorithmKind::AStar, s);
+
+    Route route;
+    Heuristic heuristic = coordinates ? euclideanHeuristic(graph, *coordinates, t) : Heuristic();
+    if (routeAStar(graph, s, t, heuristic, route, control, steps.isEnabled() ? &steps : nullptr))
+        routeResult(steps, route, AlgorithmKind::AStar);
+}
 
-//------------------- Floyd-Warshall Implementation
-void floydWarshall(const Graph &graph, StepCallback callback) {
-    using ll = long long;
-    const ll INF = std::numeric_limits<ll>::max() / 4;
+bool shortestRoute(const CsrGraph &graph, Vertex source, Vertex target, Route &out, RunControl *control) {
+    return routeBidirectional(graph, source, target, out, control);
+}
+
+bool shortestRoute(const CsrGraph &graph, Vertex source, Vertex target, const std::vector<Point> &coordinates,
+                   Route &out, RunControl *control) {
+    return routeAStar(graph, source, target, euclideanHeuristic(graph, coordinates, target), out, control);
+}
+
+void contractionHierarchy(RouteIndex &index, const std::string &start, const std::string &goal, StepLog &steps,
+                          RunControl *control) {
+    const CsrGraph &graph = index.graph();
+    Vertex s = resolveStart(graph, start, steps);
+    if (s == CsrGraph::npos) return;
+    Vertex t = resolveGoal(graph, goal, steps);
+    if (t == CsrGraph::npos) return;
+    started(steps, AlgorithmKind::ContractionHierarchy, s);
+
+    Route route;
+    StepLog *log = steps.isEnabled() ? &steps : nullptr;
+    bool finished = true;
+    if (const ContractionHierarchy *hierarchy = index.hierarchy(control))
+        hierarchy->route(s, t, route, log);
+    else
+        finished = !cancelled(control) && index.search()->bidirectional(s, t, route, control, log);
+    if (finished) routeResult(steps, route, AlgorithmKind::ContractionHierarchy);
+}
+
+void landmarkAStar(RouteIndex &index, const std::string &start, const std::string &goal, StepLog &steps,
+                   RunControl *control) {
+    const CsrGraph &graph = index.graph();
+    Vertex s = resolveStart(graph, start, steps);
+    if (s == CsrGraph::npos) return;
+    Vertex t = resolveGoal(graph, goal, steps);
+    if (t == CsrGraph::npos) return;
+    started(steps, AlgorithmKind::Landmarks, s);
+
+    Route route;
+    StepLog *log = steps.isEnabled() ? &steps : nullptr;
+    bool finished;
+    if (const LandmarkIndex *landmarks = index.landmarks(control))
+        finished = index.search()->aStar(s, t, landmarks->heuristic(t), route, control, log);
+    else
+        finished = !cancelled(control) && index.search()->bidirectional(s, t, route, control, log);
+    if (finished) routeResult(steps, route, AlgorithmKind::Landmarks);
+}
 
-    auto nodes = graph.nodes();
-    int n = (int)nodes.size();
-    if (n == 0) { callback("Floyd-Warshall: graph has no nodes."); return; }
+void bidirectionalDijkstra(RouteIndex &index, const std::string &start, const std::string &goal, StepLog &steps,
+                           RunControl *control) {
+    const CsrGraph &graph = index.graph();
+    Vertex s = resolveStart(graph, start, steps);
+    if (s == CsrGraph::npos) return;
+    Vertex t = resolveGoal(graph, goal, steps);
+    if (t == CsrGraph::npos) return;
+    started(steps, AlgorithmKind::BidirectionalDijkstra, s);
+
+    Route route;
+    if (index.search()->bidirectional(s, t, route, control, steps.isEnabled() ? &steps : nullptr))
+        routeResult(steps, route, AlgorithmKind::BidirectionalDijkstra);
+}
 
-    std::unordered_map<std::string,int> idx;
-    for (int i = 0; i < n; ++i) idx[nodes[i]] = i;
+void aStar(RouteIndex &index, const std::string &start, const std::string &goal, StepLog &steps,
+           RunControl *control, std::shared_ptr<const std::vector<Point>> coordinates) {
+    const CsrGraph &graph = index.graph();
+    Vertex s = resolveStart(graph, start, steps);
+    if (s == CsrGraph::npos) return;
+    Vertex t = resolveGoal(graph, goal, steps);
+    if (t == CsrGraph::npos) return;
+    started(steps, AlgorithmKind::AStar, s);
+
+    Route route;
+    RouteIndex::Lease search = index.search();
+    search->setCoordinates(std::move(coordinates));
+    if (search->aStar(s, t, search->euclidean(t), route, control, steps.isEnabled() ? &steps : nullptr))
+        routeResult(steps, route, AlgorithmKind::AStar);
+}
 
-    std::vector<std::vector<ll>> dist(n, std::vector<ll>(n, INF));
-    std::vector<std::vector<int>> next(n, std::vector<int>(n, -1)); // next-hop for path reconstruction
+// ------------------ Bellman-Ford Implementation :
+void bellmanFord(const CsrGraph &graph, const std::string &start, StepLog &steps, RunControl *control,
+                 const std::string &goal) {
+    Vertex s = resolveStart(graph, start, steps);
+    if (s == CsrGraph::npos) return;
+    Vertex t = CsrGraph::npos;
+    if (!goal.empty() && (t = resolveGoal(graph, goal, steps)) == CsrGraph::npos) return;
+    started(steps, AlgorithmKind::BellmanFord, s);
+
+    ShortestPathTree tree;
+    if (!ssspBellmanFord(graph, s, tree, control, steps.isEnabled() ? &steps : nullptr)) return;
+    if (tree.negativeCycle) {
+        steps.push(StepKind::NegativeCycle);
+        steps.push(StepKind::ResetColors);
+        return;
+    }
 
-    for (int i = 0; i < n; ++i) dist[i][i] = 0;
+    if (steps.isEnabled()) {
+        // Highlight the shortest-path tree, one edge per reached vertex
+        for (Vertex v = 0; v < graph.vertexCount(); ++v)
+            if (tree.parent[v] != CsrGraph::npos) steps.push(StepKind::EdgeHighlight, tree.parent[v], v);
 
-    // insert edges
-    for (auto &e : graph.edges()) {
-        int u = idx[e.from], v = idx[e.to];
-        ll w = (e.weight) ? static_cast<ll>(*e.weight) : 1LL;
-        if (dist[u][v] > w) { dist[u][v] = w; next[u][v] = v; }
-        if (!e.directed && dist[v][u] > w) { dist[v][u] = w; next[v][u] = u; }
+        // the one path asked for
+        if (t != CsrGraph::npos && tree.dist[t] != PathDistances::Unreachable) {
+            std::vector<Vertex> path = tree.path(t);
+            steps.push(StepKind::PathUpdate, Span<std::uint32_t>(path.data(), path.size()), tree.dist[t]);
+        }
     }
 
-    callback("Starting Floyd-Warshall");
+    completed(steps, AlgorithmKind::BellmanFord);
+}
+
+bool shortestPathTree(const CsrGraph &graph, Vertex source, ShortestPathTree &out, RunControl *control) {
+    return ssspBellmanFord(graph, source, out, control);
+}
+
+std::vector<CsrGraph::Vertex> ShortestPathTree::path(CsrGraph::Vertex v) const {
+    if (negativeCycle || v >= dist.size() || dist[v] == PathDistances::Unreachable) return {};
+    std::vector<CsrGraph::Vertex> nodes;
+    for (CsrGraph::Vertex x = v; x != CsrGraph::npos && nodes.size() <= dist.size(); x = parent[x])
+        nodes.push_back(x);
+    std::reverse(nodes.begin(), nodes.end());
+    return nodes;
+}
 
-    // main triple loop
-    for (int k = 0; k < n; ++k) {
-        for (int i = 0; i < n; ++i) {
-            if (dist[i][k] == INF) continue;
-            for (int j = 0; j < n; ++j) {
-                if (dist[k][j] == INF) continue;
-                if (dist[i][j] > dist[i][k] + dist[k][j]) {
-                    dist[i][j] = dist[i][k] + dist[k][j];
-                    next[i][j] = next[i][k];
 
-                    // emit step for GUI
-                    callback("Edge update highlight: " + nodes[i] + " -> " + nodes[j]);
+//------------------- Floyd-Warshall Implementation
+void floydWarshall(const CsrGraph &graph, StepLog &steps, RunControl *control) {
+    using ll = long long;
+    const ll INF = AllPairsPaths::Unreachable;
+
+    const std::size_t n = graph.vertexCount();
+    if (n == 0) { steps.push(StepKind::NoNodes, CsrGraph::npos, CsrGraph::npos, (std::int64_t)AlgorithmKind::FloydWarshall); return; }
+
+    // one contiguous row-major matrix each; next is the next hop for path reconstruction
+    std::vector<ll> dist;
+    std::vector<Vertex> next;
+    fwInitialize(graph, dist, next);
+
+    started(steps, AlgorithmKind::FloydWarshall);
+
+    // Rows are handed out in fixed chunks; each chunk buffers the steps it
+    // would emit and the buffers are replayed in row order, so the log is
+    // identical to the serial loop's whatever the thread count
+    constexpr std::size_t RowsPerChunk = 64;
+    using Update = std::pair<Vertex, Vertex>;
+    std::vector<std::vector<Update>> pending((n + RowsPerChunk - 1) / RowsPerChunk);
+    auto replay = [&](std::size_t chunks) {
+        for (std::size_t c = 0; c < chunks; ++c) {
+            for (const Update &u : pending[c]) steps.push(StepKind::EdgeHighlight, u.first, u.second);
+            pending[c].clear();
+        }
+    };
+
+    if (!steps.isEnabled()) {
+        // nothing is watching individual updates: use the cache-blocked kernel
+        if (!fwBlocked(n, dist.data(), next.data(), control)) return;
+    } else {
+        // main triple loop, in k-i-j order so every update is reported as it happens
+        for (std::size_t k = 0; k < n; ++k) {
+            if (cancelled(control)) return;
+            report(control, k, n);
+            const ll *rowK = &dist[k * n];
+            auto relaxRows = [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+                std::vector<Update> &updates = pending[chunk];
+                for (std::size_t i = begin; i < end; ++i) {
+                    ll *rowI = &dist[i * n];
+                    if (rowI[k] == INF) continue;
+                    for (std::size_t j = 0; j < n; ++j) {
+                        if (rowK[j] == INF) continue;
+                        if (rowI[j] > rowI[k] + rowK[j]) {
+                            rowI[j] = rowI[k] + rowK[j];
+                            next[i * n + j] = next[i * n + k];
+
+                            // emit step for GUI
+                            updates.emplace_back((Vertex)i, (Vertex)j);
+                        }
+                    }
                 }
-            }
+            };
+            // row k only changes itself when dist[k][k] < 0 (a negative
+            // cycle); then rows read it mid-update, so keep serial order
+            if (rowK[k] < 0) relaxRows(0, 0, n);
+            else parallelChunks(n, RowsPerChunk, 0, relaxRows);
+            replay(pending.size());
         }
     }
 
     // detect negative cycles
-    for (int i = 0; i < n; ++i) {
-        if (dist[i][i] < 0) {
-            callback("❌ Negative weight cycle detected! Aborting visualization.");
-            callback("RESET_COLORS");
-            return;
-        }
+    if (fwNegativeCycle(n, dist.data())) {
+        steps.push(StepKind::NegativeCycle);
+        steps.push(StepKind::ResetColors);
+        return;
     }
 
-    // highlight full shortest paths for all pairs
-    for (int i = 0; i < n; ++i) {
-        for (int j = 0; j < n; ++j) {
-            if (i == j || next[i][j] == -1) continue;
-
-            int u = i;
-            while (u != j) {
-                int v = next[u][j];
-                callback("Edge update highlight: " + nodes[u] + " -> " + nodes[v]);
-                u = v;
+    // highlight full shortest paths for all pairs, walking rows in parallel
+    // waves that are replayed in order
+    const std::size_t waveRows = RowsPerChunk * resolveThreads(0) * 4;
+    for (std::size_t wave = 0; wave < n && steps.isEnabled(); wave += waveRows) {
+        if (cancelled(control)) return;
+        const std::size_t waveEnd = std::min(n, wave + waveRows);
+        parallelChunks(waveEnd - wave, RowsPerChunk, 0, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+            std::vector<Update> &updates = pending[chunk];
+            for (std::size_t i = wave + begin; i < wave + end; ++i) {
+                for (std::size_t j = 0; j < n; ++j) {
+                    if (i == j || next[i * n + j] == CsrGraph::npos) continue;
+
+                    Vertex u = (Vertex)i;
+                    while (u != j) {
+                        Vertex v = next[u * n + j];
+                        updates.emplace_back(u, v);
+                        u = v;
+                    }
+                }
             }
-        }
+        });
+        replay((waveEnd - wave + RowsPerChunk - 1) / RowsPerChunk);
+    }
+
+    completed(steps, AlgorithmKind::FloydWarshall);
+}
+
+bool allPairsShortestPaths(const CsrGraph &graph, AllPairsPaths &out, RunControl *control, unsigned threads) {
+    const std::size_t n = graph.vertexCount();
+    out.n = n;
+    out.negativeCycle = false;
+    fwInitialize(graph, out.dist, out.next);
+    if (!fwBlocked(n, out.dist.data(), out.next.data(), control, threads)) return false;
+
+    out.negativeCycle = fwNegativeCycle(n, out.dist.data(), threads);
+    if (!out.negativeCycle) fwUntangleNext(graph, out.dist.data(), out.next.data(), threads);
+    return true;
+}
+
+std::vector<CsrGraph::Vertex> AllPairsPaths::path(CsrGraph::Vertex i, CsrGraph::Vertex j) const {
+    std::vector<CsrGraph::Vertex> nodes;
+    if (i != j && next[i * n + j] == CsrGraph::npos) return nodes;
+
+    nodes.push_back(i);
+    // bounded walk: with a negative cycle next may loop
+    for (CsrGraph::Vertex u = i; u != j && nodes.size() <= n;) {
+        u = next[u * n + j];
+        nodes.push_back(u);
     }
+    return nodes;
+}
 
-    callback("✅ Floyd-Warshall completed successfully!");
+// MST_RESULT step: payload holds (u, v, weight) triples, weights stored bitwise
+static void mstResult(StepLog &steps, long long totalWeight,
+                      const std::vector<std::tuple<Vertex, Vertex, int>> &mstEdges) {
+    if (!steps.isEnabled()) return;
+    std::vector<std::uint32_t> payload;
+    payload.reserve(mstEdges.size() * 3);
+    for (auto &[u, v, w] : mstEdges) {
+        payload.push_back(u);
+        payload.push_back(v);
+        payload.push_back((std::uint32_t)w);
+    }
+    steps.push(StepKind::MstResult, Span<std::uint32_t>(payload.data(), payload.size()), totalWeight);
 }
 
 // ------------------ Prim's MST ------------------
-void primMST(const Graph &graph, const std::string &start, StepCallback callback) {
-    std::unordered_set<std::string> inMST;
-    using P = std::pair<int, std::pair<std::string, std::string>>; // weight, {u,v}
-    std::priority_queue<P, std::vector<P>, std::greater<P>> pq;
+void primMST(const CsrGraph &graph, const std::string &start, StepLog &steps, RunControl *control) {
+    primMST<QuadHeap>(graph, start, steps, control);
+}
+
+template <template <typename> class Queue>
+void primMST(const CsrGraph &graph, const std::string &start, StepLog &steps, RunControl *control) {
+    static_assert(!Queue<int>::Monotone, "Prim's keys can drop below the last popped one");
+
+    Vertex s = resolveStart(graph, start, steps);
+    if (s == CsrGraph::npos) return;
+    started(steps, AlgorithmKind::Prim, s);
+
+    // Each vertex is queued once, keyed by its lightest arc from the tree
+    // as (weight, tree end): the order a heap of every (weight, u, v) arc
+    // would pop them in. Arcs that lose to a lighter one are skipped as
+    // soon as they lose.
+    using Key = std::pair<int, Vertex>;
+    std::vector<char> inMST(graph.vertexCount(), 0);
+    std::vector<Key> best(graph.vertexCount(), {std::numeric_limits<int>::max(), CsrGraph::npos});
+    Queue<Key> queue(graph.vertexCount());
 
     // Result container: list of edges in MST
-    std::vector<Edge> mstEdges;
+    std::vector<std::tuple<Vertex, Vertex, int>> mstEdges;
     long long totalWeight = 0;
 
-    // start
-    inMST.insert(start);
-    for (auto &e : graph.neighbors(start))
-        pq.push({e.weight.value_or(1), {start, e.to}});
-
-    callback("Starting Prim's MST from " + start);
-    while (!pq.empty()) {
-        auto [w, nodesPair] = pq.top(); pq.pop();
-        auto [u, v] = nodesPair;
-        if (inMST.count(v)) {
-            callback("Skipping edge (already in MST or would form cycle): " + u + " - " + v + " (weight " + std::to_string(w) + ")");
-            continue;
+    auto grow = [&](Vertex u) {
+        for (std::size_t a = graph.arcBegin(u); a < graph.arcEnd(u); ++a) {
+            Vertex v = graph.target(a);
+            if (inMST[v]) continue;
+            Key key{graph.weight(a), u};
+            if (!(key < best[v])) {
+                steps.push(StepKind::MstSkip, u, v, key.first);
+                continue;
+            }
+            if (best[v].second != CsrGraph::npos) steps.push(StepKind::MstSkip, best[v].second, v, best[v].first);
+            best[v] = key;
+            queue.push(v, key);
         }
+    };
+
+    // start
+    inMST[s] = 1;
+    grow(s);
+
+    std::size_t treeSize = 1;
+    while (!queue.empty()) {
+        if (cancelled(control)) return;
+        auto [key, v] = queue.pop();
+        auto [w, u] = key;
 
         // accept edge u-v
-        inMST.insert(v);
-        Edge chosen; chosen.from = u; chosen.to = v; chosen.weight = w; chosen.directed = false;
-        mstEdges.push_back(chosen);
+        inMST[v] = 1;
+        report(control, ++treeSize, graph.vertexCount());
+        mstEdges.emplace_back(u, v, w);
         totalWeight += w;
-        callback("Edge added to MST: " + u + " - " + v + " (weight " + std::to_string(w) + ")");
-
-        for (auto &e : graph.neighbors(v)) {
-            if (!inMST.count(e.to))
-                pq.push({e.weight.value_or(1), {v, e.to}});
-        }
+        steps.push(StepKind::MstAdd, u, v, w);
+        grow(v);
     }
 
-    // Compose final machine-parsable MST_RESULT message
-    std::ostringstream oss;
-    oss << "MST_RESULT: total=" << totalWeight << "; edges=";
-    bool first = true;
-    for (auto &e : mstEdges) {
-        if (!first) oss << ",";
-        oss << e.from << "-" << e.to << ":" << e.weight.value_or(1);
-        first = false;
-    }
-    callback(oss.str());
+    mstResult(steps, totalWeight, mstEdges);
 }
 
+template void primMST<LazyHeap>(const CsrGraph &, const std::string &, StepLog &, RunControl *);
+template void primMST<QuadHeap>(const CsrGraph &, const std::string &, StepLog &, RunControl *);
+
 // ------------------ Kruskal's MST ------------------
-void kruskalMST(const Graph &graph, StepCallback callback) {
-    auto nodes = graph.nodes();
-    std::unordered_map<std::string, std::string> parent;
-    std::unordered_map<std::string, int> rankv;
-    for (auto &n : nodes) { parent[n] = n; rankv[n] = 0; }
-
-    std::function<std::string(const std::string&)> find = [&](const std::string &x)->std::string {
-        std::string r = x;
-        while (parent[r] != r) r = parent[r];
-        // path compression
-        std::string cur = x;
-        while (parent[cur] != r) {
-            std::string next = parent[cur];
-            parent[cur] = r;
-            cur = next;
-        }
-        return r;
-    };
-    auto unite = [&](const std::string &x, const std::string &y) {
-        std::string rx = find(x), ry = find(y);
-        if (rx == ry) return;
-        if (rankv[rx] < rankv[ry]) parent[rx] = ry;
-        else if (rankv[ry] < rankv[rx]) parent[ry] = rx;
-        else { parent[ry] = rx; rankv[rx]++; }
-    };
+void kruskalMST(const CsrGraph &graph, StepLog &steps, RunControl *control) {
+    if (!steps.isEnabled()) {
+        SpanningForest forest;
+        minimumSpanningForest(graph, forest, MstMethod::FilterKruskal, control);
+        return;
+    }
 
-    auto edges = graph.edges();
-    std::sort(edges.begin(), edges.end(),
-              [](const Edge &a, const Edge &b) { return a.weight.value_or(1) < b.weight.value_or(1); });
+    // edges in (weight, id) order, the order the engines break ties in
+    std::vector<std::uint64_t> order;
+    sortedEdgeKeys(graph, order);
+    UnionFind sets(graph.vertexCount());
 
-    callback("Starting Kruskal's MST");
+    started(steps, AlgorithmKind::Kruskal);
 
-    std::vector<Edge> mstEdges;
+    std::vector<std::tuple<Vertex, Vertex, int>> mstEdges;
     long long totalWeight = 0;
-    for (auto &e : edges) {
-        std::string u = e.from, v = e.to;
-        std::string ru = find(u), rv = find(v);
-        callback("Considering edge " + u + " - " + v + " (weight " + std::to_string(e.weight.value_or(1)) + ")");
-        if (ru != rv) {
-            unite(u, v);
-            mstEdges.push_back(e);
-            totalWeight += e.weight.value_or(1);
-            callback("Edge added to MST: " + u + " - " + v + " (weight " + std::to_string(e.weight.value_or(1)) + ")");
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        if (cancelled(control)) return;
+        report(control, i, order.size());
+        std::size_t e = keyEdge(order[i]);
+        Vertex u = graph.edgeSource(e), v = graph.edgeTarget(e);
+        int w = graph.edgeWeight(e);
+        std::uint32_t arc = (std::uint32_t)graph.edgeArc(e);
+        steps.push(StepKind::MstConsider, u, v, w, arc);
+        if (sets.unite(u, v)) {
+            mstEdges.emplace_back(u, v, w);
+            totalWeight += w;
+            steps.push(StepKind::MstAdd, u, v, w, arc);
         } else {
-            callback("Rejected (would form cycle): " + u + " - " + v);
+            steps.push(StepKind::MstReject, u, v, 0, arc);
         }
     }
 
-    // Compose final machine-parsable MST_RESULT message
-    std::ostringstream oss;
-    oss << "MST_RESULT: total=" << totalWeight << "; edges=";
-    bool first = true;
-    for (auto &e : mstEdges) {
-        if (!first) oss << ",";
-        oss << e.from << "-" << e.to << ":" << e.weight.value_or(1);
-        first = false;
+    mstResult(steps, totalWeight, mstEdges);
+}
+
+// ------------------ Borůvka's MST ------------------
+void boruvkaMST(const CsrGraph &graph, StepLog &steps, RunControl *control) {
+    if (!steps.isEnabled()) {
+        SpanningForest forest;
+        minimumSpanningForest(graph, forest, MstMethod::Boruvka, control);
+        return;
+    }
+
+    started(steps, AlgorithmKind::Boruvka);
+
+    // recorded steps come from a single thread, round by round
+    SpanningForest forest;
+    if (!spanningForestBoruvka(graph, forest, control, 1)) return;
+    std::vector<std::tuple<Vertex, Vertex, int>> mstEdges;
+    for (std::uint32_t e : forest.edges) {
+        Vertex u = graph.edgeSource(e), v = graph.edgeTarget(e);
+        int w = graph.edgeWeight(e);
+        mstEdges.emplace_back(u, v, w);
+        steps.push(StepKind::MstAdd, u, v, w, (std::uint32_t)graph.edgeArc(e));
     }
-    callback(oss.str());
+
+    mstResult(steps, forest.weight, mstEdges);
+}
+
+bool minimumSpanningForest(const CsrGraph &graph, SpanningForest &out, MstMethod method, RunControl *control,
+                           unsigned threads) {
+    if (method == MstMethod::Boruvka) return spanningForestBoruvka(graph, out, control, threads);
+    return spanningForestFilterKruskal(graph, out, control, threads);
 }
 
 
@@ -321,74 +677,110 @@ void kruskalMST(const Graph &graph, StepCallback callback) {
 
 
 // Detect cycles (both directed & undirected)
-void detectCycles(const Graph& graph, std::function<void(const std::string&)> callback) {
-    std::unordered_set<std::string> visited;
-    std::unordered_set<std::string> recursionStack;
-    std::set<std::pair<std::string, std::string>> reported; // avoid duplicate cycle edges
-
-    auto dfsDirected = [&](auto&& self, const std::string& node, std::vector<std::string>& path) -> bool {
-        visited.insert(node);
-        recursionStack.insert(node);
-        path.push_back(node);
-
-        for (const auto& edge : graph.neighbors(node)) {
-            const std::string& neighbor = edge.to;
-
-            if (recursionStack.count(neighbor)) {
-                // Cycle detected
-                auto it = std::find(path.begin(), path.end(), neighbor);
-                if (it != path.end()) {
-                    std::string cycle = "Cycle detected (Directed): ";
-                    for (; it != path.end(); ++it) cycle += *it + " -> ";
-                    cycle += neighbor;
-                    callback(cycle);
-                }
-                return true;
-            } else if (!visited.count(neighbor)) {
-                if (self(self, neighbor, path)) return true;
+void detectCycles(const CsrGraph& graph, StepLog &steps, RunControl *control) {
+    const std::size_t n = graph.vertexCount();
+    DepthFirstSearch search(graph);
+    std::vector<char> onStack(n, 0);
+    std::set<std::pair<Vertex, Vertex>> reported; // avoid duplicate cycle edges
+
+    // An arc back into the current path closes a cycle; report it and stop
+    // this search (its path stays marked, as the recursive version left it)
+    struct DirectedVisitor : DfsVisitor {
+        const DepthFirstSearch &search;
+        StepLog &steps;
+        std::vector<char> &onStack;
+
+        bool discover(Vertex node) { onStack[node] = 1; return true; }
+        void finish(Vertex node) { onStack[node] = 0; }
+
+        bool examine(Vertex, std::size_t, Vertex neighbor) {
+            if (!onStack[neighbor]) return true;
+
+            // Cycle detected
+            std::size_t i = 0;
+            while (i < search.depth() && search.pathVertex(i) != neighbor) ++i;
+            if (i < search.depth() && steps.isEnabled()) {
+                std::vector<std::uint32_t> cycle;
+                for (; i < search.depth(); ++i) cycle.push_back(search.pathVertex(i));
+                cycle.push_back(neighbor);
+                steps.push(StepKind::DirectedCycle, Span<std::uint32_t>(cycle.data(), cycle.size()));
             }
+            return false;
         }
+    } directed{{}, search, steps, onStack};
+
+    // Any visited neighbour other than the one we came from closes a cycle
+    struct UndirectedVisitor : DfsVisitor {
+        const DepthFirstSearch &search;
+        StepLog &steps;
+        std::set<std::pair<Vertex, Vertex>> &reported;
+
+        bool examine(Vertex node, std::size_t arc, Vertex neighbor) {
+            if (neighbor == search.parent() || !steps.isEnabled()) return true;
+            // Avoid duplicate reporting
+            if (reported.insert(std::minmax(node, neighbor)).second)
+                steps.push(StepKind::UndirectedCycle, node, neighbor, 0, (std::uint32_t)arc);
+            return true;
+        }
+    } undirected{{}, search, steps, reported};
 
-        recursionStack.erase(node);
-        path.pop_back();
-        return false;
-    };
-
-    auto dfsUndirected = [&](auto&& self, const std::string& node, const std::string& parent) -> bool {
-        visited.insert(node);
+    // Run both checks
+    for (Vertex node = 0; node < n; ++node) {
+        if (cancelled(control)) return;
+        report(control, node, 2 * n);
+        if (!search.isVisited(node)) search.search(node, directed);
+    }
 
-        for (const auto& edge : graph.neighbors(node)) {
-            const std::string& neighbor = edge.to;
+    search.reset();
+    for (Vertex node = 0; node < n; ++node) {
+        if (cancelled(control)) return;
+        report(control, n + node, 2 * n);
+        if (!search.isVisited(node)) search.search(node, undirected);
+    }
 
-            if (!visited.count(neighbor)) {
-                if (self(self, neighbor, node)) return true;
-            } else if (neighbor != parent) {
-                // Avoid duplicate reporting
-                auto key = std::minmax(node, neighbor);
-                if (!reported.count(key)) {
-                    callback("Cycle detected (Undirected): " + node + " <-> " + neighbor);
-                    reported.insert(key);
-                }
-            }
-        }
-        return false;
-    };
+    completed(steps, AlgorithmKind::CycleDetection);
+}
 
-    // Run both checks
-    visited.clear();
-    for (const auto& node : graph.nodes()) {
-        if (!visited.count(node)) {
-            std::vector<std::string> path;
-            dfsDirected(dfsDirected, node, path);
-        }
+// ------------------ Strongly connected components ------------------
+void stronglyConnectedComponents(const CsrGraph &graph, StepLog &steps, RunControl *control) {
+    StrongComponents components;
+    if (!steps.isEnabled()) {
+        strongComponents(graph, components, SccMethod::ForwardBackward, control);
+        return;
     }
 
-    visited.clear();
-    for (const auto& node : graph.nodes()) {
-        if (!visited.count(node)) {
-            dfsUndirected(dfsUndirected, node, "");
+    started(steps, AlgorithmKind::StrongComponents);
+    if (!strongComponents(graph, components, SccMethod::Tarjan, control)) return;
+
+    // Members of each component in vertex order, bucketed by component id
+    const std::size_t n = graph.vertexCount();
+    std::vector<std::size_t> begin(components.count + 1, 0);
+    for (std::uint32_t c : components.component) ++begin[c + 1];
+    for (std::size_t c = 0; c < components.count; ++c) begin[c + 1] += begin[c];
+    std::vector<std::uint32_t> members(n);
+    std::vector<std::size_t> fill(begin.begin(), begin.end() - 1);
+    for (Vertex v = 0; v < n; ++v) members[fill[components.component[v]]++] = v;
+
+    std::uint32_t cyclic = 0, onCycles = 0;
+    for (std::size_t c = 0; c < components.count; ++c) {
+        steps.push(StepKind::StrongComponent, Span<std::uint32_t>(members.data() + begin[c], begin[c + 1] - begin[c]),
+                   (std::int64_t)c);
+        if (components.cyclic[c]) {
+            ++cyclic;
+            onCycles += (std::uint32_t)(begin[c + 1] - begin[c]);
         }
     }
+    std::uint32_t summary[3] = {cyclic, onCycles, (std::uint32_t)components.dagTargets.size()};
+    steps.push(StepKind::SccResult, Span<std::uint32_t>(summary, 3), (std::int64_t)components.count);
+    completed(steps, AlgorithmKind::StrongComponents);
+}
 
-    if (callback) callback("Cycle detection completed.");
+bool strongComponents(const CsrGraph &graph, StrongComponents &out, SccMethod method, RunControl *control,
+                      unsigned threads) {
+    std::vector<Vertex> label(graph.vertexCount(), SccUnlabelled);
+    bool finished = method == SccMethod::Tarjan ? sccTarjan(graph, label, control)
+                                                : sccForwardBackward(graph, label, control, threads);
+    if (!finished) return false;
+    sccCondense(graph, label, out);
+    return true;
 }
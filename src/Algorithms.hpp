@@ -2,6 +2,10 @@
 #define ALGORITHMS_HPP
 
 #include "Graph.hpp"
+#include "CsrGraph.hpp"
+#include "RunControl.hpp"
+#include "StepLog.hpp"
+#include "PriorityQueue.hpp"
 #include <functional>
 #include <string>
 #include <unordered_map>
@@ -10,23 +14,215 @@
 #include <queue>
 #include <limits>
 #include <algorithm>
+#include <memory>
 
-using StepCallback = std::function<void(const std::string&)>;
+class RouteIndex;
+
+// Every entry point taking a Graph builds a CsrGraph snapshot and runs on it.
+// Callers running several algorithms on the same graph can build the
+// snapshot once and use the CsrGraph overloads directly.
+// Steps are appended to a StepLog as typed events (see StepLog.hpp); pass a
+// disabled log to run without recording them.
+// An optional RunControl lets another thread cancel a run and watch progress.
 
 // ---- Traversals ----
-void dfs(const Graph &graph, const std::string &start, StepCallback callback);
-void bfs(const Graph &graph, const std::string &start, StepCallback callback);
+void dfs(const Graph &graph, const std::string &start, StepLog &steps, RunControl *control = nullptr);
+void bfs(const Graph &graph, const std::string &start, StepLog &steps, RunControl *control = nullptr);
+
+// Hop counts and a BFS tree from one source
+struct BfsTree {
+    static constexpr std::uint32_t Unreached = std::numeric_limits<std::uint32_t>::max();
+
+    std::vector<std::uint32_t> level;     // hops from the source, Unreached if not reachable
+    std::vector<CsrGraph::Vertex> parent; // one level closer to the source, npos for the source / unreached
+};
+
+// Direction-optimizing parallel BFS without steps on `threads` workers
+// (0 = all cores). Levels are those bfs() visits in; parents form a
+// shortest-path tree that does not depend on the thread count.
+// Returns false if cancelled.
+bool bfsTree(const CsrGraph &graph, CsrGraph::Vertex source, BfsTree &out, RunControl *control = nullptr,
+             unsigned threads = 0);
 
 // ---- Shortest Paths ----
-void dijkstra(const Graph &graph, const std::string &start, StepCallback callback);
-void bellmanFord(const Graph &graph, const std::string &start, StepCallback callback);
-void floydWarshall(const Graph &graph, StepCallback callback);
+void dijkstra(const Graph &graph, const std::string &start, StepLog &steps, RunControl *control = nullptr);
+// Bellman-Ford: a worklist of the vertices whose distance dropped, stopping
+// at the first sign of a negative cycle. With a goal the final path to it
+// is recorded (PathUpdate); no other path is built.
+void bellmanFord(const Graph &graph, const std::string &start, StepLog &steps, RunControl *control = nullptr,
+                 const std::string &goal = std::string());
+void floydWarshall(const Graph &graph, StepLog &steps, RunControl *control = nullptr);
+// Delta-stepping: Dijkstra's distances from buckets of tentative distances
+// relaxed in parallel when the log is disabled
+void deltaStepping(const Graph &graph, const std::string &start, StepLog &steps, RunControl *control = nullptr);
+// Point-to-point: shortest route from start to goal, stopping as soon as it
+// is known. A* follows straight-line distance over `coordinates` (one point
+// per node) when given, and explores like Dijkstra otherwise.
+void bidirectionalDijkstra(const Graph &graph, const std::string &start, const std::string &goal, StepLog &steps,
+                           RunControl *control = nullptr);
+void aStar(const Graph &graph, const std::string &start, const std::string &goal, StepLog &steps,
+           RunControl *control = nullptr, const std::vector<Point> *coordinates = nullptr);
+
+// Distances from one source
+struct PathDistances {
+    static constexpr long long Unreachable = std::numeric_limits<long long>::max() / 4;
+
+    std::vector<long long> dist; // Unreachable if there is no path
+    bool negativeCycle = false;  // a negative cycle is reachable; dist is meaningless
+};
+
+// Delta-stepping without steps on `threads` workers (0 = all cores).
+// Distances are the ones dijkstra() settles. Returns false if cancelled.
+bool shortestDistances(const CsrGraph &graph, CsrGraph::Vertex source, PathDistances &out,
+                       RunControl *control = nullptr, unsigned threads = 0);
+
+// Distances and a shortest-path tree from one source; weights may be negative
+struct ShortestPathTree {
+    std::vector<long long> dist;          // PathDistances::Unreachable if there is no path
+    std::vector<CsrGraph::Vertex> parent; // previous vertex on a shortest path, npos for the source / unreached
+    bool negativeCycle = false;           // a negative cycle is reachable; dist and parent are meaningless
+    std::size_t scanned = 0;              // vertices taken off the queue, counting repeats
+
+    // source, ..., v (empty if unreachable), walked up the tree on demand
+    std::vector<CsrGraph::Vertex> path(CsrGraph::Vertex v) const;
+};
+
+// Queue-based Bellman-Ford without steps. Returns false if cancelled.
+bool shortestPathTree(const CsrGraph &graph, CsrGraph::Vertex source, ShortestPathTree &out,
+                      RunControl *control = nullptr);
+
+// Shortest route between two vertices
+struct Route {
+    long long distance = PathDistances::Unreachable; // Unreachable if there is none
+    std::vector<CsrGraph::Vertex> path;              // source, ..., target (empty if unreachable)
+    std::size_t settled = 0;                         // vertices taken off the queues
+    bool negativeCycle = false;                      // a negative cycle was reachable; no route
+};
+
+// Bidirectional Dijkstra without steps. Returns false if cancelled.
+bool shortestRoute(const CsrGraph &graph, CsrGraph::Vertex source, CsrGraph::Vertex target, Route &out,
+                   RunControl *control = nullptr);
+// A* without steps, guided by straight-line distance over `coordinates`
+// (one point per vertex). Returns false if cancelled.
+bool shortestRoute(const CsrGraph &graph, CsrGraph::Vertex source, CsrGraph::Vertex target,
+                   const std::vector<Point> &coordinates, Route &out, RunControl *control = nullptr);
+
+// Dense all-pairs shortest paths (row-major n x n matrices)
+struct AllPairsPaths {
+    static constexpr long long Unreachable = std::numeric_limits<long long>::max() / 4;
+
+    std::size_t n = 0;
+    std::vector<long long> dist;        // dist[i * n + j], Unreachable if there is no path
+    std::vector<CsrGraph::Vertex> next; // first hop of a shortest i -> j path, npos if none
+    bool negativeCycle = false;         // dist/next are meaningless when set
+
+    long long distance(CsrGraph::Vertex i, CsrGraph::Vertex j) const { return dist[i * n + j]; }
+    // i, ..., j (empty if unreachable)
+    std::vector<CsrGraph::Vertex> path(CsrGraph::Vertex i, CsrGraph::Vertex j) const;
+};
+
+// Floyd-Warshall without steps, using the cache-blocked kernel on
+// `threads` workers (0 = all cores). Returns false if cancelled.
+bool allPairsShortestPaths(const CsrGraph &graph, AllPairsPaths &out, RunControl *control = nullptr,
+                           unsigned threads = 0);
 
 // ---- Minimum Spanning Trees ----
-void primMST(const Graph &graph, const std::string &start, StepCallback callback);
-void kruskalMST(const Graph &graph, StepCallback callback);
+void primMST(const Graph &graph, const std::string &start, StepLog &steps, RunControl *control = nullptr);
+// Kruskal: filter-Kruskal over all cores when the log is disabled
+void kruskalMST(const Graph &graph, StepLog &steps, RunControl *control = nullptr);
+// Borůvka: every component joins its lightest neighbour each round, in
+// parallel when the log is disabled
+void boruvkaMST(const Graph &graph, StepLog &steps, RunControl *control = nullptr);
+
+// Minimum spanning forest as edge ids of a CsrGraph
+struct SpanningForest {
+    std::vector<std::uint32_t> edges; // in the order they were taken
+    long long weight = 0;
+};
+
+enum class MstMethod { Boruvka, FilterKruskal };
+
+// Minimum spanning forest without steps on `threads` workers (0 = all
+// cores), ignoring edge directions like kruskalMST(). Ties are broken by
+// edge id, so every method picks the forest kruskalMST() reports.
+// Returns false if cancelled.
+bool minimumSpanningForest(const CsrGraph &graph, SpanningForest &out, MstMethod method = MstMethod::FilterKruskal,
+                           RunControl *control = nullptr, unsigned threads = 0);
 
 // ---- Cycle detection entry points ----
-    void detectCycles(const Graph &graph, std::function<void(const std::string&)> callback);
+void detectCycles(const Graph &graph, StepLog &steps, RunControl *control = nullptr);
+
+// ---- Strongly connected components ----
+// Every component, then a summary of the condensation (SCC_RESULT).
+// Undirected edges join their ends both ways. Tarjan records the steps; with
+// the log disabled the parallel forward-backward method runs instead.
+void stronglyConnectedComponents(const Graph &graph, StepLog &steps, RunControl *control = nullptr);
+
+// Components and their condensation DAG over a CsrGraph
+struct StrongComponents {
+    std::size_t count = 0;
+    std::vector<std::uint32_t> component; // per vertex; ids follow each component's smallest vertex
+    std::vector<char> cyclic;             // per component: holds a cycle (2+ vertices or a self-loop)
+    // Condensation: component c has arcs to dagTargets[dagBegin[c] .. dagBegin[c + 1]), each once
+    std::vector<std::size_t> dagBegin;
+    std::vector<std::uint32_t> dagTargets;
+    std::vector<std::uint32_t> order;     // component ids in topological order, sources first
+};
+
+enum class SccMethod { Tarjan, ForwardBackward };
+
+// Strongly connected components without steps. Tarjan runs on the calling
+// thread; forward-backward trims and peels the giant component on
+// `threads` workers (0 = all cores). Both number components alike.
+// Returns false if cancelled.
+bool strongComponents(const CsrGraph &graph, StrongComponents &out, SccMethod method = SccMethod::ForwardBackward,
+                      RunControl *control = nullptr, unsigned threads = 0);
+
+// ---- Same algorithms on a prebuilt snapshot ----
+void dfs(const CsrGraph &graph, const std::string &start, StepLog &steps, RunControl *control = nullptr);
+void bfs(const CsrGraph &graph, const std::string &start, StepLog &steps, RunControl *control = nullptr);
+void dijkstra(const CsrGraph &graph, const std::string &start, StepLog &steps, RunControl *control = nullptr);
+void bellmanFord(const CsrGraph &graph, const std::string &start, StepLog &steps, RunControl *control = nullptr,
+                 const std::string &goal = std::string());
+void deltaStepping(const CsrGraph &graph, const std::string &start, StepLog &steps, RunControl *control = nullptr);
+void bidirectionalDijkstra(const CsrGraph &graph, const std::string &start, const std::string &goal, StepLog &steps,
+                           RunControl *control = nullptr);
+void aStar(const CsrGraph &graph, const std::string &start, const std::string &goal, StepLog &steps,
+           RunControl *control = nullptr, const std::vector<Point> *coordinates = nullptr);
+void floydWarshall(const CsrGraph &graph, StepLog &steps, RunControl *control = nullptr);
+void primMST(const CsrGraph &graph, const std::string &start, StepLog &steps, RunControl *control = nullptr);
+void kruskalMST(const CsrGraph &graph, StepLog &steps, RunControl *control = nullptr);
+void boruvkaMST(const CsrGraph &graph, StepLog &steps, RunControl *control = nullptr);
+void detectCycles(const CsrGraph &graph, StepLog &steps, RunControl *control = nullptr);
+void stronglyConnectedComponents(const CsrGraph &graph, StepLog &steps, RunControl *control = nullptr);
+
+// ---- Same, with the priority queue picked at compile time ----
+// Queue is LazyHeap, QuadHeap or RadixHeap (see PriorityQueue.hpp). The
+// overloads above use QuadHeap, and RadixHeap for dijkstra() without
+// steps. Dijkstra hands graphs with a negative weight to the
+// label-correcting ssspBellmanFord() (BellmanFord.hpp) whatever the queue. Prim's keys are not monotone, so it takes LazyHeap or
+// QuadHeap.
+template <template <typename> class Queue>
+void dijkstra(const CsrGraph &graph, const std::string &start, StepLog &steps, RunControl *control = nullptr);
+template <template <typename> class Queue>
+void primMST(const CsrGraph &graph, const std::string &start, StepLog &steps, RunControl *control = nullptr);
+
+// ---- Routes on a preprocessed index (RouteIndex.hpp) ----
+// The first query builds the index, later ones on the same RouteIndex just
+// use it. Where it can't be built (a negative weight) the route is the one
+// bidirectionalDijkstra() finds.
+void contractionHierarchy(RouteIndex &index, const std::string &start, const std::string &goal, StepLog &steps,
+                          RunControl *control = nullptr);
+// A* with the landmarks' lower bounds (ALT)
+void landmarkAStar(RouteIndex &index, const std::string &start, const std::string &goal, StepLog &steps,
+                   RunControl *control = nullptr);
+// bidirectionalDijkstra() and aStar() on a RouteSearch the index keeps
+// between queries. A* is guided by straight-line distance over
+// `coordinates` when given; its scale is worked out again only when they
+// change.
+void bidirectionalDijkstra(RouteIndex &index, const std::string &start, const std::string &goal, StepLog &steps,
+                           RunControl *control = nullptr);
+void aStar(RouteIndex &index, const std::string &start, const std::string &goal, StepLog &steps,
+           RunControl *control = nullptr, std::shared_ptr<const std::vector<Point>> coordinates = nullptr);
 
 #endif // ALGORITHMS_HPP
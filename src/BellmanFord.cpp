@@ -0,0 +1,84 @@
+#include "BellmanFord.hpp"
+
+namespace {
+
+using Vertex = CsrGraph::Vertex;
+constexpr long long Unreachable = PathDistances::Unreachable;
+constexpr std::size_t PollInterval = 1024; // queue pops between cancellation checks
+
+// Whether the parent pointers close a cycle. Each walk climbs until it
+// meets the root, a vertex an earlier walk cleared, or its own trail.
+bool parentCycle(const std::vector<Vertex> &parent, std::vector<std::uint32_t> &walk) {
+    const std::size_t n = parent.size();
+    std::fill(walk.begin(), walk.end(), 0);
+    for (Vertex v = 0; v < n; ++v) {
+        const std::uint32_t id = v + 1;
+        for (Vertex x = v; x != CsrGraph::npos && walk[x] == 0; x = parent[x]) {
+            walk[x] = id;
+            if (parent[x] != CsrGraph::npos && walk[parent[x]] == id) return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+bool ssspBellmanFord(const CsrGraph &graph, Vertex source, ShortestPathTree &out, RunControl *control,
+                     StepLog *steps) {
+    const std::size_t n = graph.vertexCount();
+    out.dist.assign(n, Unreachable);
+    out.parent.assign(n, CsrGraph::npos);
+    out.negativeCycle = false;
+    out.scanned = 0;
+    std::vector<long long> &dist = out.dist;
+    std::vector<Vertex> &parent = out.parent;
+
+    // hops[v]: arcs on v's tentative path; V of them means it loops
+    std::vector<std::uint32_t> hops(n, 0), walk(n);
+    std::vector<char> queued(n, 0);
+    // FIFO ring; a vertex is queued at most once at a time, so n slots do
+    std::vector<Vertex> ring(n);
+    std::size_t head = 0, size = 0;
+    auto push = [&](Vertex v) {
+        queued[v] = 1;
+        ring[(head + size++) % n] = v;
+    };
+
+    dist[source] = 0;
+    push(source);
+    std::size_t reached = 1, sinceWalk = 0;
+
+    while (size) {
+        if (++out.scanned % PollInterval == 0 && control) {
+            if (control->isCancelled()) return false;
+            control->report(reached, n);
+        }
+        const Vertex u = ring[head];
+        head = (head + 1) % n;
+        --size;
+        queued[u] = 0;
+        if (steps) steps->push(StepKind::Processing, u, CsrGraph::npos, dist[u]);
+
+        for (std::size_t a = graph.arcBegin(u); a < graph.arcEnd(u); ++a) {
+            const Vertex v = graph.target(a);
+            const long long candidate = dist[u] + graph.weight(a);
+            if (candidate >= dist[v]) continue;
+            if (dist[v] == Unreachable) ++reached;
+            dist[v] = candidate;
+            parent[v] = u;
+            hops[v] = hops[u] + 1;
+            if (steps) {
+                steps->push(StepKind::DistanceUpdate, v, u, candidate, (std::uint32_t)a);
+                steps->push(StepKind::EdgeHighlight, u, v, 0, (std::uint32_t)a);
+            }
+
+            if (hops[v] >= n || (++sinceWalk >= n && parentCycle(parent, walk))) {
+                out.negativeCycle = true;
+                return true;
+            }
+            if (sinceWalk >= n) sinceWalk = 0;
+            if (!queued[v]) push(v);
+        }
+    }
+    return true;
+}
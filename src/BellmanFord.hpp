@@ -0,0 +1,27 @@
+#ifndef BELLMANFORD_HPP
+#define BELLMANFORD_HPP
+
+#include "Algorithms.hpp"
+
+// Queue-based Bellman-Ford (the "SPFA" variant) behind bellmanFord() and
+// shortestPathTree(), and the one label-correcting engine the other
+// searches hand graphs with a negative arc to (dijkstra(), delta-stepping,
+// the point-to-point routes). Instead of sweeping every edge per round, a FIFO
+// worklist holds the vertices whose distance dropped since they were last
+// scanned; only their arcs are relaxed. Sparse graphs with a few negative
+// arcs settle after a handful of passes over each vertex.
+//
+// A reachable negative cycle is caught two ways: a vertex whose tentative
+// path reaches V arcs, and, every V relaxations, a walk over the parent
+// pointers, since any cycle among them is a negative one (Tarjan's
+// observation, as used by Cherkassky & Goldberg). The walk usually finds
+// the cycle long before V rounds would have.
+//
+// With a StepLog the run records a Processing step per vertex taken from
+// the queue and a DistanceUpdate (v, from u, arc) plus an EdgeHighlight per
+// lowered distance; paths are left to ShortestPathTree::path().
+// Returns false if cancelled.
+bool ssspBellmanFord(const CsrGraph &graph, CsrGraph::Vertex source, ShortestPathTree &out, RunControl *control,
+                     StepLog *steps = nullptr);
+
+#endif // BELLMANFORD_HPP
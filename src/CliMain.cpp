@@ -0,0 +1,611 @@
+// yggdrasilleon-cli: headless batch runner for the algorithm engine.
+// Loads graph files, runs one algorithm on each and writes results and
+// timings as JSON or CSV. Links only the Qt-free core library.
+
+#include "Algorithms.hpp"
+#include "Generators.hpp"
+#include "GraphIO.hpp"
+#include "RouteIndex.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+// What a run starts from and heads for
+struct Query {
+    std::string start;
+    std::string goal;
+    std::shared_ptr<const std::vector<Point>> coordinates; // generated graphs with a layout
+    RouteIndex *index = nullptr;                           // point-to-point routes
+};
+
+// Preprocessed index an algorithm queries
+enum class IndexKind { None, Hierarchy, Landmarks };
+
+using RunFn = void (*)(const CsrGraph &graph, const Query &query, StepLog &steps);
+// The outcome in a line, from the step-free engines so it does not depend on the log
+using SummaryFn = std::string (*)(const CsrGraph &graph, const Query &query);
+
+struct AlgorithmEntry {
+    const char *name;
+    bool needsStart;
+    bool needsGoal;
+    RunFn run;
+    SummaryFn summarize;
+    IndexKind index = IndexKind::None;
+};
+
+// ---- Result summaries ----
+bool findVertex(const CsrGraph &graph, const std::string &name, CsrGraph::Vertex &v, std::string &missing) {
+    v = graph.find(name);
+    if (v == CsrGraph::npos) missing = "node '" + name + "' not found";
+    return v != CsrGraph::npos;
+}
+
+// "reached R of N, <what> D" over per-vertex values with `unreached` for the
+// rest; the source counts, so D is never below zero
+template <typename T>
+std::string reachSummary(const std::vector<T> &values, T unreached, const char *what) {
+    std::size_t reached = 0;
+    T furthest = 0;
+    for (T d : values) {
+        if (d == unreached) continue;
+        ++reached;
+        furthest = std::max(furthest, d);
+    }
+    return "reached " + std::to_string(reached) + " of " + std::to_string(values.size()) + ", " + what + " " +
+           std::to_string(furthest);
+}
+
+std::string levelSummary(const CsrGraph &g, const Query &q) {
+    CsrGraph::Vertex s;
+    std::string missing;
+    if (!findVertex(g, q.start, s, missing)) return missing;
+    BfsTree tree;
+    bfsTree(g, s, tree);
+    return reachSummary(tree.level, BfsTree::Unreached, "max hops");
+}
+
+std::string distanceSummary(const CsrGraph &g, const Query &q) {
+    CsrGraph::Vertex s;
+    std::string missing;
+    if (!findVertex(g, q.start, s, missing)) return missing;
+    PathDistances out;
+    shortestDistances(g, s, out);
+    if (out.negativeCycle) return "negative cycle";
+    return reachSummary(out.dist, PathDistances::Unreachable, "max distance");
+}
+
+std::string pathTreeSummary(const CsrGraph &g, const Query &q) {
+    CsrGraph::Vertex s;
+    std::string missing;
+    if (!findVertex(g, q.start, s, missing)) return missing;
+    ShortestPathTree tree;
+    shortestPathTree(g, s, tree);
+    if (tree.negativeCycle) return "negative cycle";
+    return reachSummary(tree.dist, PathDistances::Unreachable, "max distance");
+}
+
+std::string routeSummary(const CsrGraph &g, const Query &q) {
+    CsrGraph::Vertex s, t;
+    std::string missing;
+    if (!findVertex(g, q.start, s, missing) || !findVertex(g, q.goal, t, missing)) return missing;
+    Route route;
+    shortestRoute(g, s, t, route);
+    if (route.negativeCycle) return "negative cycle";
+    if (route.distance == PathDistances::Unreachable) return "no route";
+    return "distance " + std::to_string(route.distance) + ", " + std::to_string(route.path.size() - 1) + " hops";
+}
+
+std::string allPairsSummary(const CsrGraph &g, const Query &) {
+    AllPairsPaths paths;
+    allPairsShortestPaths(g, paths);
+    if (paths.negativeCycle) return "negative cycle";
+    std::size_t pairs = 0;
+    long long furthest = 0;
+    for (std::size_t i = 0; i < paths.n; ++i)
+        for (std::size_t j = 0; j < paths.n; ++j) {
+            long long d = paths.dist[i * paths.n + j];
+            if (i == j || d == AllPairsPaths::Unreachable) continue;
+            furthest = pairs++ ? std::max(furthest, d) : d;
+        }
+    if (!pairs) return "no connected pairs";
+    return "connected pairs " + std::to_string(pairs) + ", max distance " + std::to_string(furthest);
+}
+
+std::string forestSummary(const CsrGraph &g, const Query &) {
+    SpanningForest forest;
+    minimumSpanningForest(g, forest);
+    return "weight " + std::to_string(forest.weight) + ", " + std::to_string(forest.edges.size()) + " edges";
+}
+
+// Prim grows one tree: the forest's tree holding the start
+std::string treeSummary(const CsrGraph &g, const Query &q) {
+    CsrGraph::Vertex s;
+    std::string missing;
+    if (!findVertex(g, q.start, s, missing)) return missing;
+    SpanningForest forest;
+    minimumSpanningForest(g, forest);
+    std::vector<CsrGraph::Vertex> root(g.vertexCount());
+    for (std::size_t v = 0; v < root.size(); ++v) root[v] = (CsrGraph::Vertex)v;
+    auto find = [&](CsrGraph::Vertex v) {
+        while (root[v] != v) v = root[v] = root[root[v]];
+        return v;
+    };
+    for (std::uint32_t e : forest.edges) root[find(g.edgeSource(e))] = find(g.edgeTarget(e));
+    std::size_t edges = 0;
+    long long weight = 0;
+    for (std::uint32_t e : forest.edges) {
+        if (find(g.edgeSource(e)) != find(s)) continue;
+        ++edges;
+        weight += g.edgeWeight(e);
+    }
+    return "weight " + std::to_string(weight) + ", " + std::to_string(edges) + " edges";
+}
+
+std::string componentSummary(const CsrGraph &g, const Query &) {
+    StrongComponents scc;
+    strongComponents(g, scc);
+    return "components " + std::to_string(scc.count);
+}
+
+// Undirected graphs: independent cycles (edges left out of a spanning
+// forest). Otherwise the strong components that hold a cycle, undirected
+// edges joining their ends both ways as in stronglyConnectedComponents().
+std::string cycleSummary(const CsrGraph &g, const Query &) {
+    bool undirected = true;
+    for (std::size_t e = 0; e < g.edgeCount() && undirected; ++e) undirected = !g.edgeDirected(e);
+    std::size_t cycles = 0;
+    if (undirected) {
+        SpanningForest forest;
+        minimumSpanningForest(g, forest);
+        cycles = g.edgeCount() - forest.edges.size();
+        return cycles ? "independent cycles " + std::to_string(cycles) : "acyclic";
+    }
+    StrongComponents scc;
+    strongComponents(g, scc);
+    for (char c : scc.cyclic) cycles += c != 0;
+    return cycles ? "cyclic components " + std::to_string(cycles) : "acyclic";
+}
+
+const AlgorithmEntry algorithms[] = {
+    {"dfs",            true,  false,
+     [](const CsrGraph &g, const Query &q, StepLog &l) { dfs(g, q.start, l); }, levelSummary},
+    {"bfs",            true,  false,
+     [](const CsrGraph &g, const Query &q, StepLog &l) { bfs(g, q.start, l); }, levelSummary},
+    {"dijkstra",       true,  false,
+     [](const CsrGraph &g, const Query &q, StepLog &l) { dijkstra(g, q.start, l); }, distanceSummary},
+    {"delta-stepping", true,  false,
+     [](const CsrGraph &g, const Query &q, StepLog &l) { deltaStepping(g, q.start, l); }, distanceSummary},
+    {"bidirectional-dijkstra", true, true,
+     [](const CsrGraph &, const Query &q, StepLog &l) { bidirectionalDijkstra(*q.index, q.start, q.goal, l); },
+     routeSummary},
+    {"astar",          true,  true,
+     [](const CsrGraph &, const Query &q, StepLog &l) { aStar(*q.index, q.start, q.goal, l, nullptr, q.coordinates); },
+     routeSummary},
+    {"ch",             true,  true,
+     [](const CsrGraph &, const Query &q, StepLog &l) { contractionHierarchy(*q.index, q.start, q.goal, l); },
+     routeSummary, IndexKind::Hierarchy},
+    {"alt",            true,  true,
+     [](const CsrGraph &, const Query &q, StepLog &l) { landmarkAStar(*q.index, q.start, q.goal, l); },
+     routeSummary, IndexKind::Landmarks},
+    {"bellman-ford",   true,  false,
+     [](const CsrGraph &g, const Query &q, StepLog &l) { bellmanFord(g, q.start, l); }, pathTreeSummary},
+    {"floyd-warshall", false, false,
+     [](const CsrGraph &g, const Query &,  StepLog &l) { floydWarshall(g, l); }, allPairsSummary},
+    {"prim",           true,  false,
+     [](const CsrGraph &g, const Query &q, StepLog &l) { primMST(g, q.start, l); }, treeSummary},
+    {"kruskal",        false, false,
+     [](const CsrGraph &g, const Query &,  StepLog &l) { kruskalMST(g, l); }, forestSummary},
+    {"boruvka",        false, false,
+     [](const CsrGraph &g, const Query &,  StepLog &l) { boruvkaMST(g, l); }, forestSummary},
+    {"cycles",         false, false,
+     [](const CsrGraph &g, const Query &,  StepLog &l) { detectCycles(g, l); }, cycleSummary},
+    {"scc",            false, false,
+     [](const CsrGraph &g, const Query &, StepLog &l) { stronglyConnectedComponents(g, l); }, componentSummary},
+};
+
+const AlgorithmEntry *findAlgorithm(const std::string &name) {
+    for (const auto &a : algorithms)
+        if (name == a.name) return &a;
+    return nullptr;
+}
+
+struct Options {
+    const AlgorithmEntry *algorithm = nullptr;
+    std::string start;          // empty: each graph's first node
+    std::string goal;           // empty: each graph's last node
+    bool csv = false;
+    std::string outputPath;     // empty: stdout
+    bool dumpSteps = false;     // JSON only: include every step's text
+    bool recordSteps = true;    // --no-log runs with a disabled StepLog
+    std::string indexPath;      // ch / alt: load the index from here, or build and save it
+    int repeat = 1;
+    std::vector<std::string> graphs; // file paths, or generator specs when generated[i]
+    std::vector<bool> generated;
+};
+
+// One graph's outcome
+struct Record {
+    std::string graph;
+    std::string start;
+    std::string goal;
+    std::string error;          // empty on success
+    std::size_t nodes = 0;
+    std::size_t edges = 0;
+    double loadMs = 0, buildMs = 0, runMsMean = 0, runMsMin = 0;
+    double prepMs = 0;          // building or loading the route index
+    std::string index;          // "built", "loaded" or "none" (couldn't be built)
+    std::size_t stepCount = 0;
+    std::string result;         // one-line summary of the outcome
+    std::vector<std::string> stepTexts;
+};
+
+void printUsage(std::ostream &out) {
+    out << "Usage: yggdrasilleon-cli -a ALGORITHM [options] [GRAPH...]\n"
+           "\n"
+           "Runs ALGORITHM on every GRAPH file ('-' reads stdin) and every generated\n"
+           "graph, and writes one record per graph with its result and timings.\n"
+           "\n"
+           "Options:\n"
+           "  -a, --algorithm NAME   dfs, bfs, dijkstra, delta-stepping,\n"
+           "                         bidirectional-dijkstra, astar, ch, alt,\n"
+           "                         bellman-ford, floyd-warshall, prim, kruskal, boruvka,\n"
+           "                         cycles, scc\n"
+           "  -s, --start NODE       start node (default: each graph's first node)\n"
+           "  -t, --goal NODE        goal node of bidirectional-dijkstra, astar, ch and alt\n"
+           "                         (default: each graph's last node)\n"
+           "  -f, --format FMT       json (default) or csv\n"
+           "  -o, --output FILE      write to FILE instead of stdout\n"
+           "  -r, --repeat N         time N runs per graph (default 1)\n"
+           "      --steps            include every step's text (json only)\n"
+           "      --no-log           don't record steps; times the bare algorithm\n"
+           "      --index FILE       ch, alt: load the preprocessed index from FILE, or\n"
+           "                         build it and save it there (one graph only)\n"
+           "  -g, --generate SPEC    generate a graph instead of loading one (repeatable):\n"
+           "                         KIND[:key=value,...], KIND one of rmat, barabasi-albert,\n"
+           "                         geometric, grid, erdos-renyi; keys nodes, edges, m,\n"
+           "                         a, b, c, directed, wmin, wmax, seed, threads\n"
+           "                         e.g. rmat:nodes=1e6,edges=1.6e7,seed=7\n"
+           "  -h, --help             show this help\n"
+           "\n"
+           "Graph files are the GUI's saved output or a plain edge list\n"
+           "(\"from to [weight] [directed]\" per line). astar follows straight-line\n"
+           "distance on generated grid and geometric graphs, and explores like\n"
+           "Dijkstra on graphs without a layout.\n"
+           "\n"
+           "ch (contraction hierarchy) and alt (A* with landmark bounds) preprocess\n"
+           "the graph first; prep_ms times that and run_ms the queries alone.\n";
+}
+
+// Returns 0 to continue, otherwise the exit code
+int parseOptions(int argc, char **argv, Options &opts) {
+    auto value = [&](int &i) -> const char * {
+        if (i + 1 >= argc) {
+            std::cerr << "yggdrasilleon-cli: " << argv[i] << " needs a value\n";
+            return nullptr;
+        }
+        return argv[++i];
+    };
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        const char *v = nullptr;
+        if (arg == "-h" || arg == "--help") {
+            printUsage(std::cout);
+            return -1;
+        } else if (arg == "-a" || arg == "--algorithm") {
+            if (!(v = value(i))) return 2;
+            opts.algorithm = findAlgorithm(v);
+            if (!opts.algorithm) {
+                std::cerr << "yggdrasilleon-cli: unknown algorithm '" << v << "'\n";
+                return 2;
+            }
+        } else if (arg == "-s" || arg == "--start") {
+            if (!(v = value(i))) return 2;
+            opts.start = v;
+        } else if (arg == "-t" || arg == "--goal") {
+            if (!(v = value(i))) return 2;
+            opts.goal = v;
+        } else if (arg == "-f" || arg == "--format") {
+            if (!(v = value(i))) return 2;
+            if (std::strcmp(v, "csv") == 0) opts.csv = true;
+            else if (std::strcmp(v, "json") == 0) opts.csv = false;
+            else {
+                std::cerr << "yggdrasilleon-cli: unknown format '" << v << "'\n";
+                return 2;
+            }
+        } else if (arg == "-o" || arg == "--output") {
+            if (!(v = value(i))) return 2;
+            opts.outputPath = v;
+        } else if (arg == "-r" || arg == "--repeat") {
+            if (!(v = value(i))) return 2;
+            opts.repeat = std::atoi(v);
+            if (opts.repeat < 1) {
+                std::cerr << "yggdrasilleon-cli: --repeat must be at least 1\n";
+                return 2;
+            }
+        } else if (arg == "-g" || arg == "--generate") {
+            if (!(v = value(i))) return 2;
+            GeneratorParams params;
+            std::string error;
+            if (!parseGeneratorSpec(v, params, &error)) {
+                std::cerr << "yggdrasilleon-cli: " << error << "\n";
+                return 2;
+            }
+            opts.graphs.push_back(v);
+            opts.generated.push_back(true);
+        } else if (arg == "--steps") {
+            opts.dumpSteps = true;
+        } else if (arg == "--no-log") {
+            opts.recordSteps = false;
+        } else if (arg == "--index") {
+            if (!(v = value(i))) return 2;
+            opts.indexPath = v;
+        } else if (arg.size() > 1 && arg[0] == '-') {
+            std::cerr << "yggdrasilleon-cli: unknown option '" << arg << "'\n";
+            return 2;
+        } else {
+            opts.graphs.push_back(arg);
+            opts.generated.push_back(false);
+        }
+    }
+
+    if (!opts.algorithm || opts.graphs.empty()) {
+        printUsage(std::cerr);
+        return 2;
+    }
+    if (!opts.indexPath.empty() && (opts.algorithm->index == IndexKind::None || opts.graphs.size() != 1)) {
+        std::cerr << "yggdrasilleon-cli: --index needs ch or alt and exactly one graph\n";
+        return 2;
+    }
+    if (opts.csv && opts.dumpSteps) {
+        std::cerr << "yggdrasilleon-cli: --steps is only available with --format json\n";
+        return 2;
+    }
+    return 0;
+}
+
+double elapsedMs(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+}
+
+// Load (or generate) the graph and build its snapshot, timing both steps
+bool acquire(const std::string &source, bool generated, CsrGraph &snapshot, std::vector<Point> &coordinates,
+             Record &rec) {
+    using Clock = std::chrono::steady_clock;
+    auto t0 = Clock::now();
+
+    if (generated) {
+        // generated graphs skip Graph and go straight to CSR
+        GeneratorParams params;
+        EdgeList edges;
+        bool ok = parseGeneratorSpec(source, params, &rec.error) && generateEdges(params, edges, &rec.error);
+        rec.loadMs = elapsedMs(t0);
+        if (!ok) return false;
+
+        t0 = Clock::now();
+        snapshot = toCsr(edges, params.threads);
+        rec.buildMs = elapsedMs(t0);
+        coordinates.swap(edges.coordinates);
+        return true;
+    }
+
+    Graph graph;
+    bool loaded = source == "-" ? readGraph(std::cin, graph, &rec.error)
+                                : loadGraph(source, graph, &rec.error);
+    rec.loadMs = elapsedMs(t0);
+    if (!loaded) return false;
+
+    t0 = Clock::now();
+    snapshot = CsrGraph(graph);
+    rec.buildMs = elapsedMs(t0);
+    return true;
+}
+
+// Load the route index from --index, or build it (and save it there),
+// timing either
+void prepareIndex(RouteIndex &index, IndexKind kind, const Options &opts, Record &rec) {
+    const bool hierarchy = kind == IndexKind::Hierarchy;
+    auto t0 = std::chrono::steady_clock::now();
+    if (!opts.indexPath.empty()) {
+        std::ifstream in(opts.indexPath, std::ios::binary);
+        std::string error;
+        if (in && (hierarchy ? index.loadHierarchy(in, &error) : index.loadLandmarks(in, &error))) {
+            rec.prepMs = elapsedMs(t0);
+            rec.index = "loaded";
+            return;
+        }
+        if (in) std::cerr << "yggdrasilleon-cli: " << opts.indexPath << ": " << error << ", rebuilding\n";
+    }
+
+    const bool built = hierarchy ? index.hierarchy() != nullptr : index.landmarks() != nullptr;
+    rec.prepMs = elapsedMs(t0);
+    rec.index = built ? "built" : "none";
+    if (!built || opts.indexPath.empty()) return;
+    std::ofstream out(opts.indexPath, std::ios::binary);
+    if (!(hierarchy ? index.saveHierarchy(out) : index.saveLandmarks(out)))
+        std::cerr << "yggdrasilleon-cli: cannot write " << opts.indexPath << "\n";
+}
+
+Record process(const std::string &source, bool generated, const Options &opts) {
+    using Clock = std::chrono::steady_clock;
+    Record rec;
+    rec.graph = source;
+
+    CsrGraph loaded;
+    std::vector<Point> coordinates;
+    if (!acquire(source, generated, loaded, coordinates, rec)) return rec;
+    auto frozen = std::make_shared<const CsrGraph>(std::move(loaded));
+    const CsrGraph &snapshot = *frozen;
+    rec.nodes = snapshot.vertexCount();
+    rec.edges = snapshot.edgeCount();
+
+    // Routes share one RouteIndex across repeats; ch / alt preprocessing
+    // is timed apart from the queries
+    std::unique_ptr<RouteIndex> index;
+    if (opts.algorithm->needsGoal) index = std::make_unique<RouteIndex>(frozen);
+    if (opts.algorithm->index != IndexKind::None) prepareIndex(*index, opts.algorithm->index, opts, rec);
+
+    if (opts.algorithm->needsStart) {
+        rec.start = opts.start;
+        if (rec.start.empty() && snapshot.vertexCount() > 0) rec.start = snapshot.name(0);
+    }
+    if (opts.algorithm->needsGoal) {
+        rec.goal = opts.goal;
+        if (rec.goal.empty() && snapshot.vertexCount() > 0) rec.goal = snapshot.name(snapshot.vertexCount() - 1);
+    }
+    std::shared_ptr<const std::vector<Point>> layout;
+    if (!coordinates.empty()) layout = std::make_shared<const std::vector<Point>>(std::move(coordinates));
+    const Query query{rec.start, rec.goal, layout, index.get()};
+
+    StepLog steps(opts.recordSteps);
+    double total = 0;
+    for (int i = 0; i < opts.repeat; ++i) {
+        steps.clear();
+        auto t0 = Clock::now();
+        opts.algorithm->run(snapshot, query, steps);
+        double runMs = elapsedMs(t0);
+        total += runMs;
+        rec.runMsMin = i == 0 ? runMs : std::min(rec.runMsMin, runMs);
+    }
+    rec.runMsMean = total / opts.repeat;
+
+    // Result: summarized once, outside the timed runs
+    rec.stepCount = steps.size();
+    rec.result = opts.algorithm->summarize(snapshot, query);
+    if (opts.dumpSteps) {
+        rec.stepTexts.reserve(steps.size());
+        for (std::size_t i = 0; i < steps.size(); ++i)
+            rec.stepTexts.push_back(describeStep(steps[i], steps.payload(steps[i]), snapshot.nodes()));
+    }
+    return rec;
+}
+
+// ---- Output ----
+std::string jsonString(const std::string &s) {
+    std::string out = "\"";
+    for (unsigned char c : s) {
+        switch (c) {
+        case '"':  out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (c < 0x20) {
+                char buf[8];
+                std::snprintf(buf, sizeof buf, "\\u%04x", c);
+                out += buf;
+            } else {
+                out += (char)c;
+            }
+        }
+    }
+    return out + "\"";
+}
+
+std::string csvField(const std::string &s) {
+    if (s.find_first_of(",\"\r\n") == std::string::npos) return s;
+    std::string out = "\"";
+    for (char c : s) {
+        if (c == '"') out += '"';
+        out += c;
+    }
+    return out + "\"";
+}
+
+std::string ms(double v) {
+    char buf[32];
+    std::snprintf(buf, sizeof buf, "%.3f", v);
+    return buf;
+}
+
+void writeJson(std::ostream &out, const Record &r, const Options &opts, bool first) {
+    out << (first ? "\n" : ",\n") << "    {"
+        << "\"graph\": " << jsonString(r.graph)
+        << ", \"algorithm\": " << jsonString(opts.algorithm->name)
+        << ", \"status\": " << (r.error.empty() ? "\"ok\"" : "\"error\"");
+    if (!r.error.empty()) {
+        out << ", \"error\": " << jsonString(r.error)
+            << ", \"load_ms\": " << ms(r.loadMs) << "}";
+        return;
+    }
+    if (opts.algorithm->needsStart) out << ", \"start\": " << jsonString(r.start);
+    if (opts.algorithm->needsGoal) out << ", \"goal\": " << jsonString(r.goal);
+    out << ", \"nodes\": " << r.nodes
+        << ", \"edges\": " << r.edges
+        << ", \"load_ms\": " << ms(r.loadMs)
+        << ", \"build_ms\": " << ms(r.buildMs);
+    if (opts.algorithm->index != IndexKind::None)
+        out << ", \"index\": " << jsonString(r.index) << ", \"prep_ms\": " << ms(r.prepMs);
+    out << ", \"run_ms\": " << ms(r.runMsMean)
+        << ", \"run_ms_min\": " << ms(r.runMsMin)
+        << ", \"repeat\": " << opts.repeat
+        << ", \"steps\": " << r.stepCount
+        << ", \"result\": " << jsonString(r.result);
+    if (opts.dumpSteps) {
+        out << ", \"step_log\": [";
+        for (std::size_t i = 0; i < r.stepTexts.size(); ++i)
+            out << (i ? ", " : "") << jsonString(r.stepTexts[i]);
+        out << "]";
+    }
+    out << "}";
+}
+
+void writeCsvHeader(std::ostream &out) {
+    out << "graph,algorithm,start,goal,status,nodes,edges,load_ms,build_ms,prep_ms,run_ms,run_ms_min,repeat,steps,result,"
+           "error\n";
+}
+
+void writeCsv(std::ostream &out, const Record &r, const Options &opts) {
+    out << csvField(r.graph) << ',' << opts.algorithm->name << ',' << csvField(r.start) << ',' << csvField(r.goal) << ','
+        << (r.error.empty() ? "ok" : "error") << ','
+        << r.nodes << ',' << r.edges << ','
+        << ms(r.loadMs) << ',' << ms(r.buildMs) << ',' << ms(r.prepMs) << ',' << ms(r.runMsMean) << ',' << ms(r.runMsMin) << ','
+        << opts.repeat << ',' << r.stepCount << ','
+        << csvField(r.result) << ',' << csvField(r.error) << '\n';
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Options opts;
+    int rc = parseOptions(argc, argv, opts);
+    if (rc != 0) return rc < 0 ? 0 : rc;
+
+    std::ofstream file;
+    if (!opts.outputPath.empty()) {
+        file.open(opts.outputPath);
+        if (!file) {
+            std::cerr << "yggdrasilleon-cli: cannot write " << opts.outputPath << "\n";
+            return 1;
+        }
+    }
+    std::ostream &out = opts.outputPath.empty() ? std::cout : file;
+
+    if (opts.csv) writeCsvHeader(out);
+    else out << "{\n  \"runs\": [";
+
+    bool failed = false;
+    for (std::size_t i = 0; i < opts.graphs.size(); ++i) {
+        Record rec = process(opts.graphs[i], opts.generated[i], opts);
+        if (!rec.error.empty()) {
+            std::cerr << "yggdrasilleon-cli: " << rec.error << "\n";
+            failed = true;
+        }
+        if (opts.csv) writeCsv(out, rec, opts);
+        else writeJson(out, rec, opts, i == 0);
+        out.flush();
+    }
+
+    if (!opts.csv) out << "\n  ]\n}\n";
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,463 @@
+#include "ContractionHierarchy.hpp"
+#include "IndexFile.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+using Vertex = CsrGraph::Vertex;
+constexpr long long Unreachable = PathDistances::Unreachable;
+
+// Witness searches give up after scanning this many links (settling a hub
+// counts for all of its links); a witness they miss only costs a shortcut
+// that wasn't needed
+constexpr std::size_t SimulationBudget = 250;   // ranking a vertex
+constexpr std::size_t ContractionBudget = 1000; // contracting it
+
+// Vertices with more in/out pairs than this are ranked as if every pair
+// needed a shortcut, without searching: hubs would otherwise be searched
+// around again each time one of their many neighbours goes
+constexpr std::size_t SimulatedPairs = 1000;
+
+// Contraction stops once the vertices left have this many links each on
+// average: every further one would cost searches in a near-clique and add
+// shortcuts by the hundred. The rest stays an uncontracted core.
+constexpr std::size_t CoreDegree = 16;
+
+// Arc of the graph that is still being contracted
+struct Link {
+    Vertex other;
+    Vertex middle; // npos for an original arc
+    long long weight;
+};
+
+// The remaining graph, with each vertex's outgoing and incoming links.
+// Parallel arcs are merged into the lightest one and self-loops dropped.
+class Overlay {
+public:
+    explicit Overlay(const CsrGraph &graph) : out(graph.vertexCount()), in(graph.vertexCount()) {
+        for (Vertex u = 0; u < graph.vertexCount(); ++u) {
+            std::vector<Link> &links = out[u];
+            for (std::size_t a = graph.arcBegin(u); a < graph.arcEnd(u); ++a)
+                if (graph.target(a) != u) links.push_back({graph.target(a), CsrGraph::npos, graph.weight(a)});
+            std::sort(links.begin(), links.end(), [](const Link &a, const Link &b) {
+                return a.other < b.other || (a.other == b.other && a.weight < b.weight);
+            });
+            links.erase(std::unique(links.begin(), links.end(),
+                                    [](const Link &a, const Link &b) { return a.other == b.other; }),
+                        links.end());
+            for (const Link &l : links) in[l.other].push_back({u, CsrGraph::npos, l.weight});
+            linkCount += links.size();
+        }
+    }
+
+    // Add u -> v, or lower the weight of the link already there; false if
+    // the existing link is at least as light
+    bool add(Vertex u, Vertex v, long long weight, Vertex middle) {
+        for (Link &l : out[u]) {
+            if (l.other != v) continue;
+            if (weight >= l.weight) return false;
+            l.weight = weight;
+            l.middle = middle;
+            for (Link &r : in[v]) {
+                if (r.other != u) continue;
+                r.weight = weight;
+                r.middle = middle;
+                break;
+            }
+            return true;
+        }
+        out[u].push_back({v, middle, weight});
+        in[v].push_back({u, middle, weight});
+        ++linkCount;
+        return true;
+    }
+
+    // Take v out of its neighbours' lists and free its own
+    void remove(Vertex v) {
+        for (const Link &l : out[v]) erase(in[l.other], v);
+        for (const Link &l : in[v]) erase(out[l.other], v);
+        linkCount -= out[v].size() + in[v].size();
+        std::vector<Link>().swap(out[v]);
+        std::vector<Link>().swap(in[v]);
+    }
+
+    std::vector<std::vector<Link>> out, in;
+    std::size_t linkCount = 0;
+
+private:
+    static void erase(std::vector<Link> &links, Vertex v) {
+        for (Link &l : links) {
+            if (l.other != v) continue;
+            l = links.back();
+            links.pop_back();
+            return;
+        }
+    }
+};
+
+// Dijkstra in the overlay that avoids one vertex, bounded in distance and
+// in the number of links it scans
+class WitnessSearch {
+public:
+    explicit WitnessSearch(std::size_t n) : labels(n, Label{0, 0, 0}), queue(n) {}
+
+    // Stops early once every vertex in `targets` is settled
+    void run(const Overlay &overlay, Vertex source, Vertex avoid, const std::vector<Link> &targets, long long limit,
+             std::size_t budget) {
+        if (++stamp == 0) {
+            for (Label &label : labels) label.seen = label.wanted = 0;
+            stamp = 1;
+        }
+        std::size_t remaining = 0;
+        for (const Link &t : targets)
+            if (t.other != source && labels[t.other].wanted != stamp) {
+                labels[t.other].wanted = stamp;
+                ++remaining;
+            }
+        reach(source, 0);
+        std::size_t scanned = 0;
+        while (!queue.empty()) {
+            auto [d, x] = queue.pop();
+            if (d > limit || scanned > budget) break;
+            scanned += 1 + overlay.out[x].size();
+            if (labels[x].wanted == stamp && --remaining == 0) break;
+            for (const Link &l : overlay.out[x]) {
+                if (l.other == avoid) continue;
+                const long long candidate = d + l.weight;
+                const Label &label = labels[l.other];
+                if (label.seen != stamp || candidate < label.dist) reach(l.other, candidate);
+            }
+        }
+        while (!queue.empty()) queue.pop();
+    }
+
+    // Length of some path the last run found to v (Unreachable if none)
+    long long distance(Vertex v) const { return labels[v].seen == stamp ? labels[v].dist : Unreachable; }
+
+private:
+    void reach(Vertex v, long long d) {
+        labels[v].dist = d;
+        labels[v].seen = stamp;
+        queue.push(v, d);
+    }
+
+    struct Label {
+        long long dist;
+        std::uint32_t seen;   // dist is valid where seen == stamp
+        std::uint32_t wanted; // a target of the current run where == stamp
+    };
+    std::vector<Label> labels;
+    std::uint32_t stamp = 0;
+    QuadHeap<long long> queue;
+};
+
+struct Shortcut {
+    Vertex from, to;
+    long long weight;
+};
+
+// Shortcuts that removing v needs: u -> x through v for every in-link u
+// and out-link x without a witness path from u to x as short
+void shortcutsFor(const Overlay &overlay, WitnessSearch &witness, Vertex v, std::size_t budget,
+                  std::vector<Shortcut> &needed) {
+    needed.clear();
+    const std::vector<Link> &outs = overlay.out[v];
+    for (const Link &in : overlay.in[v]) {
+        long long longest = -1;
+        for (const Link &o : outs)
+            if (o.other != in.other) longest = std::max(longest, o.weight);
+        if (longest < 0) continue;
+
+        witness.run(overlay, in.other, v, outs, in.weight + longest, budget);
+        for (const Link &o : outs) {
+            if (o.other == in.other) continue;
+            const long long through = in.weight + o.weight;
+            if (witness.distance(o.other) > through) needed.push_back({in.other, o.other, through});
+        }
+    }
+}
+
+} // namespace
+
+bool ContractionHierarchy::build(const CsrGraph &graph, RunControl *control, std::string *error) {
+    *this = ContractionHierarchy();
+    for (std::size_t a = 0; a < graph.arcCount(); ++a) {
+        if (graph.weight(a) >= 0) continue;
+        if (error) *error = "contraction hierarchies need non-negative weights";
+        return false;
+    }
+
+    fingerprint = graphFingerprint(graph);
+    const std::size_t n = graph.vertexCount();
+    Overlay overlay(graph);
+    WitnessSearch witness(n);
+    std::vector<Shortcut> needed;
+
+    // Cheapest first: shortcuts added minus links removed, spread out by
+    // how many neighbours are gone and how deep the vertex already sits
+    std::vector<std::uint32_t> contractedNeighbours(n, 0), level(n, 0);
+    auto priority = [&](Vertex v) {
+        const std::size_t pairs = overlay.in[v].size() * overlay.out[v].size();
+        std::size_t added = pairs;
+        if (pairs <= SimulatedPairs) {
+            shortcutsFor(overlay, witness, v, SimulationBudget, needed);
+            added = needed.size();
+        }
+        const long long removed = (long long)(overlay.in[v].size() + overlay.out[v].size());
+        return 2 * ((long long)added - removed) + contractedNeighbours[v] + level[v];
+    };
+
+    QuadHeap<long long> order(n);
+    for (Vertex v = 0; v < n; ++v) order.push(v, priority(v));
+
+    std::vector<std::vector<Arc>> upward(n), downward(n);
+    std::vector<Vertex> neighbours;
+    std::vector<std::uint32_t> listed(n, CsrGraph::npos);
+    rank.assign(n, 0);
+    std::uint32_t next = 0;
+    while (!order.empty() && overlay.linkCount < CoreDegree * (n - next)) {
+        if (control && (next & 1023) == 0) {
+            if (control->isCancelled()) {
+                *this = ContractionHierarchy();
+                return false;
+            }
+            control->report(next, n);
+        }
+
+        // Priorities go stale as the graph shrinks; re-rank lazily
+        const Vertex v = order.pop().second;
+        const long long current = priority(v);
+        if (!order.empty() && current > order.top().first) {
+            order.push(v, current);
+            continue;
+        }
+        rank[v] = next++;
+
+        shortcutsFor(overlay, witness, v, ContractionBudget, needed);
+        for (const Shortcut &s : needed) overlay.add(s.from, s.to, s.weight, v);
+
+        neighbours.clear();
+        for (const Link &l : overlay.out[v]) {
+            upward[v].push_back({l.weight, l.other, l.middle});
+            if (listed[l.other] != v) neighbours.push_back(l.other);
+            listed[l.other] = v;
+        }
+        for (const Link &l : overlay.in[v]) {
+            downward[v].push_back({l.weight, l.other, l.middle});
+            if (listed[l.other] != v) neighbours.push_back(l.other);
+            listed[l.other] = v;
+        }
+        overlay.remove(v);
+        for (Vertex x : neighbours) {
+            ++contractedNeighbours[x];
+            level[x] = std::max(level[x], level[v] + 1);
+            order.push(x, priority(x));
+        }
+    }
+
+    // The core ranks above everything contracted, each link both an up arc
+    // of its tail and a down arc of its head: queries cross it in either
+    // direction, as plain bidirectional Dijkstra would
+    while (!order.empty()) {
+        const Vertex v = order.pop().second;
+        rank[v] = next++;
+        ++core;
+        for (const Link &l : overlay.out[v]) upward[v].push_back({l.weight, l.other, l.middle});
+        for (const Link &l : overlay.in[v]) downward[v].push_back({l.weight, l.other, l.middle});
+    }
+
+    auto flatten = [n](std::vector<std::vector<Arc>> &lists, std::vector<std::uint64_t> &begin, std::vector<Arc> &arcs) {
+        begin.assign(n + 1, 0);
+        for (std::size_t v = 0; v < n; ++v) begin[v + 1] = begin[v] + lists[v].size();
+        arcs.reserve(begin[n]);
+        for (std::vector<Arc> &list : lists) {
+            arcs.insert(arcs.end(), list.begin(), list.end());
+            std::vector<Arc>().swap(list);
+        }
+    };
+    flatten(upward, upBegin, up);
+    flatten(downward, downBegin, down);
+    shortcuts = countShortcuts();
+    return true;
+}
+
+std::size_t ContractionHierarchy::countShortcuts() const {
+    // a core link is both an up and a down arc; everything else is one of them
+    std::size_t count = 0;
+    for (const Arc &a : up) count += a.middle != CsrGraph::npos;
+    for (std::size_t v = 0; v < rank.size(); ++v)
+        if (rank[v] < rank.size() - core)
+            for (std::uint64_t a = downBegin[v]; a < downBegin[v + 1]; ++a) count += down[a].middle != CsrGraph::npos;
+    return count;
+}
+
+// ---- Queries ----
+ContractionHierarchy::Query::Side::Side(std::size_t n)
+    : labels(n, Label{0, 0, CsrGraph::npos, 0}), queue(n) {}
+
+ContractionHierarchy::Query::Query(const ContractionHierarchy &hierarchy)
+    : hierarchy(hierarchy), forward(hierarchy.vertexCount()), backward(hierarchy.vertexCount()) {}
+
+void ContractionHierarchy::Query::route(Vertex source, Vertex target, Route &out, StepLog *steps) {
+    out = Route();
+    const std::size_t n = hierarchy.vertexCount();
+    if (source >= n || target >= n) return;
+    if (++stamp == 0) {
+        for (Side *side : {&forward, &backward})
+            for (Label &label : side->labels) label.seen = 0;
+        stamp = 1;
+    }
+
+    auto reach = [&](Side &side, Vertex v, long long d, Vertex from, std::size_t arc) {
+        side.labels[v] = Label{d, stamp, from, (std::uint32_t)arc};
+        side.queue.push(v, d);
+    };
+    reach(forward, source, 0, CsrGraph::npos, 0);
+    reach(backward, target, 0, CsrGraph::npos, 0);
+
+    long long best = Unreachable;
+    Vertex meet = CsrGraph::npos;
+    bool forwardTurn = false;
+    for (;;) {
+        // a side is done once nothing it holds can improve on best
+        for (Side *side : {&forward, &backward})
+            if (!side->queue.empty() && side->queue.top().first >= best)
+                while (!side->queue.empty()) side->queue.pop();
+        if (forward.queue.empty() && backward.queue.empty()) break;
+        forwardTurn = backward.queue.empty() || (!forward.queue.empty() && !forwardTurn);
+
+        // forward climbs the up arcs, backward the reversed down arcs
+        Side &self = forwardTurn ? forward : backward;
+        const Side &other = forwardTurn ? backward : forward;
+        const std::vector<std::uint64_t> &begin = forwardTurn ? hierarchy.upBegin : hierarchy.downBegin;
+        const std::vector<Arc> &arcs = forwardTurn ? hierarchy.up : hierarchy.down;
+        const std::vector<std::uint64_t> &stallBegin = forwardTurn ? hierarchy.downBegin : hierarchy.upBegin;
+        const std::vector<Arc> &stallArcs = forwardTurn ? hierarchy.down : hierarchy.up;
+
+        auto [d, u] = self.queue.pop();
+        ++out.settled;
+        if (other.reached(u, stamp) && d + other.labels[u].dist < best) {
+            best = d + other.labels[u].dist;
+            meet = u;
+        }
+
+        // Stall on demand: a higher-ranked vertex with a shorter way down to
+        // u shows u's upward distance is below d, so no best route climbs on from it
+        bool stalled = false;
+        for (std::uint64_t a = stallBegin[u]; a < stallBegin[u + 1] && !stalled; ++a) {
+            const Vertex x = stallArcs[a].head;
+            stalled = self.reached(x, stamp) && self.labels[x].dist + stallArcs[a].weight < d;
+        }
+        if (stalled) continue;
+
+        if (steps) steps->push(StepKind::Processing, u, CsrGraph::npos, d);
+        for (std::uint64_t a = begin[u]; a < begin[u + 1]; ++a) {
+            const Vertex x = arcs[a].head;
+            const long long candidate = d + arcs[a].weight;
+            if (self.reached(x, stamp) && candidate >= self.labels[x].dist) continue;
+            reach(self, x, candidate, u, a);
+            if (steps) steps->push(StepKind::DistanceUpdate, x, u, candidate);
+        }
+    }
+
+    if (meet == CsrGraph::npos) return;
+    out.distance = best;
+
+    // source up to meet: walk the forward preds back, then unpack in order
+    std::vector<Vertex> climb;
+    for (Vertex v = meet; v != CsrGraph::npos; v = forward.labels[v].pred) climb.push_back(v);
+    out.path.push_back(source);
+    for (std::size_t i = climb.size() - 1; i-- > 0;) {
+        const Label &label = forward.labels[climb[i]];
+        hierarchy.unpack(label.pred, climb[i], hierarchy.up[label.predArc].middle, out.path);
+    }
+    // meet down to target: backward preds already point that way
+    for (Vertex v = meet; backward.labels[v].pred != CsrGraph::npos; v = backward.labels[v].pred) {
+        const Label &label = backward.labels[v];
+        hierarchy.unpack(v, label.pred, hierarchy.down[label.predArc].middle, out.path);
+    }
+}
+
+void ContractionHierarchy::route(Vertex source, Vertex target, Route &out, StepLog *steps) const {
+    Query query(*this);
+    query.route(source, target, out, steps);
+}
+
+void ContractionHierarchy::unpack(Vertex from, Vertex to, Vertex middle, std::vector<Vertex> &path) const {
+    struct Piece {
+        Vertex from, to, middle;
+    };
+    std::vector<Piece> pending{{from, to, middle}};
+    while (!pending.empty()) {
+        const Piece piece = pending.back();
+        pending.pop_back();
+        if (piece.middle == CsrGraph::npos) {
+            path.push_back(piece.to);
+            continue;
+        }
+        // middle was contracted before both ends: from -> middle is one of
+        // its down arcs, middle -> to one of its up arcs
+        const Vertex m = piece.middle;
+        Vertex firstMiddle = CsrGraph::npos, secondMiddle = CsrGraph::npos;
+        for (std::uint64_t a = downBegin[m]; a < downBegin[m + 1]; ++a)
+            if (down[a].head == piece.from) firstMiddle = down[a].middle;
+        for (std::uint64_t a = upBegin[m]; a < upBegin[m + 1]; ++a)
+            if (up[a].head == piece.to) secondMiddle = up[a].middle;
+        pending.push_back({m, piece.to, secondMiddle});
+        pending.push_back({piece.from, m, firstMiddle});
+    }
+}
+
+// ---- Index file ----
+namespace {
+const char HierarchyMagic[9] = "YGGCH\0\0\0";
+constexpr std::uint32_t HierarchyVersion = 1;
+}
+
+bool ContractionHierarchy::save(std::ostream &out) const {
+    writeIndexHeader(out, HierarchyMagic, HierarchyVersion, fingerprint);
+    writeIndexArray(out, std::vector<std::uint64_t>{core});
+    writeIndexArray(out, rank);
+    writeIndexArray(out, upBegin);
+    writeIndexArray(out, up);
+    writeIndexArray(out, downBegin);
+    writeIndexArray(out, down);
+    return (bool)out;
+}
+
+bool ContractionHierarchy::load(std::istream &in, const CsrGraph &graph, std::string *error) {
+    *this = ContractionHierarchy();
+    if (!readIndexHeader(in, HierarchyMagic, HierarchyVersion, graph, error)) return false;
+
+    const std::size_t n = graph.vertexCount();
+    const std::uint64_t maxArcs = std::numeric_limits<std::uint32_t>::max();
+    ContractionHierarchy loaded;
+    std::vector<std::uint64_t> core;
+    bool ok = readIndexArray(in, core, 1) && core.size() == 1 && core[0] <= n &&
+              readIndexArray(in, loaded.rank, n) && readIndexArray(in, loaded.upBegin, n + 1) &&
+              readIndexArray(in, loaded.up, maxArcs) && readIndexArray(in, loaded.downBegin, n + 1) &&
+              readIndexArray(in, loaded.down, maxArcs);
+
+    // Sizes and ids must hold up before any query indexes with them
+    auto validArcs = [&](const std::vector<std::uint64_t> &begin, const std::vector<Arc> &arcs) {
+        if (begin.size() != n + 1 || begin[0] != 0 || begin[n] != arcs.size()) return false;
+        for (std::size_t v = 0; v < n; ++v)
+            if (begin[v] > begin[v + 1]) return false;
+        for (const Arc &a : arcs)
+            if (a.head >= n || (a.middle >= n && a.middle != CsrGraph::npos)) return false;
+        return true;
+    };
+    ok = ok && loaded.rank.size() == n && validArcs(loaded.upBegin, loaded.up) &&
+         validArcs(loaded.downBegin, loaded.down);
+    if (!ok) {
+        if (error) *error = "index file is damaged";
+        return false;
+    }
+
+    loaded.core = (std::size_t)core[0];
+    loaded.shortcuts = loaded.countShortcuts();
+    loaded.fingerprint = graphFingerprint(graph);
+    *this = std::move(loaded);
+    return true;
+}
@@ -0,0 +1,115 @@
+#ifndef CONTRACTIONHIERARCHY_HPP
+#define CONTRACTIONHIERARCHY_HPP
+
+#include "Algorithms.hpp"
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Contraction hierarchy (Geisberger, Sanders, Schultes & Delling,
+// "Contraction Hierarchies: Faster and Simpler Hierarchical Routing in Road
+// Networks") over a frozen CsrGraph with non-negative weights.
+//
+// build() removes the vertices one at a time, cheapest first (shortcuts
+// added minus arcs removed, plus contracted neighbours), and inserts a
+// shortcut u -> x of weight w(u, v) + w(v, x) whenever a bounded local
+// search finds no path at least as short that avoids the removed vertex v.
+// A query then only climbs: Dijkstra from the source over arcs to higher-
+// ranked vertices and from the target over reversed arcs from higher-ranked
+// ones settle a few hundred vertices even on millions, and shortcuts are
+// unpacked into the original arcs afterwards.
+//
+// That holds for graphs with some locality (road networks, grids, random
+// geometric graphs). On random and power-law graphs every contraction adds
+// shortcuts faster than it removes arcs; once the vertices left average
+// more than a fixed number of links, contraction stops and they stay an
+// uncontracted core that queries search like plain bidirectional Dijkstra.
+// There the landmark index (Landmarks.hpp) is the better choice.
+//
+// The hierarchy only refers to vertex ids; it belongs to the graph it was
+// built from (see graphFingerprint()) and must be rebuilt once that changes.
+class ContractionHierarchy {
+public:
+    using Vertex = CsrGraph::Vertex;
+
+    // Contract every vertex of graph. False if cancelled, or (with error) if
+    // a weight is negative; the hierarchy is left empty then.
+    bool build(const CsrGraph &graph, RunControl *control = nullptr, std::string *error = nullptr);
+
+    bool empty() const { return rank.empty(); }
+    std::size_t vertexCount() const { return rank.size(); }
+    std::size_t shortcutCount() const { return shortcuts; }
+    std::size_t coreSize() const { return core; }
+
+    // Reusable search state for queries on one hierarchy; each query only
+    // touches what it visits. Not shared between threads.
+    class Query {
+    public:
+        explicit Query(const ContractionHierarchy &hierarchy);
+
+        // Shortest route from source to target, the same length
+        // shortestRoute() finds. out.settled counts the vertices both
+        // upward searches settled. With a StepLog it records a Processing
+        // step per settled vertex and a DistanceUpdate step per lowered
+        // distance (without an arc: shortcuts have none).
+        void route(Vertex source, Vertex target, Route &out, StepLog *steps = nullptr);
+
+    private:
+        // Everything a search keeps per vertex, side by side in memory;
+        // valid where seen == the query's stamp
+        struct Label {
+            long long dist;
+            std::uint32_t seen;
+            Vertex pred;
+            std::uint32_t predArc;
+        };
+
+        struct Side {
+            std::vector<Label> labels;
+            QuadHeap<long long> queue;
+
+            explicit Side(std::size_t n);
+            bool reached(Vertex v, std::uint32_t stamp) const { return labels[v].seen == stamp; }
+        };
+
+        const ContractionHierarchy &hierarchy;
+        Side forward, backward;
+        std::uint32_t stamp = 0;
+    };
+
+    // One-off query (allocates a Query)
+    void route(Vertex source, Vertex target, Route &out, StepLog *steps = nullptr) const;
+
+    // Binary index file (see IndexFile.hpp); load() checks that it was
+    // written for `graph` and leaves the hierarchy empty otherwise
+    bool save(std::ostream &out) const;
+    bool load(std::istream &in, const CsrGraph &graph, std::string *error = nullptr);
+
+private:
+    // Arc of the upward / downward graph. Shortcuts name the vertex they
+    // skip, original arcs have middle == npos.
+    struct Arc {
+        long long weight;
+        Vertex head;   // up: arc v -> head; down: arc head -> v
+        Vertex middle;
+    };
+
+    std::uint64_t fingerprint = 0;      // of the graph it was built from
+    std::size_t shortcuts = 0;
+    std::size_t core = 0;               // vertices left uncontracted, ranked last
+    std::vector<std::uint32_t> rank;   // contraction order
+    std::vector<std::uint64_t> upBegin; // vertexCount() + 1 entries
+    std::vector<Arc> up;                // arcs to higher-ranked vertices
+    std::vector<std::uint64_t> downBegin;
+    std::vector<Arc> down;              // arcs from higher-ranked vertices, reversed
+
+    std::size_t countShortcuts() const;
+
+    // Append the original vertices after `from` on the arc from -> to that
+    // skips `middle` (npos: an original arc, just `to`)
+    void unpack(Vertex from, Vertex to, Vertex middle, std::vector<Vertex> &path) const;
+};
+
+#endif // CONTRACTIONHIERARCHY_HPP
@@ -0,0 +1,83 @@
+#include "CsrGraph.hpp"
+#include <utility>
+
+CsrGraph::CsrGraph(const Graph &graph) {
+    names = graph.nodes();
+    ids.reserve(names.size());
+    for (Vertex v = 0; v < (Vertex)names.size(); ++v) ids[names[v]] = v;
+
+    // One pass over the adjacency lists builds the arc arrays and the
+    // deduplicated edge list used by edge-centric algorithms (Bellman-Ford,
+    // Kruskal, ...). The edge list keeps Graph::edges() order: directed
+    // edges as-is, undirected ones only where from <= to lexicographically.
+    offsets.reserve(names.size() + 1);
+    offsets.push_back(0);
+    for (Vertex v = 0; v < (Vertex)names.size(); ++v) {
+        for (const auto &e : graph.neighbors(v)) {
+            int w = e.weight.value_or(1);
+            if (e.directed || names[e.from] <= names[e.to]) {
+                edgeFrom.push_back(e.from);
+                edgeTo.push_back(e.to);
+                edgeWeights.push_back(w);
+                edgeIsDirected.push_back(e.directed ? 1 : 0);
+                edgeArcs.push_back((std::uint32_t)targets.size());
+            }
+            targets.push_back(e.to);
+            weights.push_back(w);
+        }
+        offsets.push_back(targets.size());
+    }
+}
+
+CsrGraph::CsrGraph(std::vector<std::string> nodeNames, Span<Vertex> from, Span<Vertex> to,
+                   Span<int> edgeWeightList, bool directed)
+    : names(std::move(nodeNames)) {
+    const std::size_t n = names.size();
+    ids.reserve(n);
+    for (Vertex v = 0; v < (Vertex)n; ++v) ids[names[v]] = v;
+
+    // Counting sort of the arcs by source; scattering in edge order keeps
+    // each vertex's arcs in the order Graph::addEdge would have stored them
+    offsets.assign(n + 1, 0);
+    for (std::size_t e = 0; e < from.size(); ++e) {
+        ++offsets[from[e] + 1];
+        if (!directed) ++offsets[to[e] + 1];
+    }
+    for (std::size_t v = 0; v < n; ++v) offsets[v + 1] += offsets[v];
+
+    targets.resize(offsets[n]);
+    weights.resize(offsets[n]);
+    std::vector<std::size_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (std::size_t e = 0; e < from.size(); ++e) {
+        std::size_t arc = cursor[from[e]]++;
+        targets[arc] = to[e];
+        weights[arc] = edgeWeightList[e];
+        if (!directed) {
+            arc = cursor[to[e]]++;
+            targets[arc] = from[e];
+            weights[arc] = edgeWeightList[e];
+        }
+    }
+
+    // Edge list with the same rule as the Graph constructor
+    edgeFrom.reserve(from.size());
+    edgeTo.reserve(from.size());
+    edgeWeights.reserve(from.size());
+    edgeArcs.reserve(from.size());
+    for (Vertex v = 0; v < (Vertex)n; ++v) {
+        for (std::size_t arc = offsets[v]; arc < offsets[v + 1]; ++arc) {
+            if (directed || names[v] <= names[targets[arc]]) {
+                edgeFrom.push_back(v);
+                edgeTo.push_back(targets[arc]);
+                edgeWeights.push_back(weights[arc]);
+                edgeArcs.push_back((std::uint32_t)arc);
+            }
+        }
+    }
+    edgeIsDirected.assign(edgeFrom.size(), directed ? 1 : 0);
+}
+
+CsrGraph::Vertex CsrGraph::find(const std::string &name) const {
+    auto it = ids.find(name);
+    return it == ids.end() ? npos : it->second;
+}
@@ -0,0 +1,64 @@
+#ifndef CSRGRAPH_HPP
+#define CSRGRAPH_HPP
+
+#include "Graph.hpp"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// CsrGraph: frozen compressed-sparse-row snapshot of a Graph.
+// Vertex ids are the Graph's interned NodeIds, the arcs of
+// vertex v live in [arcBegin(v), arcEnd(v)) of the target/weight arrays,
+// in the same order Graph::neighbors() returns them.
+// Algorithms run against this so traversal is a sequential array scan.
+class CsrGraph {
+public:
+    using Vertex = NodeId;
+    static constexpr Vertex npos = InvalidNode;
+
+    CsrGraph() = default;
+    explicit CsrGraph(const Graph &graph);
+
+    // Build directly from an edge list over vertices 0..names.size()-1, as if
+    // every edge had been added to a Graph in order (generated graphs)
+    CsrGraph(std::vector<std::string> names, Span<Vertex> from, Span<Vertex> to,
+             Span<int> weights, bool directed);
+
+    std::size_t vertexCount() const { return names.size(); }
+    std::size_t arcCount() const { return targets.size(); }
+
+    // Vertex id for a node name, or npos if the node does not exist
+    Vertex find(const std::string &name) const;
+    const std::string &name(Vertex v) const { return names[v]; }
+    const std::vector<std::string> &nodes() const { return names; } // indexed by Vertex
+
+    // Outgoing arcs (undirected edges appear once per endpoint)
+    std::size_t arcBegin(Vertex v) const { return offsets[v]; }
+    std::size_t arcEnd(Vertex v) const { return offsets[v + 1]; }
+    Vertex target(std::size_t arc) const { return targets[arc]; }
+    int weight(std::size_t arc) const { return weights[arc]; } // unweighted -> 1
+
+    // Edge list in Graph::edges() order (undirected edges listed once)
+    std::size_t edgeCount() const { return edgeFrom.size(); }
+    Vertex edgeSource(std::size_t e) const { return edgeFrom[e]; }
+    Vertex edgeTarget(std::size_t e) const { return edgeTo[e]; }
+    int edgeWeight(std::size_t e) const { return edgeWeights[e]; }
+    bool edgeDirected(std::size_t e) const { return edgeIsDirected[e] != 0; }
+    std::size_t edgeArc(std::size_t e) const { return edgeArcs[e]; } // arc this entry came from
+
+private:
+    std::vector<std::string> names;
+    std::unordered_map<std::string, Vertex> ids;
+
+    std::vector<std::size_t> offsets; // vertexCount() + 1 entries
+    std::vector<Vertex> targets;
+    std::vector<int> weights;
+
+    std::vector<Vertex> edgeFrom;
+    std::vector<Vertex> edgeTo;
+    std::vector<int> edgeWeights;
+    std::vector<char> edgeIsDirected;
+    std::vector<std::uint32_t> edgeArcs;
+};
+
+#endif // CSRGRAPH_HPP
@@ -0,0 +1,231 @@
+#include "DeltaStepping.hpp"
+#include "BellmanFord.hpp"
+#include "Parallel.hpp"
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <utility>
+
+namespace {
+
+using Vertex = CsrGraph::Vertex;
+
+// Queued vertex with the distance it was queued at. Distances only go
+// down, so an entry whose vertex has been lowered since is stale.
+struct Entry {
+    long long dist;
+    Vertex vertex;
+};
+
+// Entries per work item of a round, and arcs per chunk of the weight scan
+constexpr std::size_t EntryChunk = 256;
+constexpr std::size_t ArcChunk = 1 << 16;
+
+// Most buckets one relaxation may jump ahead; it sizes the ring of buckets
+// every worker keeps, so weight ranges wider than this get a wider delta
+constexpr long long MaxSpan = 1024;
+
+} // namespace
+
+bool ssspDeltaStepping(const CsrGraph &graph, Vertex source, PathDistances &out, long long delta,
+                       RunControl *control, unsigned threads, StepLog *steps) {
+    const std::size_t n = graph.vertexCount();
+    std::vector<long long> &dist = out.dist;
+    dist.assign(n, PathDistances::Unreachable);
+    out.negativeCycle = false;
+    if (source >= n) return true;
+
+    // Weight range, in fixed chunks
+    const std::size_t arcChunks = (graph.arcCount() + ArcChunk - 1) / ArcChunk;
+    std::vector<std::pair<int, int>> ranges(arcChunks);
+    parallelChunks(graph.arcCount(), ArcChunk, steps ? 1 : threads, [&](std::size_t c, std::size_t begin, std::size_t end) {
+        int lo = graph.weight(begin), hi = lo;
+        for (std::size_t a = begin + 1; a < end; ++a) {
+            lo = std::min(lo, graph.weight(a));
+            hi = std::max(hi, graph.weight(a));
+        }
+        ranges[c] = {lo, hi};
+    });
+    int minWeight = 0, maxWeight = 0;
+    for (const auto &range : ranges) {
+        minWeight = std::min(minWeight, range.first);
+        maxWeight = std::max(maxWeight, range.second);
+    }
+    if (minWeight < 0) {
+        ShortestPathTree tree;
+        if (!ssspBellmanFord(graph, source, tree, control, steps)) return false;
+        dist = std::move(tree.dist);
+        out.negativeCycle = tree.negativeCycle;
+        return true;
+    }
+
+    // Meyer & Sanders' choice for random weights: max weight / average degree
+    if (delta <= 0)
+        delta = graph.arcCount() ? (long long)std::ceil((double)maxWeight * n / graph.arcCount()) : 1;
+    delta = std::max({delta, 1LL, (maxWeight + MaxSpan - 1) / MaxSpan});
+    // Buckets a relaxation from the current one can reach, current included
+    const std::size_t ring = (std::size_t)(maxWeight / delta) + 2;
+    const bool heavyArcs = maxWeight > delta;
+
+    // Small graphs are not worth starting a team for
+    const unsigned workers = steps || graph.arcCount() <= ArcChunk ? 1 : resolveThreads(threads);
+
+    std::unique_ptr<std::atomic<long long>[]> tentative(new std::atomic<long long>[n]);
+    parallelChunks(n, ArcChunk, workers, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t v = begin; v < end; ++v) tentative[v].store(PathDistances::Unreachable, std::memory_order_relaxed);
+    });
+
+    // Each worker queues what it lowers into its own ring of buckets
+    // (bucket b at b % ring) and keeps the entries it took from the
+    // current bucket for the heavy arcs
+    struct alignas(64) Worker {
+        std::vector<std::vector<Entry>> buckets;
+        std::vector<Entry> taken;
+        std::size_t settled = 0;
+    };
+    std::vector<Worker> local(workers);
+    for (Worker &self : local) self.buckets.resize(ring);
+
+    auto relax = [&](Worker &self, Vertex u, long long d, bool heavy) {
+        for (std::size_t a = graph.arcBegin(u); a < graph.arcEnd(u); ++a) {
+            const long long w = graph.weight(a);
+            if ((w > delta) != heavy) continue;
+            const Vertex v = graph.target(a);
+            const long long nd = d + w;
+            long long current = tentative[v].load(std::memory_order_relaxed);
+            while (nd < current) {
+                if (!tentative[v].compare_exchange_weak(current, nd, std::memory_order_relaxed)) continue;
+                self.buckets[(std::size_t)(nd / delta) % ring].push_back({nd, v});
+                if (steps) steps->push(StepKind::DistanceUpdate, v, u, nd, (std::uint32_t)a);
+                break;
+            }
+        }
+    };
+
+    auto isCurrent = [&](const Entry &e) { return tentative[e.vertex].load(std::memory_order_relaxed) == e.dist; };
+
+    // Light round: relax the light arcs of the current bucket's entries
+    auto light = [&](Worker &self, const Entry *begin, const Entry *end) {
+        for (const Entry *e = begin; e != end; ++e) {
+            if (!isCurrent(*e)) continue;
+            if (steps) steps->push(StepKind::Processing, e->vertex, CsrGraph::npos, e->dist);
+            self.taken.push_back(*e);
+            relax(self, e->vertex, e->dist, false);
+        }
+    };
+
+    // Heavy round: every vertex the bucket settled, once, at its final distance
+    auto heavy = [&](Worker &self, const Entry *begin, const Entry *end) {
+        for (const Entry *e = begin; e != end; ++e) {
+            if (!isCurrent(*e)) continue;
+            ++self.settled;
+            if (heavyArcs) relax(self, e->vertex, e->dist, true);
+        }
+    };
+
+    // A round hands out `work` in chunks to whoever asks next. Rounds of
+    // one chunk or less run on the coordinator while the team sleeps.
+    enum class Job { Light, Heavy, Done };
+    Job job = Job::Done;
+    std::vector<Entry> work;
+    std::atomic<std::size_t> cursor{0};
+    Barrier barrier(workers);
+
+    auto share = [&](Worker &self) {
+        for (;;) {
+            const std::size_t begin = cursor.fetch_add(EntryChunk, std::memory_order_relaxed);
+            if (begin >= work.size()) return;
+            const std::size_t end = std::min(begin + EntryChunk, work.size());
+            if (job == Job::Light) light(self, work.data() + begin, work.data() + end);
+            else heavy(self, work.data() + begin, work.data() + end);
+        }
+    };
+
+    auto round = [&](Job kind) {
+        if (workers == 1 || work.size() <= EntryChunk) {
+            const Entry *begin = work.data(), *end = begin + work.size();
+            if (kind == Job::Light) light(local[0], begin, end);
+            else heavy(local[0], begin, end);
+            return;
+        }
+        job = kind;
+        cursor.store(0, std::memory_order_relaxed);
+        barrier.wait(); // wake the team
+        share(local[0]);
+        barrier.wait(); // everyone finished
+    };
+
+    // Move every worker's list into `work`; the first non-empty one is
+    // swapped in, so a round fed by a single worker copies nothing
+    auto gather = [&](auto listOf) {
+        work.clear();
+        for (Worker &self : local) {
+            std::vector<Entry> &entries = listOf(self);
+            if (work.empty()) {
+                std::swap(work, entries);
+                continue;
+            }
+            work.insert(work.end(), entries.begin(), entries.end());
+            entries.clear();
+        }
+    };
+    auto collectBucket = [&](std::size_t bucket) {
+        gather([&](Worker &self) -> std::vector<Entry> & { return self.buckets[bucket % ring]; });
+    };
+    auto collectTaken = [&] {
+        gather([](Worker &self) -> std::vector<Entry> & { return self.taken; });
+    };
+
+    auto coordinate = [&] {
+        tentative[source].store(0, std::memory_order_relaxed);
+        local[0].buckets[0].push_back({0, source});
+
+        std::size_t current = 0, settled = 0;
+        for (;;) {
+            if (control) {
+                if (control->isCancelled()) return false;
+                control->report(settled, n);
+            }
+
+            // Light rounds until the bucket stays empty, then heavy arcs
+            for (collectBucket(current); !work.empty(); collectBucket(current)) round(Job::Light);
+            collectTaken();
+            round(Job::Heavy);
+            for (Worker &self : local) {
+                settled += self.settled;
+                self.settled = 0;
+            }
+
+            // Next non-empty bucket, at most ring - 1 ahead
+            std::size_t next = current;
+            for (std::size_t ahead = 1; ahead < ring && next == current; ++ahead)
+                for (const Worker &self : local)
+                    if (!self.buckets[(current + ahead) % ring].empty()) next = current + ahead;
+            if (next == current) return true;
+            current = next;
+        }
+    };
+
+    bool finished = true;
+    parallelTeam(workers, [&](unsigned w) {
+        if (w == 0) {
+            finished = coordinate();
+            if (workers > 1) {
+                job = Job::Done;
+                barrier.wait();
+            }
+            return;
+        }
+        for (;;) {
+            barrier.wait();
+            if (job == Job::Done) return;
+            share(local[w]);
+            barrier.wait();
+        }
+    });
+
+    parallelChunks(n, ArcChunk, workers, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t v = begin; v < end; ++v) dist[v] = tentative[v].load(std::memory_order_relaxed);
+    });
+    return finished;
+}
@@ -0,0 +1,26 @@
+#ifndef DELTASTEPPING_HPP
+#define DELTASTEPPING_HPP
+
+#include "Algorithms.hpp"
+#include <vector>
+
+// Delta-stepping single-source shortest paths behind shortestDistances()
+// (Meyer & Sanders, "Delta-stepping: a parallelizable shortest path
+// algorithm"). Tentative distances are kept in buckets `delta` wide; the
+// lowest bucket is emptied by rounds that relax light arcs (weight <= delta)
+// of its vertices in parallel, then the heavy arcs of everything settled
+// in it are relaxed once. Rounds run on `threads` workers (0 = all cores);
+// rounds of one chunk or less stay on the calling thread.
+//
+// out.dist[v] is the shortest distance from source (PathDistances::Unreachable
+// if none), the same values dijkstra() settles. delta = 0 picks the bucket
+// width from the arc weights. Graphs with a negative arc are handed to
+// ssspBellmanFord() (BellmanFord.hpp), which stops at a reachable negative
+// cycle (out.negativeCycle).
+// With a StepLog the run stays on the calling thread and records a
+// Processing step per vertex taken from a bucket and a DistanceUpdate step
+// per lowered distance. Returns false if cancelled.
+bool ssspDeltaStepping(const CsrGraph &graph, CsrGraph::Vertex source, PathDistances &out, long long delta,
+                       RunControl *control, unsigned threads = 0, StepLog *steps = nullptr);
+
+#endif // DELTASTEPPING_HPP
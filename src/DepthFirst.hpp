@@ -0,0 +1,102 @@
+#ifndef DEPTHFIRST_HPP
+#define DEPTHFIRST_HPP
+
+#include "CsrGraph.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Iterative depth-first search over a CsrGraph. The recursion lives on an
+// explicit stack of (vertex, next arc) frames, so a 10M-vertex path costs
+// heap memory instead of overflowing the thread stack. Arcs are followed
+// in CSR order, giving the same visit order as the recursive version.
+//
+// The visited bitmap and the stack are allocated once and kept between
+// searches; reset() clears the visited set for another pass.
+//
+// Visitors provide (see DfsVisitor for the defaults):
+//   bool discover(Vertex v)                         pre-order; false stops the search
+//   bool examine(Vertex from, std::size_t arc, Vertex to)
+//                                                   arc to an already visited vertex;
+//                                                   false stops the search
+//   void finish(Vertex v)                           post-order
+// A stopped search leaves the stack as it was, so the visitor can still
+// read it; the next search() starts from an empty stack.
+class DepthFirstSearch {
+public:
+    using Vertex = CsrGraph::Vertex;
+
+    struct Frame {
+        Vertex vertex;
+        std::size_t nextArc;
+    };
+
+    explicit DepthFirstSearch(const CsrGraph &graph)
+        : graph(graph), visitedBits((graph.vertexCount() + 63) / 64, 0) {}
+
+    void reset() {
+        std::fill(visitedBits.begin(), visitedBits.end(), 0);
+        frames.clear();
+    }
+
+    bool isVisited(Vertex v) const { return (visitedBits[v >> 6] >> (v & 63)) & 1; }
+    // Mark v visited without searching from it: later searches treat it
+    // like a vertex an earlier search finished
+    void exclude(Vertex v) { markVisited(v); }
+
+    // Current path from the search root (bottom) to the vertex being expanded (top)
+    std::size_t depth() const { return frames.size(); }
+    Vertex pathVertex(std::size_t i) const { return frames[i].vertex; }
+    // Vertex the top of the stack was reached from (npos at the root)
+    Vertex parent() const { return frames.size() > 1 ? frames[frames.size() - 2].vertex : CsrGraph::npos; }
+
+    // Visit everything reachable from root; false if the visitor stopped the search
+    template <typename Visitor>
+    bool search(Vertex root, Visitor &visitor) {
+        frames.clear();
+        if (isVisited(root)) return true;
+        markVisited(root);
+        frames.push_back({root, graph.arcBegin(root)});
+        if (!visitor.discover(root)) return false;
+
+        while (!frames.empty()) {
+            Frame &top = frames.back();
+            if (top.nextArc == graph.arcEnd(top.vertex)) {
+                const Vertex done = top.vertex;
+                frames.pop_back();
+                visitor.finish(done);
+                continue;
+            }
+
+            const std::size_t arc = top.nextArc++;
+            const Vertex from = top.vertex;
+            const Vertex to = graph.target(arc);
+            if (isVisited(to)) {
+                if (!visitor.examine(from, arc, to)) return false;
+                continue;
+            }
+            markVisited(to);
+            frames.push_back({to, graph.arcBegin(to)}); // may move `top`
+            if (!visitor.discover(to)) return false;
+        }
+        return true;
+    }
+
+private:
+    void markVisited(Vertex v) { visitedBits[v >> 6] |= std::uint64_t(1) << (v & 63); }
+
+    const CsrGraph &graph;
+    std::vector<std::uint64_t> visitedBits;
+    std::vector<Frame> frames;
+};
+
+// No-op hooks to derive visitors from
+struct DfsVisitor {
+    using Vertex = CsrGraph::Vertex;
+
+    bool discover(Vertex) { return true; }
+    bool examine(Vertex, std::size_t, Vertex) { return true; }
+    void finish(Vertex) {}
+};
+
+#endif // DEPTHFIRST_HPP
@@ -0,0 +1,164 @@
+#include "EdgeLayer.hpp"
+
+#include <QPainter>
+#include <QPen>
+#include <QPolygonF>
+#include <QStyleOptionGraphicsItem>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr double PlainWidth = 2;
+constexpr double ArrowSize = 12;   // arrowhead length
+constexpr double ArrowZoom = 0.3;  // arrowheads from this scale on (about 4px long)
+constexpr double Margin = ArrowSize; // how far an arrowhead reaches beyond its line's box
+
+} // namespace
+
+EdgeLayer::EdgeLayer(const NodeLayer *nodes) : nodes(nodes) {
+    setFlag(ItemUsesExtendedStyleOption); // paint() gets the exposed rectangle
+    styles.push_back({Qt::black, PlainWidth});
+}
+
+void EdgeLayer::clear() {
+    prepareGeometryChange();
+    source.clear();
+    target.clear();
+    arrow.clear();
+    style.clear();
+    styles.resize(1);
+    bounds = QRectF();
+    grid.clear();
+    indexed = false;
+}
+
+std::size_t EdgeLayer::add(NodeId from, NodeId to, bool directed) {
+    source.push_back(from);
+    target.push_back(to);
+    arrow.push_back(directed ? 1 : 0);
+    style.push_back(0);
+    indexed = false;
+
+    const QRectF rect = edgeRect(source.size() - 1);
+    if (!bounds.contains(rect)) {
+        prepareGeometryChange();
+        bounds = bounds.isNull() ? rect : bounds.united(rect);
+    }
+    update(rect);
+    return source.size() - 1;
+}
+
+void EdgeLayer::remove(std::size_t i) {
+    update(edgeRect(i));
+    const std::size_t last = source.size() - 1;
+    source[i] = source[last];
+    target[i] = target[last];
+    arrow[i] = arrow[last];
+    style[i] = style[last];
+    source.pop_back();
+    target.pop_back();
+    arrow.pop_back();
+    style.pop_back();
+    indexed = false;
+}
+
+void EdgeLayer::setStyle(std::size_t i, const QColor &color, double width) {
+    style[i] = styleIndex(color, width);
+    update(edgeRect(i));
+}
+
+void EdgeLayer::resetStyles(const QColor &color) {
+    styles.assign(1, {color, PlainWidth});
+    std::fill(style.begin(), style.end(), 0);
+    update();
+}
+
+std::uint16_t EdgeLayer::styleIndex(const QColor &color, double width) {
+    for (std::size_t s = 0; s < styles.size(); ++s)
+        if (styles[s].color == color && styles[s].width == width) return (std::uint16_t)s;
+    if (styles.size() > UINT16_MAX) return 0; // palette full: plain
+    styles.push_back({color, width});
+    return (std::uint16_t)(styles.size() - 1);
+}
+
+void EdgeLayer::nodesMoved() {
+    prepareGeometryChange();
+    bounds = QRectF();
+    for (std::size_t i = 0; i < source.size(); ++i)
+        bounds = bounds.isNull() ? edgeRect(i) : bounds.united(edgeRect(i));
+    indexed = false;
+    update();
+}
+
+QRectF EdgeLayer::boundingRect() const {
+    return bounds;
+}
+
+QRectF EdgeLayer::edgeRect(std::size_t i) const {
+    const QPointF a = nodes->positionOf(source[i]), b = nodes->positionOf(target[i]);
+    return QRectF(std::min(a.x(), b.x()) - Margin, std::min(a.y(), b.y()) - Margin,
+                  std::abs(a.x() - b.x()) + 2 * Margin, std::abs(a.y() - b.y()) + 2 * Margin);
+}
+
+void EdgeLayer::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *) {
+    if (source.empty()) return;
+    if (!indexed) {
+        std::vector<SpatialGrid::Box> boxes(source.size());
+        for (std::size_t i = 0; i < source.size(); ++i) {
+            const QPointF a = nodes->positionOf(source[i]), b = nodes->positionOf(target[i]);
+            boxes[i] = {std::min(a.x(), b.x()), std::min(a.y(), b.y()), std::max(a.x(), b.x()), std::max(a.y(), b.y())};
+        }
+        grid.build(boxes);
+        indexed = true;
+    }
+
+    // Edges whose box (arrowhead included) meets the exposed rectangle,
+    // bucketed by style
+    const QRectF exposed = option->exposedRect;
+    const SpatialGrid::Box area{exposed.left() - Margin, exposed.top() - Margin, exposed.right() + Margin,
+                                exposed.bottom() + Margin};
+    std::vector<std::vector<std::uint32_t>> visible(styles.size());
+    grid.query(area, [&](std::uint32_t i) {
+        const QPointF a = nodes->positionOf(source[i]), b = nodes->positionOf(target[i]);
+        if (std::max(a.x(), b.x()) < area.minX || std::min(a.x(), b.x()) > area.maxX ||
+            std::max(a.y(), b.y()) < area.minY || std::min(a.y(), b.y()) > area.maxY)
+            return;
+        visible[style[i]].push_back(i);
+    });
+
+    const double lod = option->levelOfDetailFromTransform(painter->worldTransform());
+    const bool arrows = lod >= ArrowZoom;
+    std::vector<QLineF> lines;
+    for (std::size_t s = 0; s < styles.size(); ++s) {
+        if (visible[s].empty()) continue;
+        QPen pen(styles[s].color, styles[s].width);
+        if (styles[s].width * lod < 1) pen.setWidthF(0); // hairline: thinner than a pixel anyway, and faster
+        painter->setPen(pen);
+
+        lines.clear();
+        for (std::uint32_t i : visible[s]) lines.emplace_back(nodes->positionOf(source[i]), nodes->positionOf(target[i]));
+        painter->drawLines(lines.data(), (int)lines.size());
+
+        if (!arrows) continue;
+        painter->setBrush(styles[s].color);
+        painter->setPen(QPen(styles[s].color));
+        for (std::uint32_t i : visible[s]) {
+            if (!arrow[i]) continue;
+            // triangle with its tip on the target node's centre
+            const QPointF p1 = nodes->positionOf(source[i]), p2 = nodes->positionOf(target[i]);
+            const QPointF vec = p1 - p2; // pointing from tip to base
+            double len = std::hypot(vec.x(), vec.y());
+            if (len < 1.0) len = 1.0;
+            const double ux = vec.x() / len, uy = vec.y() / len;
+            const double px = -uy, py = ux; // perpendicular
+
+            const QPointF head[3] = {
+                p2,
+                p2 + QPointF(ux * ArrowSize + px * (ArrowSize * 0.6), uy * ArrowSize + py * (ArrowSize * 0.6)),
+                p2 + QPointF(ux * ArrowSize - px * (ArrowSize * 0.6), uy * ArrowSize - py * (ArrowSize * 0.6)),
+            };
+            painter->drawPolygon(head, 3);
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef EDGELAYER_HPP
+#define EDGELAYER_HPP
+
+#include <QGraphicsItem>
+#include <QColor>
+#include <cstdint>
+#include <vector>
+
+#include "Graph.hpp"
+#include "NodeLayer.hpp"
+#include "SpatialGrid.hpp"
+
+// EdgeLayer: every edge of the graph in one scene item, as parallel
+// arrays (endpoints, direction, style index) instead of a line item and
+// an arrow item each. An edge is drawn between its nodes' current
+// positions in `nodes`, so moving the nodes moves the edges with them.
+//
+// Styles (colour and width) live in a small palette; highlighting an edge
+// only changes its index, and a theme change recolours style 0. paint()
+// collects the edges crossing the exposed rectangle (through a
+// SpatialGrid) per style and hands each style's lines to one drawLines()
+// call. Arrowheads are left out when zoomed far out.
+class EdgeLayer : public QGraphicsItem {
+public:
+    explicit EdgeLayer(const NodeLayer *nodes);
+
+    void clear();
+    // Append an edge between drawn nodes (its index is the previous size())
+    std::size_t add(NodeId from, NodeId to, bool directed);
+    // Remove edge i; the last edge takes its index
+    void remove(std::size_t i);
+    std::size_t size() const { return source.size(); }
+
+    NodeId from(std::size_t i) const { return source[i]; }
+    NodeId to(std::size_t i) const { return target[i]; }
+    bool directed(std::size_t i) const { return arrow[i] != 0; }
+
+    void setStyle(std::size_t i, const QColor &color, double width);
+    // Every edge back to the plain style, drawn in `color`
+    void resetStyles(const QColor &color);
+
+    // The nodes were moved: follow them
+    void nodesMoved();
+
+    QRectF boundingRect() const override;
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget = nullptr) override;
+
+private:
+    struct Style {
+        QColor color;
+        double width;
+    };
+
+    // Index of the palette entry (color, width), added if new
+    std::uint16_t styleIndex(const QColor &color, double width);
+    QRectF edgeRect(std::size_t i) const;
+
+    const NodeLayer *nodes;
+    std::vector<NodeId> source, target;
+    std::vector<std::uint8_t> arrow;  // 1 for directed edges
+    std::vector<std::uint16_t> style; // into styles
+    std::vector<Style> styles;        // [0]: the plain edge
+    QRectF bounds;
+
+    // rebuilt by the first paint() after edges or nodes changed
+    SpatialGrid grid;
+    bool indexed = false;
+};
+
+#endif // EDGELAYER_HPP
@@ -0,0 +1,317 @@
+#include "FloydWarshall.hpp"
+#include "IncomingArcs.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define FW_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+using ll = long long;
+constexpr ll INF = AllPairsPaths::Unreachable;
+
+// 32-bit distances are used when no shortest path can reach Inf32.
+// Candidates saturate at -Inf32, so the sum of any two entries fits in an
+// int32 even when negative cycles keep driving distances down.
+constexpr std::int32_t Inf32 = INT32_MAX / 2;
+
+template <typename T> constexpr T infinity();
+template <> constexpr ll infinity<ll>() { return INF; }
+template <> constexpr std::int32_t infinity<std::int32_t>() { return Inf32; }
+
+// 32 x 32 int64 tiles: three distance tiles plus two next-hop tiles are
+// 32 KB, which fits L1d on current x86 and ARM cores. 32-bit distances
+// use 64 x 64 so a tile row is still several full AVX-512 vectors.
+template <typename T>
+constexpr std::size_t TileSize = sizeof(T) == 4 ? 64 : 32;
+
+// rowI[j] = min(rowI[j], dik + rowK[j]) for j < count, with nextI[j] = hop
+// wherever the distance improved. Entries equal to infinity never relax.
+template <typename T>
+using RowKernel = void (*)(T *rowI, NodeId *nextI, const T *rowK, T dik, NodeId hop, std::size_t count);
+
+// Branch-free so the compiler is free to vectorize it for the baseline ISA
+template <typename T>
+void relaxRowScalar(T *rowI, NodeId *nextI, const T *rowK, T dik, NodeId hop, std::size_t count) {
+    for (std::size_t j = 0; j < count; ++j) {
+        const T dkj = rowK[j];
+        const T candidate = std::max<T>(dik + dkj, -infinity<T>());
+        const bool better = (dkj != infinity<T>()) & (candidate < rowI[j]);
+        rowI[j] = better ? candidate : rowI[j];
+        nextI[j] = better ? hop : nextI[j];
+    }
+}
+
+#ifdef FW_X86_DISPATCH
+
+__attribute__((target("avx2")))
+void relaxRowAvx2(std::int32_t *rowI, NodeId *nextI, const std::int32_t *rowK, std::int32_t dik, NodeId hop,
+                  std::size_t count) {
+    const __m256i vdik = _mm256_set1_epi32(dik);
+    const __m256i vinf = _mm256_set1_epi32(Inf32);
+    const __m256i vfloor = _mm256_set1_epi32(-Inf32);
+    const __m256i vhop = _mm256_set1_epi32((int)hop);
+
+    std::size_t j = 0;
+    for (; j + 8 <= count; j += 8) {
+        const __m256i dkj = _mm256_loadu_si256((const __m256i *)(rowK + j));
+        const __m256i dij = _mm256_loadu_si256((const __m256i *)(rowI + j));
+        const __m256i candidate = _mm256_max_epi32(_mm256_add_epi32(vdik, dkj), vfloor);
+        const __m256i better = _mm256_andnot_si256(_mm256_cmpeq_epi32(dkj, vinf), _mm256_cmpgt_epi32(dij, candidate));
+        _mm256_storeu_si256((__m256i *)(rowI + j), _mm256_blendv_epi8(dij, candidate, better));
+        const __m256i nij = _mm256_loadu_si256((const __m256i *)(nextI + j));
+        _mm256_storeu_si256((__m256i *)(nextI + j), _mm256_blendv_epi8(nij, vhop, better));
+    }
+    relaxRowScalar<std::int32_t>(rowI + j, nextI + j, rowK + j, dik, hop, count - j);
+}
+
+__attribute__((target("avx512f")))
+void relaxRowAvx512(std::int32_t *rowI, NodeId *nextI, const std::int32_t *rowK, std::int32_t dik, NodeId hop,
+                    std::size_t count) {
+    const __m512i vdik = _mm512_set1_epi32(dik);
+    const __m512i vinf = _mm512_set1_epi32(Inf32);
+    const __m512i vfloor = _mm512_set1_epi32(-Inf32);
+    const __m512i vhop = _mm512_set1_epi32((int)hop);
+
+    std::size_t j = 0;
+    for (; j + 16 <= count; j += 16) {
+        const __m512i dkj = _mm512_loadu_si512(rowK + j);
+        const __m512i dij = _mm512_loadu_si512(rowI + j);
+        const __m512i candidate = _mm512_max_epi32(_mm512_add_epi32(vdik, dkj), vfloor);
+        const __mmask16 better = _mm512_mask_cmpgt_epi32_mask(_mm512_cmpneq_epi32_mask(dkj, vinf), dij, candidate);
+        _mm512_mask_storeu_epi32(rowI + j, better, candidate);
+        _mm512_mask_storeu_epi32(nextI + j, better, vhop);
+    }
+    if (j < count) {
+        // masked tail instead of a scalar loop
+        const __mmask16 tail = (__mmask16)((1u << (count - j)) - 1);
+        const __m512i dkj = _mm512_maskz_loadu_epi32(tail, rowK + j);
+        const __m512i dij = _mm512_maskz_loadu_epi32(tail, rowI + j);
+        const __m512i candidate = _mm512_max_epi32(_mm512_add_epi32(vdik, dkj), vfloor);
+        const __mmask16 better = _mm512_mask_cmpgt_epi32_mask(_mm512_mask_cmpneq_epi32_mask(tail, dkj, vinf), dij, candidate);
+        _mm512_mask_storeu_epi32(rowI + j, better, candidate);
+        _mm512_mask_storeu_epi32(nextI + j, better, vhop);
+    }
+}
+
+#endif // FW_X86_DISPATCH
+
+std::atomic<FwKernel> selectedKernel{FwKernel::Auto};
+
+FwKernel bestKernel() {
+#ifdef FW_X86_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return FwKernel::Avx512;
+    if (__builtin_cpu_supports("avx2")) return FwKernel::Avx2;
+#endif
+    return FwKernel::Scalar;
+}
+
+RowKernel<std::int32_t> int32Kernel() {
+    switch (fwActiveKernel()) {
+#ifdef FW_X86_DISPATCH
+    case FwKernel::Avx512: return relaxRowAvx512;
+    case FwKernel::Avx2: return relaxRowAvx2;
+#endif
+    default: return relaxRowScalar<std::int32_t>;
+    }
+}
+
+// Relax tile (I, J) through pivots K..K+TileSize (clipped to n)
+template <typename T>
+void relaxTile(std::size_t n, T *dist, NodeId *next, std::size_t I, std::size_t J, std::size_t K,
+               RowKernel<T> kernel) {
+    const std::size_t iEnd = std::min(n, I + TileSize<T>);
+    const std::size_t jEnd = std::min(n, J + TileSize<T>);
+    const std::size_t kEnd = std::min(n, K + TileSize<T>);
+
+    for (std::size_t k = K; k < kEnd; ++k) {
+        const T *rowK = dist + k * n;
+        for (std::size_t i = I; i < iEnd; ++i) {
+            T *rowI = dist + i * n;
+            const T dik = rowI[k];
+            if (dik == infinity<T>()) continue;
+            NodeId *nextI = next + i * n;
+            kernel(rowI + J, nextI + J, rowK + J, dik, nextI[k], jEnd - J);
+        }
+    }
+}
+
+// One K block at a time, each phase split across a team of workers with a
+// barrier in between. Tiles within a phase write disjoint cells and only
+// read the (already final) diagonal tile or panels, so the result does not
+// depend on the number of workers.
+template <typename T>
+bool blocked(std::size_t n, T *dist, NodeId *next, RunControl *control, RowKernel<T> kernel, unsigned threads) {
+    constexpr std::size_t B = TileSize<T>;
+    const std::size_t blocks = (n + B - 1) / B;
+    const unsigned workers = (unsigned)std::min<std::size_t>(resolveThreads(threads), std::max<std::size_t>(blocks, 1));
+    Barrier sync(workers);
+    bool stop = false; // written by worker 0 only, read after a barrier
+
+    parallelTeam(workers, [&](unsigned worker) {
+        for (std::size_t K = 0; K < n; K += B) {
+            // 1. the diagonal tile depends only on itself
+            if (worker == 0) {
+                stop = control && control->isCancelled();
+                if (control) control->report(K, n);
+                if (!stop) relaxTile(n, dist, next, K, K, K, kernel);
+            }
+            sync.wait();
+            if (stop) return;
+
+            // 2. pivot row and column panels depend on the diagonal tile
+            std::size_t panel = 0;
+            for (std::size_t J = 0; J < n; J += B)
+                if (J != K && panel++ % workers == worker) relaxTile(n, dist, next, K, J, K, kernel);
+            for (std::size_t I = 0; I < n; I += B)
+                if (I != K && panel++ % workers == worker) relaxTile(n, dist, next, I, K, K, kernel);
+            sync.wait();
+
+            // 3. every other tile depends on its row and column panel;
+            //    workers take whole block rows so the column panel tile stays hot
+            for (std::size_t I = worker * B; I < n; I += workers * B) {
+                if (I == K) continue;
+                for (std::size_t J = 0; J < n; J += B)
+                    if (J != K) relaxTile(n, dist, next, I, J, K, kernel);
+            }
+            sync.wait();
+        }
+    });
+    return !stop;
+}
+
+// A shortest path has at most n - 1 edges, so 32 bits are enough when
+// (n - 1) * max|w| stays below Inf32
+bool fitsInt32(std::size_t n, const ll *dist) {
+    unsigned long long maxWeight = 0;
+    for (std::size_t i = 0; i < n * n; ++i) {
+        if (dist[i] == INF) continue;
+        unsigned long long w = dist[i] < 0 ? 0ULL - (unsigned long long)dist[i] : (unsigned long long)dist[i];
+        if (w >= (unsigned long long)Inf32) return false;
+        maxWeight = std::max(maxWeight, w);
+    }
+    return n == 0 || maxWeight == 0 || (unsigned long long)(n - 1) < (unsigned long long)Inf32 / maxWeight;
+}
+
+// parallelChunks() granularity for the O(n^2) conversions and the diagonal scan
+constexpr std::size_t ConvertChunk = 1 << 18;
+constexpr std::size_t DiagonalChunk = 1 << 12;
+// targets per fwUntangleNext() chunk, each with its own BFS scratch
+constexpr std::size_t TargetChunk = 64;
+
+} // namespace
+
+const char *fwKernelName(FwKernel kernel) {
+    switch (kernel) {
+    case FwKernel::Auto: return "auto";
+    case FwKernel::Scalar: return "scalar";
+    case FwKernel::Avx2: return "avx2";
+    case FwKernel::Avx512: return "avx512";
+    }
+    return "?";
+}
+
+bool fwKernelSupported(FwKernel kernel) {
+    switch (kernel) {
+    case FwKernel::Auto:
+    case FwKernel::Scalar: return true;
+#ifdef FW_X86_DISPATCH
+    case FwKernel::Avx2: __builtin_cpu_init(); return __builtin_cpu_supports("avx2");
+    case FwKernel::Avx512: __builtin_cpu_init(); return __builtin_cpu_supports("avx512f");
+#endif
+    default: return false;
+    }
+}
+
+bool fwSelectKernel(FwKernel kernel) {
+    if (!fwKernelSupported(kernel)) return false;
+    selectedKernel = kernel;
+    return true;
+}
+
+FwKernel fwActiveKernel() {
+    static const FwKernel best = bestKernel();
+    FwKernel kernel = selectedKernel;
+    return kernel == FwKernel::Auto ? best : kernel;
+}
+
+void fwInitialize(const CsrGraph &graph, std::vector<long long> &dist, std::vector<NodeId> &next) {
+    const std::size_t n = graph.vertexCount();
+    dist.assign(n * n, INF);
+    next.assign(n * n, CsrGraph::npos);
+    for (std::size_t i = 0; i < n; ++i) dist[i * n + i] = 0;
+
+    for (std::size_t e = 0; e < graph.edgeCount(); ++e) {
+        std::size_t u = graph.edgeSource(e), v = graph.edgeTarget(e);
+        ll w = graph.edgeWeight(e);
+        if (dist[u * n + v] > w) { dist[u * n + v] = w; next[u * n + v] = (NodeId)v; }
+        if (!graph.edgeDirected(e) && dist[v * n + u] > w) { dist[v * n + u] = w; next[v * n + u] = (NodeId)u; }
+    }
+}
+
+bool fwBlocked(std::size_t n, long long *dist, NodeId *next, RunControl *control, unsigned threads) {
+    if (!fitsInt32(n, dist)) return blocked<ll>(n, dist, next, control, relaxRowScalar<ll>, threads);
+
+    // Narrow to 32 bits (twice the lanes per vector, half the cache
+    // footprint), run, and widen back
+    std::vector<std::int32_t> narrow(n * n);
+    parallelChunks(n * n, ConvertChunk, threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) narrow[i] = dist[i] == INF ? Inf32 : (std::int32_t)dist[i];
+    });
+    if (!blocked<std::int32_t>(n, narrow.data(), next, control, int32Kernel(), threads)) return false;
+    parallelChunks(n * n, ConvertChunk, threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) dist[i] = narrow[i] == Inf32 ? INF : narrow[i];
+    });
+    return true;
+}
+
+bool fwNegativeCycle(std::size_t n, const long long *dist, unsigned threads) {
+    std::atomic<bool> found{false};
+    parallelChunks(n, DiagonalChunk, threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end && !found.load(std::memory_order_relaxed); ++i)
+            if (dist[i * n + i] < 0) found = true;
+    });
+    return found;
+}
+
+void fwUntangleNext(const CsrGraph &graph, const long long *dist, NodeId *next, unsigned threads) {
+    const std::size_t n = graph.vertexCount();
+    std::atomic<bool> zeroCycle{false};
+    parallelChunks(n, DiagonalChunk, threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t u = begin; u < end && !zeroCycle.load(std::memory_order_relaxed); ++u)
+            for (std::size_t a = graph.arcBegin(u); a < graph.arcEnd(u); ++a) {
+                const std::size_t v = graph.target(a);
+                if (v != u && dist[v * n + u] != INF && graph.weight(a) + dist[v * n + u] == 0) zeroCycle = true;
+            }
+    });
+    if (!zeroCycle) return;
+
+    const IncomingArcs incoming(graph);
+    parallelChunks(n, TargetChunk, threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+        std::vector<std::uint32_t> seen(n, UINT32_MAX); // target that reached the vertex
+        std::vector<NodeId> queue;
+        queue.reserve(n);
+        for (std::size_t j = begin; j < end; ++j) {
+            queue.assign(1, (NodeId)j);
+            seen[j] = (std::uint32_t)j;
+            for (std::size_t head = 0; head < queue.size(); ++head) {
+                const NodeId v = queue[head];
+                for (std::size_t i = incoming.begin(v); i < incoming.end(v); ++i) {
+                    const NodeId u = incoming.source(i);
+                    if (seen[u] == j || dist[u * n + j] == INF ||
+                        incoming.weight(i) + dist[v * n + j] != dist[u * n + j])
+                        continue;
+                    seen[u] = (std::uint32_t)j;
+                    next[u * n + j] = v;
+                    queue.push_back(u);
+                }
+            }
+        }
+    });
+}
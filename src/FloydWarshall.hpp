@@ -0,0 +1,49 @@
+#ifndef FLOYDWARSHALL_HPP
+#define FLOYDWARSHALL_HPP
+
+#include "Algorithms.hpp"
+#include <vector>
+
+// Dense all-pairs kernels behind floydWarshall() and allPairsShortestPaths().
+// Matrices are n x n and row-major: dist[i * n + j], next[i * n + j].
+// Unreachable entries hold AllPairsPaths::Unreachable / CsrGraph::npos.
+
+// Seed the matrices from the graph: 0 on the diagonal, the lightest edge
+// between two vertices, Unreachable everywhere else
+void fwInitialize(const CsrGraph &graph, std::vector<long long> &dist, std::vector<NodeId> &next);
+
+// Three-phase blocked Floyd-Warshall (diagonal tile, row/column panels,
+// remaining tiles) over tiles that stay resident in L1.
+// Distances match the plain k-i-j loop; `next` describes a shortest path
+// as well but may pick a different one among equally short paths, and
+// may walk round a zero-weight cycle forever (see fwUntangleNext()).
+// When (n - 1) * max|weight| fits, the matrix is narrowed to 32-bit
+// distances for the duration and relaxed with the active SIMD kernel;
+// wider weights fall back to a branch-free 64-bit scalar loop.
+// Each phase is split across `threads` workers (0 = all cores); the result
+// is the same for any thread count. Returns false if cancelled.
+bool fwBlocked(std::size_t n, long long *dist, NodeId *next, RunControl *control, unsigned threads = 0);
+
+// Any negative entry on the diagonal, i.e. a negative cycle
+bool fwNegativeCycle(std::size_t n, const long long *dist, unsigned threads = 0);
+
+// On a zero-weight cycle every hop is as short as the path it starts, so
+// next hops chosen out of the k-i-j order can chase each other round it.
+// If the graph has such a cycle, rebuild `next` from the final distances:
+// each target's hops follow a BFS tree over the arcs on shortest paths,
+// which cannot loop. Needs dist without a negative cycle.
+void fwUntangleNext(const CsrGraph &graph, const long long *dist, NodeId *next, unsigned threads = 0);
+
+// ---- Min-plus row kernels ----
+// Auto picks the widest kernel the CPU supports at runtime; the others
+// can be forced for benchmarking and comparisons.
+enum class FwKernel { Auto, Scalar, Avx2, Avx512 };
+
+const char *fwKernelName(FwKernel kernel);
+bool fwKernelSupported(FwKernel kernel);
+// False (and the selection is left alone) if the CPU lacks the kernel
+bool fwSelectKernel(FwKernel kernel);
+// The kernel fwBlocked() uses now, with Auto resolved
+FwKernel fwActiveKernel();
+
+#endif // FLOYDWARSHALL_HPP
@@ -0,0 +1,422 @@
+#include "ForceLayout.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr double Repulsion = 0.2;   // C: repulsion relative to attraction (Hu's choice)
+constexpr double Gravity = 0.01;    // pull towards the centroid per unit of distance
+constexpr double Cooling = 0.9;     // step length factor
+constexpr int SettleRuns = 5;       // lower-energy iterations in a row before the step grows
+constexpr int MaxDepth = 24;        // deeper than this, bodies share a leaf
+constexpr std::size_t Chunk = 512;  // vertices per parallel work item
+constexpr std::size_t CoarsestSize = 64; // stop coarsening below this many vertices
+constexpr double MinShrink = 0.75;  // ...or once a level keeps more than this share of the vertices
+constexpr double RefineStep = 0.2;  // first step on a level that starts from a layout, in units of K
+
+} // namespace
+
+ForceLayout::ForceLayout(const CsrGraph &graph, std::vector<Point> positions, const LayoutOptions &options)
+    : options(options), position(std::move(positions)) {
+    const std::size_t n = graph.vertexCount();
+    position.resize(n);
+
+    Level finest;
+    finest.edgeLength = options.edgeLength;
+    finest.begin.assign(n + 1, 0);
+    for (std::size_t e = 0; e < graph.edgeCount(); ++e) {
+        if (graph.edgeSource(e) == graph.edgeTarget(e)) continue;
+        ++finest.begin[graph.edgeSource(e) + 1];
+        ++finest.begin[graph.edgeTarget(e) + 1];
+    }
+    for (std::size_t v = 0; v < n; ++v) finest.begin[v + 1] += finest.begin[v];
+    finest.neighbours.resize(finest.begin[n]);
+    std::vector<std::size_t> fill(finest.begin.begin(), finest.begin.end() - 1);
+    for (std::size_t e = 0; e < graph.edgeCount(); ++e) {
+        const std::uint32_t u = graph.edgeSource(e), v = graph.edgeTarget(e);
+        if (u == v) continue;
+        finest.neighbours[fill[u]++] = v;
+        finest.neighbours[fill[v]++] = u;
+    }
+    levels.push_back(std::move(finest));
+
+    if (!options.refine) {
+        while (levels.back().size() > CoarsestSize && coarsen()) {
+        }
+    }
+
+    // The coarsest level starts from the mean position of the vertices
+    // each of its vertices stands for
+    current = levels.size() - 1;
+    for (std::size_t l = 0; l < current; ++l) {
+        const Level &fine = levels[l];
+        std::vector<Point> sum(levels[l + 1].size());
+        std::vector<double> count(sum.size(), 0);
+        for (std::size_t v = 0; v < fine.size(); ++v) {
+            sum[fine.coarser[v]].x += position[v].x;
+            sum[fine.coarser[v]].y += position[v].y;
+            count[fine.coarser[v]] += 1;
+        }
+        for (std::size_t c = 0; c < sum.size(); ++c) {
+            sum[c].x /= count[c];
+            sum[c].y /= count[c];
+        }
+        position.swap(sum);
+    }
+    startLevel(options.refine ? RefineStep * options.edgeLength : levels[current].edgeLength);
+}
+
+ForceLayout::ForceLayout(const LayoutPatch &patch, const LayoutOptions &options)
+    : options(options), base(patch.positions) {
+    // Local index of each vertex: the movable ones first, then the fixed
+    // ends of their edges as they turn up
+    const std::uint32_t Unmapped = std::numeric_limits<std::uint32_t>::max();
+    std::vector<std::uint32_t> local(base.size(), Unmapped);
+    for (std::uint32_t v : patch.movable) {
+        if (v >= base.size() || local[v] != Unmapped) continue;
+        local[v] = (std::uint32_t)ids.size();
+        ids.push_back(v);
+        position.push_back(base[v]);
+    }
+    const std::size_t m = ids.size();
+    auto movable = [&](std::uint32_t v) { return local[v] < m; };
+    auto localOf = [&](std::uint32_t v) {
+        if (local[v] == Unmapped) {
+            local[v] = (std::uint32_t)position.size();
+            position.push_back(base[v]);
+        }
+        return local[v];
+    };
+
+    Level level;
+    level.edgeLength = options.edgeLength;
+    level.begin.assign(m + 1, 0);
+    auto counted = [&](const std::pair<std::uint32_t, std::uint32_t> &e) {
+        return e.first != e.second && e.first < base.size() && e.second < base.size() &&
+               (movable(e.first) || movable(e.second));
+    };
+    for (const auto &e : patch.edges) {
+        if (!counted(e)) continue;
+        if (movable(e.first)) ++level.begin[local[e.first] + 1];
+        if (movable(e.second)) ++level.begin[local[e.second] + 1];
+    }
+    for (std::size_t v = 0; v < m; ++v) level.begin[v + 1] += level.begin[v];
+    level.neighbours.resize(level.begin[m]);
+    std::vector<std::size_t> fill(level.begin.begin(), level.begin.end() - 1);
+    for (const auto &e : patch.edges) {
+        if (!counted(e)) continue;
+        const std::uint32_t u = localOf(e.first), v = localOf(e.second);
+        if (u < m) level.neighbours[fill[u]++] = v;
+        if (v < m) level.neighbours[fill[v]++] = u;
+    }
+    levels.push_back(std::move(level));
+
+    std::vector<Point> still;
+    still.reserve(base.size() - m);
+    for (std::size_t v = 0; v < base.size(); ++v)
+        if (!movable((std::uint32_t)v)) still.push_back(base[v]);
+    if (!still.empty()) buildTree(fixedCells, still, still.size());
+    startLevel(RefineStep * options.edgeLength);
+}
+
+bool ForceLayout::coarsen() {
+    const Level &fine = levels.back();
+    const std::size_t n = fine.size();
+    auto degree = [&](std::size_t v) { return fine.begin[v + 1] - fine.begin[v]; };
+
+    // Low-degree vertices pick first, each the unmatched neighbour of
+    // lowest degree, so hubs don't swallow everything around them
+    std::vector<std::uint32_t> order(n);
+    for (std::uint32_t v = 0; v < n; ++v) order[v] = v;
+    std::stable_sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) { return degree(a) < degree(b); });
+
+    const std::uint32_t Unmatched = std::numeric_limits<std::uint32_t>::max();
+    std::vector<std::uint32_t> coarser(n, Unmatched);
+    std::uint32_t count = 0;
+    for (std::uint32_t v : order) {
+        if (coarser[v] != Unmatched) continue;
+        std::uint32_t partner = Unmatched;
+        for (std::size_t i = fine.begin[v]; i < fine.begin[v + 1]; ++i) {
+            const std::uint32_t w = fine.neighbours[i];
+            if (w != v && coarser[w] == Unmatched && (partner == Unmatched || degree(w) < degree(partner))) partner = w;
+        }
+        coarser[v] = count;
+        if (partner != Unmatched) coarser[partner] = count;
+        ++count;
+    }
+    if (count > MinShrink * n) return false;
+
+    // Edges between different coarse vertices, each once
+    Level coarse;
+    coarse.begin.assign(count + 1, 0);
+    for (std::size_t v = 0; v < n; ++v) coarse.begin[coarser[v] + 1] += degree(v);
+    for (std::size_t c = 0; c < count; ++c) coarse.begin[c + 1] += coarse.begin[c];
+    coarse.neighbours.resize(coarse.begin[count]);
+    std::vector<std::size_t> fill(coarse.begin.begin(), coarse.begin.end() - 1);
+    for (std::size_t v = 0; v < n; ++v) {
+        const std::uint32_t c = coarser[v];
+        for (std::size_t i = fine.begin[v]; i < fine.begin[v + 1]; ++i)
+            if (coarser[fine.neighbours[i]] != c) coarse.neighbours[fill[c]++] = coarser[fine.neighbours[i]];
+    }
+    std::size_t kept = 0;
+    for (std::size_t c = 0; c < count; ++c) {
+        auto first = coarse.neighbours.begin() + coarse.begin[c], last = coarse.neighbours.begin() + fill[c];
+        std::sort(first, last);
+        last = std::unique(first, last);
+        coarse.begin[c] = kept;
+        kept = std::copy(first, last, coarse.neighbours.begin() + kept) - coarse.neighbours.begin();
+    }
+    coarse.begin[count] = kept;
+    coarse.neighbours.resize(kept);
+
+    // Fewer vertices spread over the same area
+    coarse.edgeLength = fine.edgeLength * std::sqrt((double)n / count);
+    levels.back().coarser = std::move(coarser);
+    levels.push_back(std::move(coarse));
+    return true;
+}
+
+void ForceLayout::startLevel(double firstStep) {
+    stepLength = firstStep;
+    energy = std::numeric_limits<double>::infinity();
+    progress = 0;
+    levelIteration = 0;
+    forceX.assign(position.size(), 0);
+    forceY.assign(position.size(), 0);
+}
+
+std::vector<Point> ForceLayout::positions() const {
+    if (!base.empty()) {
+        std::vector<Point> out = base;
+        for (std::size_t i = 0; i < ids.size(); ++i) out[ids[i]] = position[i];
+        return out;
+    }
+
+    const Level &graph = levels[0];
+    std::vector<Point> out(graph.size());
+    for (std::size_t v = 0; v < out.size(); ++v) {
+        std::size_t at = v;
+        for (std::size_t l = 0; l < current; ++l) at = levels[l].coarser[at];
+        out[v] = position[at];
+    }
+    if (options.refine) return out;
+
+    // The repulsion reaches across the whole graph, so large graphs settle
+    // spread out beyond K; scale about the centroid back to K per edge
+    double length = 0, x = 0, y = 0;
+    for (std::size_t v = 0; v < out.size(); ++v) {
+        x += out[v].x;
+        y += out[v].y;
+        for (std::size_t i = graph.begin[v]; i < graph.begin[v + 1]; ++i) {
+            const Point &w = out[graph.neighbours[i]];
+            length += std::sqrt((w.x - out[v].x) * (w.x - out[v].x) + (w.y - out[v].y) * (w.y - out[v].y));
+        }
+    }
+    if (length == 0) return out;
+    const double scale = options.edgeLength * graph.neighbours.size() / length;
+    x /= out.size();
+    y /= out.size();
+    for (Point &p : out) {
+        p.x = x + (p.x - x) * scale;
+        p.y = y + (p.y - y) * scale;
+    }
+    return out;
+}
+
+bool ForceLayout::step() {
+    if (done) return false;
+    const Level &graph = levels[current];
+    const std::size_t n = graph.size();
+    if (n == 0) {
+        done = true;
+        return false;
+    }
+
+    const double k = graph.edgeLength;
+    buildTree(cells, position, n);
+    double sumX = cells[0].sumX, sumY = cells[0].sumY, mass = cells[0].mass;
+    if (!fixedCells.empty()) {
+        sumX += fixedCells[0].sumX;
+        sumY += fixedCells[0].sumY;
+        mass += fixedCells[0].mass;
+    }
+    const double centroidX = sumX / mass, centroidY = sumY / mass;
+
+    const std::size_t chunks = (n + Chunk - 1) / Chunk;
+    std::vector<double> chunkEnergy(chunks, 0);
+    parallelChunks(n, Chunk, options.threads, [&](std::size_t c, std::size_t begin, std::size_t end) {
+        for (std::size_t v = begin; v < end; ++v) {
+            const Point p = position[v];
+            double fx = 0, fy = 0;
+            repulsion(cells, (std::uint32_t)v, true, k, fx, fy);
+            if (!fixedCells.empty()) repulsion(fixedCells, (std::uint32_t)v, false, k, fx, fy);
+            for (std::size_t i = graph.begin[v]; i < graph.begin[v + 1]; ++i) {
+                // d^2 / K along the edge
+                const double dx = position[graph.neighbours[i]].x - p.x, dy = position[graph.neighbours[i]].y - p.y;
+                const double d = std::sqrt(dx * dx + dy * dy);
+                fx += dx * d / k;
+                fy += dy * d / k;
+            }
+            fx -= Gravity * (p.x - centroidX);
+            fy -= Gravity * (p.y - centroidY);
+            forceX[v] = fx;
+            forceY[v] = fy;
+            chunkEnergy[c] += fx * fx + fy * fy;
+        }
+    });
+    double total = 0;
+    for (double e : chunkEnergy) total += e;
+
+    // Hu's adaptive step: widen it after a run of improvements, narrow it
+    // whenever the energy rises
+    if (total < energy) {
+        if (++progress >= SettleRuns) {
+            progress = 0;
+            stepLength /= Cooling;
+        }
+    } else {
+        progress = 0;
+        stepLength *= Cooling;
+    }
+    energy = total;
+
+    parallelChunks(n, Chunk, options.threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t v = begin; v < end; ++v) {
+            const double length = std::sqrt(forceX[v] * forceX[v] + forceY[v] * forceY[v]);
+            if (length == 0) continue;
+            position[v].x += stepLength * forceX[v] / length;
+            position[v].y += stepLength * forceY[v] / length;
+        }
+    });
+    ++iteration;
+    ++levelIteration;
+
+    if (stepLength >= options.tolerance * k && levelIteration < options.maxIterations) return true;
+    if (current == 0) {
+        done = true;
+        return true;
+    }
+    // Next finer level: every vertex starts where its coarse vertex is
+    const Level &fine = levels[--current];
+    std::vector<Point> next(fine.size());
+    for (std::size_t v = 0; v < next.size(); ++v) next[v] = position[fine.coarser[v]];
+    position.swap(next);
+    startLevel(RefineStep * fine.edgeLength);
+    return true;
+}
+
+// ---- Barnes-Hut quadtree ----
+void ForceLayout::buildTree(std::vector<Cell> &tree, const std::vector<Point> &points, std::size_t count) {
+    double minX = points[0].x, maxX = minX, minY = points[0].y, maxY = minY;
+    for (std::size_t v = 1; v < count; ++v) {
+        minX = std::min(minX, points[v].x);
+        maxX = std::max(maxX, points[v].x);
+        minY = std::min(minY, points[v].y);
+        maxY = std::max(maxY, points[v].y);
+    }
+    tree.clear();
+    Cell root;
+    root.centerX = (minX + maxX) / 2;
+    root.centerY = (minY + maxY) / 2;
+    root.half = std::max(maxX - minX, maxY - minY) / 2 + 1;
+    tree.push_back(root);
+    for (std::uint32_t v = 0; v < count; ++v) insert(tree, points, v);
+}
+
+void ForceLayout::insert(std::vector<Cell> &tree, const std::vector<Point> &points, std::uint32_t v) {
+    const Point p = points[v];
+    auto quadrant = [&](const Cell &cell, const Point &at) {
+        return (at.x >= cell.centerX ? 1 : 0) | (at.y >= cell.centerY ? 2 : 0);
+    };
+    auto add = [&](Cell &cell) {
+        cell.sumX += p.x;
+        cell.sumY += p.y;
+        cell.mass += 1;
+    };
+
+    std::int32_t c = 0;
+    for (int depth = 0;; ++depth) {
+        if (tree[c].children < 0) {
+            if (tree[c].mass == 0 || depth == MaxDepth) {
+                add(tree[c]);
+                if (tree[c].body < 0) tree[c].body = (std::int32_t)v;
+                return;
+            }
+            // An occupied leaf splits; its one body moves down a level
+            const std::int32_t first = (std::int32_t)tree.size();
+            const double x = tree[c].centerX, y = tree[c].centerY, half = tree[c].half / 2;
+            for (int q = 0; q < 4; ++q) {
+                Cell child;
+                child.centerX = x + (q & 1 ? half : -half);
+                child.centerY = y + (q & 2 ? half : -half);
+                child.half = half;
+                tree.push_back(child);
+            }
+            Cell &leaf = tree[c];
+            Cell &moved = tree[first + quadrant(leaf, points[leaf.body])];
+            moved.sumX = leaf.sumX;
+            moved.sumY = leaf.sumY;
+            moved.mass = leaf.mass;
+            moved.body = leaf.body;
+            leaf.children = first;
+            leaf.body = -1;
+        }
+        add(tree[c]);
+        c = tree[c].children + quadrant(tree[c], p);
+    }
+}
+
+void ForceLayout::repulsion(const std::vector<Cell> &tree, std::uint32_t v, bool member, double k, double &fx,
+                            double &fy) const {
+    const Point p = position[v];
+    const double strength = Repulsion * k * k;
+    const double theta2 = options.theta * options.theta;
+    const double nearby = 1e-6 * k * k; // closer than this (squared) counts as on top of v
+
+    std::int32_t stack[4 * MaxDepth + 8];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const Cell &cell = tree[stack[--top]];
+        if (cell.mass == 0) continue;
+        double dx = p.x - cell.sumX / cell.mass, dy = p.y - cell.sumY / cell.mass;
+        double d2 = dx * dx + dy * dy;
+        // open a cell that is too close for its size
+        if (cell.children >= 0 && 4 * cell.half * cell.half >= theta2 * d2) {
+            for (int q = 0; q < 4; ++q) stack[top++] = cell.children + q;
+            continue;
+        }
+
+        double mass = cell.mass;
+        if (d2 < nearby) {
+            // v's own leaf: whatever sits on top of it pushes v out along a
+            // direction of its own, so stacked vertices fan out
+            if (member) mass -= 1;
+            if (mass <= 0) continue;
+            const double angle = v * 2.399963229728653; // golden angle
+            dx = 0.01 * k * std::cos(angle);
+            dy = 0.01 * k * std::sin(angle);
+            d2 = 1e-4 * k * k;
+        }
+        // C K^2 m / d, along (dx, dy) / d
+        const double f = strength * mass / d2;
+        fx += dx * f;
+        fy += dy * f;
+    }
+}
+
+bool forceLayout(const CsrGraph &graph, std::vector<Point> &positions, const LayoutOptions &options,
+                 RunControl *control) {
+    ForceLayout layout(graph, std::move(positions), options);
+    bool finished = true;
+    while (layout.step()) {
+        if (control && control->isCancelled()) {
+            finished = false;
+            break;
+        }
+    }
+    positions = layout.positions();
+    return finished;
+}
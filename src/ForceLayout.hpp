@@ -0,0 +1,134 @@
+#ifndef FORCELAYOUT_HPP
+#define FORCELAYOUT_HPP
+
+#include "CsrGraph.hpp"
+#include "Graph.hpp"
+#include "RunControl.hpp"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Force-directed layout: the spring-electrical model of Fruchterman &
+// Reingold with the adaptive step length and multilevel scheme of Hu
+// ("Efficient and High Quality Force-Directed Graph Drawing"). Neighbours
+// pull at d^2/K, every two vertices push apart at C*K^2/d, and a weak pull
+// towards the centre keeps disconnected pieces from drifting off. Each
+// iteration moves every vertex a fixed step along its net force; the step
+// grows while the energy keeps falling and shrinks when it does not.
+//
+// Repulsion is summed over a Barnes-Hut quadtree, so an iteration costs
+// O(V log V + E) rather than O(V^2), and the forces on different vertices
+// are summed on `threads` workers.
+//
+// A large graph is first coarsened by repeatedly merging matched
+// neighbours. The coarsest graph is laid out from the starting positions,
+// then each finer level starts where its coarse vertex ended up and only
+// needs local corrections. Edge directions and weights are ignored.
+//
+// After an edit only part of a drawn layout needs to settle again: a
+// LayoutPatch names the vertices that may move and the edges touching
+// them. The others stay put, in a quadtree built once, and only push and
+// pull on the movable ones, so an iteration costs O(M log V) for M
+// movable vertices.
+
+struct LayoutOptions {
+    double edgeLength = 90;           // K: roughly the distance neighbours settle at
+    double theta = 1.0;               // Barnes-Hut: a cell this much smaller than its distance counts as one body
+    double tolerance = 0.05;          // a level has converged once the step is below tolerance * K
+    std::size_t maxIterations = 150;  // per level
+    bool refine = false;              // the positions already are a layout: no coarse levels, short first steps
+    unsigned threads = 0;             // 0 = all cores
+};
+
+// Part of a layout to settle again
+struct LayoutPatch {
+    std::vector<Point> positions;       // every vertex, indexed by id
+    std::vector<std::uint32_t> movable; // the vertices that may move
+    // every edge with a movable end, once (self-loops are dropped)
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> edges;
+};
+
+class ForceLayout {
+public:
+    // `positions` is the starting layout, one point per vertex
+    ForceLayout(const CsrGraph &graph, std::vector<Point> positions, const LayoutOptions &options = {});
+    // Refine `patch` (always on the graph itself, as if options.refine)
+    explicit ForceLayout(const LayoutPatch &patch, const LayoutOptions &options = {});
+
+    // One iteration on the current level, moving on to the next finer one
+    // when it converges; false once the graph itself has (further calls do
+    // nothing)
+    bool step();
+
+    bool finished() const { return done; }
+    std::size_t iterations() const { return iteration; }
+    // Levels still to lay out after the current one (0 on the graph itself)
+    std::size_t level() const { return current; }
+    // Where every vertex of the graph is (on a coarse level, where the
+    // vertex standing for it is). A layout from scratch is scaled so
+    // edges average K; a refined one is left as it is.
+    std::vector<Point> positions() const;
+
+private:
+    // A graph as symmetric neighbour lists, self-loops dropped. In a
+    // patch, neighbours from size() on are fixed anchors (see position).
+    struct Level {
+        std::vector<std::size_t> begin;
+        std::vector<std::uint32_t> neighbours;
+        std::vector<std::uint32_t> coarser; // vertex of the next level up standing for each vertex
+        double edgeLength;
+
+        std::size_t size() const { return begin.size() - 1; }
+    };
+
+    // Square quadtree cell. Sums rather than centres of mass, so bodies
+    // are added with plain additions.
+    struct Cell {
+        double sumX = 0, sumY = 0;  // of the bodies inside
+        double mass = 0;            // bodies inside
+        double centerX, centerY, half;
+        std::int32_t children = -1; // first of four consecutive cells; -1 for a leaf
+        std::int32_t body = -1;     // a leaf's first body, -1 while empty
+    };
+
+    // Merge matched neighbours of levels.back() into a new level; false if
+    // that would hardly shrink the graph
+    bool coarsen();
+    void startLevel(double firstStep);
+    // Quadtree over points[0, count)
+    static void buildTree(std::vector<Cell> &tree, const std::vector<Point> &points, std::size_t count);
+    static void insert(std::vector<Cell> &tree, const std::vector<Point> &points, std::uint32_t v);
+    // Add the push of `tree`'s bodies on vertex v, which is one of them if `member`
+    void repulsion(const std::vector<Cell> &tree, std::uint32_t v, bool member, double k, double &fx,
+                   double &fy) const;
+
+    const LayoutOptions options;
+    std::vector<Level> levels; // [0] is the graph itself
+    std::size_t current = 0;
+    // Of the current level's vertices; in a patch, of the movable ones
+    // followed by their fixed neighbours
+    std::vector<Point> position;
+
+    // Patch only: the graph's positions, the id of each movable vertex,
+    // and a quadtree over the vertices that stay put
+    std::vector<Point> base;
+    std::vector<std::uint32_t> ids;
+    std::vector<Cell> fixedCells;
+
+    std::vector<Cell> cells; // over the vertices that move
+    std::vector<double> forceX, forceY;
+
+    std::size_t iteration = 0, levelIteration = 0;
+    double stepLength = 0;
+    double energy = 0;
+    int progress = 0; // iterations in a row that lowered the energy
+    bool done = false;
+};
+
+// Run ForceLayout until it converges. positions: one point per vertex,
+// the starting layout on entry. Returns false if cancelled (positions then
+// hold the layout reached so far).
+bool forceLayout(const CsrGraph &graph, std::vector<Point> &positions, const LayoutOptions &options = {},
+                 RunControl *control = nullptr);
+
+#endif // FORCELAYOUT_HPP
@@ -0,0 +1,443 @@
+#include "Generators.hpp"
+#include "Parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+namespace {
+
+// Edges (or vertices, for grid / geometric) per parallel work chunk
+constexpr std::size_t ChunkSize = 1 << 16;
+constexpr int MaxRedraws = 1000; // R-MAT draws per edge before giving up
+
+constexpr double Pi = 3.14159265358979323846;
+
+// SplitMix64: tiny, fast and good enough for graph generation
+struct Random {
+    std::uint64_t state;
+
+    explicit Random(std::uint64_t seed) : state(seed) {}
+
+    std::uint64_t next() {
+        std::uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+    std::uint64_t below(std::uint64_t n) { return next() % n; }
+    double unit() { return (next() >> 11) * (1.0 / 9007199254740992.0); } // [0, 1)
+};
+
+// Independent stream per (seed, chunk)
+Random streamFor(std::uint64_t seed, std::uint64_t chunk) {
+    Random mix(seed ^ (chunk * 0xd1b54a32d192ed03ULL));
+    return Random(mix.next());
+}
+
+int randomWeight(Random &rng, const GeneratorParams &p) {
+    return p.minWeight + (int)rng.below((std::uint64_t)((std::int64_t)p.maxWeight - p.minWeight + 1));
+}
+
+void resize(EdgeList &out, std::size_t count) {
+    out.from.resize(count);
+    out.to.resize(count);
+    out.weights.resize(count);
+}
+
+// Generators whose chunks emit a variable number of edges collect them per
+// chunk; this appends the chunks in order so the result is deterministic.
+struct ChunkEdges {
+    std::vector<NodeId> from, to;
+    std::vector<int> weights;
+};
+
+void concatenate(std::vector<ChunkEdges> &chunks, EdgeList &out, unsigned threads) {
+    std::vector<std::size_t> offsets(chunks.size() + 1, 0);
+    for (std::size_t c = 0; c < chunks.size(); ++c) offsets[c + 1] = offsets[c] + chunks[c].from.size();
+    resize(out, offsets.back());
+
+    parallelChunks(chunks.size(), 1, threads, [&](std::size_t c, std::size_t, std::size_t) {
+        auto &chunk = chunks[c];
+        std::copy(chunk.from.begin(), chunk.from.end(), out.from.begin() + offsets[c]);
+        std::copy(chunk.to.begin(), chunk.to.end(), out.to.begin() + offsets[c]);
+        std::copy(chunk.weights.begin(), chunk.weights.end(), out.weights.begin() + offsets[c]);
+        chunk = ChunkEdges();
+    });
+}
+
+// ---- Erdos-Renyi G(n, m), no self-loops ----
+void erdosRenyi(const GeneratorParams &p, EdgeList &out) {
+    resize(out, p.edges);
+    const std::uint64_t n = p.nodes;
+    parallelChunks(p.edges, ChunkSize, p.threads, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        Random rng = streamFor(p.seed, chunk);
+        for (std::size_t e = begin; e < end; ++e) {
+            std::uint64_t u = rng.below(n), v = rng.below(n);
+            while (v == u) v = rng.below(n);
+            out.from[e] = (NodeId)u;
+            out.to[e] = (NodeId)v;
+            out.weights[e] = randomWeight(rng, p);
+        }
+    });
+}
+
+// ---- R-MAT: descend the adjacency matrix quadrant by quadrant ----
+// Each level picks quadrant a (0,0), b (0,1), c (1,0) or d (1,1) from 16
+// random bits compared against fixed-point thresholds, four levels per draw.
+std::uint32_t rmatThreshold(double odds) {
+    return (std::uint32_t)std::min(65536.0, std::round(odds * 65536.0));
+}
+
+// False if some edge needed more than MaxRedraws draws: the odds (almost)
+// never give two distinct ids below p.nodes
+bool rmat(const GeneratorParams &p, EdgeList &out) {
+    resize(out, p.edges);
+    unsigned scale = 0;
+    while (((std::uint64_t)1 << scale) < p.nodes) ++scale;
+
+    const std::uint32_t tA = rmatThreshold(p.rmatA);
+    const std::uint32_t tAB = rmatThreshold(p.rmatA + p.rmatB);
+    const std::uint32_t tABC = rmatThreshold(p.rmatA + p.rmatB + p.rmatC);
+
+    std::atomic<bool> stuck{false};
+    parallelChunks(p.edges, ChunkSize, p.threads, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        Random rng = streamFor(p.seed, chunk);
+        for (std::size_t e = begin; e < end && !stuck.load(std::memory_order_relaxed); ++e) {
+            std::uint64_t u, v;
+            int draws = 0;
+            do {
+                if (++draws > MaxRedraws) {
+                    stuck.store(true, std::memory_order_relaxed);
+                    return;
+                }
+                u = v = 0;
+                std::uint64_t bits = 0;
+                for (unsigned level = 0; level < scale; ++level) {
+                    if (level % 4 == 0) bits = rng.next();
+                    std::uint32_t r = (std::uint32_t)(bits & 0xffff);
+                    bits >>= 16;
+                    unsigned q = (r >= tA) + (r >= tAB) + (r >= tABC);
+                    u = (u << 1) | (q >> 1);
+                    v = (v << 1) | (q & 1);
+                }
+                // ids past nodes (when nodes isn't a power of two) and self-loops are redrawn
+            } while (u >= p.nodes || v >= p.nodes || u == v);
+            out.from[e] = (NodeId)u;
+            out.to[e] = (NodeId)v;
+            out.weights[e] = randomWeight(rng, p);
+        }
+    });
+    return !stuck;
+}
+
+// ---- Barabasi-Albert ----
+// Vertices 0..m form a clique; every later vertex adds m edges. Each edge
+// picks a uniformly random endpoint slot among all earlier edges (which is
+// preferential attachment); a slot holding an earlier edge's target is
+// resolved by recomputing that edge, so every edge is a pure function of
+// (seed, edge index) and the whole list is generated in parallel. Only
+// slots of earlier vertices are drawn, so there are no self-loops
+// (parallel edges can occur).
+void barabasiAlbert(const GeneratorParams &p, EdgeList &out) {
+    const std::uint64_t m = p.edgesPerNode;
+    const std::uint64_t cliqueEdges = m * (m + 1) / 2;
+    const std::uint64_t total = cliqueEdges + (p.nodes - m - 1) * m;
+    resize(out, total);
+
+    std::vector<NodeId> cliqueFrom, cliqueTo;
+    cliqueFrom.reserve(cliqueEdges);
+    cliqueTo.reserve(cliqueEdges);
+    for (NodeId v = 1; v <= m; ++v) {
+        for (NodeId u = 0; u < v; ++u) {
+            cliqueFrom.push_back(v);
+            cliqueTo.push_back(u);
+        }
+    }
+
+    auto source = [&](std::uint64_t e) -> NodeId {
+        return e < cliqueEdges ? cliqueFrom[e] : (NodeId)(m + 1 + (e - cliqueEdges) / m);
+    };
+    auto target = [&](std::uint64_t e) -> NodeId {
+        for (;;) {
+            if (e < cliqueEdges) return cliqueTo[e];
+            // slots of edges added before this vertex's first one
+            std::uint64_t firstOfNode = e - (e - cliqueEdges) % m;
+            std::uint64_t slot = Random(p.seed ^ (e * 0x9e3779b97f4a7c15ULL)).next() % (2 * firstOfNode);
+            if (slot % 2 == 0) return source(slot / 2);
+            e = slot / 2; // another edge's target: resolve it the same way
+        }
+    };
+
+    parallelChunks(total, ChunkSize, p.threads, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        Random rng = streamFor(p.seed, chunk);
+        for (std::size_t e = begin; e < end; ++e) {
+            out.from[e] = source(e);
+            out.to[e] = target(e);
+            out.weights[e] = randomWeight(rng, p);
+        }
+    });
+}
+
+// ---- Random geometric graph in the unit square ----
+void randomGeometric(const GeneratorParams &p, EdgeList &out) {
+    const std::size_t n = p.nodes;
+    // radius giving `edges` expected edges (ignoring the border)
+    const double radius = std::min(1.5, std::sqrt(2.0 * p.edges / (Pi * (double)n * std::max<double>(1, n - 1))));
+
+    std::vector<double> xs(n), ys(n);
+    parallelChunks(n, ChunkSize, p.threads, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        Random rng = streamFor(p.seed, chunk);
+        for (std::size_t i = begin; i < end; ++i) {
+            xs[i] = rng.unit();
+            ys[i] = rng.unit();
+        }
+    });
+
+    // Bucket points into square cells of side >= radius (counting sort)
+    std::size_t side = std::max<std::size_t>(1, std::min((std::size_t)(1.0 / radius),
+                                                         (std::size_t)std::sqrt((double)n) + 1));
+    auto cellOf = [&](std::size_t i) {
+        std::size_t cx = std::min(side - 1, (std::size_t)(xs[i] * side));
+        std::size_t cy = std::min(side - 1, (std::size_t)(ys[i] * side));
+        return cy * side + cx;
+    };
+    std::vector<std::size_t> cellStart(side * side + 1, 0);
+    for (std::size_t i = 0; i < n; ++i) ++cellStart[cellOf(i) + 1];
+    for (std::size_t c = 0; c < side * side; ++c) cellStart[c + 1] += cellStart[c];
+    std::vector<NodeId> cellPoints(n);
+    {
+        std::vector<std::size_t> cursor(cellStart.begin(), cellStart.end() - 1);
+        for (std::size_t i = 0; i < n; ++i) cellPoints[cursor[cellOf(i)]++] = (NodeId)i;
+    }
+
+    // Each cell row pairs its points with the same cell and the forward
+    // neighbours (right, and the three below) so every pair is seen once.
+    const double r2 = radius * radius;
+    std::vector<ChunkEdges> chunks(side);
+    parallelChunks(side, 1, p.threads, [&](std::size_t row, std::size_t, std::size_t) {
+        ChunkEdges &local = chunks[row];
+        for (std::size_t col = 0; col < side; ++col) {
+            std::size_t c = row * side + col;
+            for (std::size_t a = cellStart[c]; a < cellStart[c + 1]; ++a) {
+                NodeId u = cellPoints[a];
+                auto consider = [&](std::size_t b) {
+                    NodeId v = cellPoints[b];
+                    double dx = xs[u] - xs[v], dy = ys[u] - ys[v];
+                    double d2 = dx * dx + dy * dy;
+                    if (d2 >= r2) return;
+                    local.from.push_back(u);
+                    local.to.push_back(v);
+                    // weight grows with distance
+                    local.weights.push_back(p.minWeight + (int)std::lround(
+                        std::sqrt(d2) / radius * ((double)p.maxWeight - p.minWeight)));
+                };
+                for (std::size_t b = a + 1; b < cellStart[c + 1]; ++b) consider(b);
+
+                const long dirs[4][2] = {{1, 0}, {-1, 1}, {0, 1}, {1, 1}};
+                for (const auto &d : dirs) {
+                    long nx = (long)col + d[0], ny = (long)row + d[1];
+                    if (nx < 0 || ny < 0 || nx >= (long)side || ny >= (long)side) continue;
+                    std::size_t nc = (std::size_t)ny * side + (std::size_t)nx;
+                    for (std::size_t b = cellStart[nc]; b < cellStart[nc + 1]; ++b) consider(b);
+                }
+            }
+        }
+    });
+    concatenate(chunks, out, p.threads);
+
+    out.coordinates.resize(n);
+    for (std::size_t i = 0; i < n; ++i) out.coordinates[i] = {xs[i], ys[i]};
+}
+
+// ---- 2D grid: right and down neighbours ----
+void grid(const GeneratorParams &p, EdgeList &out) {
+    const std::size_t n = p.nodes;
+    const std::size_t cols = std::max<std::size_t>(1, (std::size_t)std::ceil(std::sqrt((double)n)));
+    const std::size_t chunkCount = (n + ChunkSize - 1) / ChunkSize;
+
+    std::vector<ChunkEdges> chunks(chunkCount);
+    parallelChunks(n, ChunkSize, p.threads, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        Random rng = streamFor(p.seed, chunk);
+        ChunkEdges &local = chunks[chunk];
+        local.from.reserve(2 * (end - begin));
+        local.to.reserve(2 * (end - begin));
+        local.weights.reserve(2 * (end - begin));
+        for (std::size_t v = begin; v < end; ++v) {
+            if ((v + 1) % cols != 0 && v + 1 < n) {
+                local.from.push_back((NodeId)v);
+                local.to.push_back((NodeId)(v + 1));
+                local.weights.push_back(randomWeight(rng, p));
+            }
+            if (v + cols < n) {
+                local.from.push_back((NodeId)v);
+                local.to.push_back((NodeId)(v + cols));
+                local.weights.push_back(randomWeight(rng, p));
+            }
+        }
+    });
+    concatenate(chunks, out, p.threads);
+
+    // unit spacing, so every edge is 1 long
+    out.coordinates.resize(n);
+    for (std::size_t v = 0; v < n; ++v) out.coordinates[v] = {(double)(v % cols), (double)(v / cols)};
+}
+
+bool fail(std::string *error, const std::string &message) {
+    if (error) *error = message;
+    return false;
+}
+
+bool validate(const GeneratorParams &p, std::string *error) {
+    // arc indices are 32-bit throughout (StepEvent::edge, CsrGraph::edgeArc)
+    const std::uint64_t maxArcs = std::numeric_limits<std::uint32_t>::max() - 1;
+
+    if (p.nodes == 0) return fail(error, "a generated graph needs at least one node");
+    if (p.nodes >= InvalidNode) return fail(error, "too many nodes");
+    if (p.minWeight > p.maxWeight) return fail(error, "minimum weight is larger than maximum weight");
+
+    std::uint64_t edges = p.edges;
+    switch (p.kind) {
+    case GeneratorKind::ErdosRenyi:
+    case GeneratorKind::RMat:
+        if (p.nodes < 2 && p.edges > 0) return fail(error, "random edges need at least two nodes");
+        if (p.kind == GeneratorKind::RMat &&
+            (p.rmatA < 0 || p.rmatB < 0 || p.rmatC < 0 || p.rmatA + p.rmatB + p.rmatC > 1.0))
+            return fail(error, "R-MAT probabilities a, b, c must be non-negative and sum to at most 1");
+        // with b and c (as drawn) zero, every edge would be a self-loop
+        if (p.kind == GeneratorKind::RMat && p.edges > 0 &&
+            rmatThreshold(p.rmatA + p.rmatB + p.rmatC) == rmatThreshold(p.rmatA))
+            return fail(error, "R-MAT probabilities b + c must be above 0");
+        break;
+    case GeneratorKind::BarabasiAlbert:
+        if (p.edgesPerNode == 0) return fail(error, "edges per node must be at least 1");
+        if (p.nodes <= p.edgesPerNode) return fail(error, "Barabasi-Albert needs more nodes than edges per node");
+        edges = p.edgesPerNode * (p.edgesPerNode + 1) / 2 + (p.nodes - p.edgesPerNode - 1) * p.edgesPerNode;
+        break;
+    case GeneratorKind::Grid:
+        edges = 2 * (std::uint64_t)p.nodes;
+        break;
+    case GeneratorKind::RandomGeometric:
+        break;
+    }
+    if (edges * (p.directed ? 1 : 2) > maxArcs) return fail(error, "too many edges");
+    return true;
+}
+
+std::string toLower(std::string s) {
+    for (char &c : s) c = (char)std::tolower((unsigned char)c);
+    return s;
+}
+
+} // namespace
+
+const char *generatorName(GeneratorKind kind) {
+    switch (kind) {
+    case GeneratorKind::RMat:            return "rmat";
+    case GeneratorKind::BarabasiAlbert:  return "barabasi-albert";
+    case GeneratorKind::RandomGeometric: return "geometric";
+    case GeneratorKind::Grid:            return "grid";
+    case GeneratorKind::ErdosRenyi:      return "erdos-renyi";
+    }
+    return "?";
+}
+
+bool parseGeneratorKind(const std::string &name, GeneratorKind &kind) {
+    const std::string n = toLower(name);
+    if (n == "rmat" || n == "r-mat" || n == "kronecker") kind = GeneratorKind::RMat;
+    else if (n == "barabasi-albert" || n == "ba") kind = GeneratorKind::BarabasiAlbert;
+    else if (n == "geometric" || n == "rgg") kind = GeneratorKind::RandomGeometric;
+    else if (n == "grid") kind = GeneratorKind::Grid;
+    else if (n == "erdos-renyi" || n == "er" || n == "gnm") kind = GeneratorKind::ErdosRenyi;
+    else return false;
+    return true;
+}
+
+bool parseGeneratorSpec(const std::string &spec, GeneratorParams &params, std::string *error) {
+    auto colon = spec.find(':');
+    if (!parseGeneratorKind(spec.substr(0, colon), params.kind))
+        return fail(error, "unknown generator '" + spec.substr(0, colon) + "'");
+    if (colon == std::string::npos) return true;
+
+    std::istringstream fields(spec.substr(colon + 1));
+    for (std::string field; std::getline(fields, field, ',');) {
+        auto eq = field.find('=');
+        if (eq == std::string::npos) return fail(error, "expected key=value, got '" + field + "'");
+        const std::string key = field.substr(0, eq), value = field.substr(eq + 1);
+
+        try {
+            std::size_t used = 0;
+            // counts may be written like 1e6; casting a negative or huge double is undefined
+            auto count = [&]() {
+                const double n = std::stod(value, &used);
+                if (!(n >= 0 && n < (double)std::numeric_limits<std::size_t>::max())) throw std::out_of_range(value);
+                return (std::size_t)n;
+            };
+            if (key == "nodes") params.nodes = count();
+            else if (key == "edges") params.edges = count();
+            else if (key == "m") params.edgesPerNode = (std::size_t)std::stoull(value, &used);
+            else if (key == "a") params.rmatA = std::stod(value, &used);
+            else if (key == "b") params.rmatB = std::stod(value, &used);
+            else if (key == "c") params.rmatC = std::stod(value, &used);
+            else if (key == "directed") params.directed = std::stoi(value, &used) != 0;
+            else if (key == "wmin") params.minWeight = std::stoi(value, &used);
+            else if (key == "wmax") params.maxWeight = std::stoi(value, &used);
+            else if (key == "seed") params.seed = std::stoull(value, &used);
+            else if (key == "threads") params.threads = (unsigned)std::stoul(value, &used);
+            else return fail(error, "unknown generator option '" + key + "'");
+            if (used != value.size()) throw std::invalid_argument(value);
+        } catch (...) {
+            return fail(error, "bad value for '" + key + "': '" + value + "'");
+        }
+    }
+    return true;
+}
+
+bool generateEdges(const GeneratorParams &params, EdgeList &out, std::string *error) {
+    if (!validate(params, error)) return false;
+
+    out = EdgeList();
+    out.nodeCount = params.nodes;
+    out.directed = params.directed;
+
+    switch (params.kind) {
+    case GeneratorKind::RMat:
+        if (!rmat(params, out))
+            return fail(error, "R-MAT probabilities almost never give an edge between two of the nodes; raise b or c");
+        break;
+    case GeneratorKind::BarabasiAlbert:  barabasiAlbert(params, out); break;
+    case GeneratorKind::RandomGeometric: randomGeometric(params, out); break;
+    case GeneratorKind::Grid:            grid(params, out); break;
+    case GeneratorKind::ErdosRenyi:      erdosRenyi(params, out); break;
+    }
+    return true;
+}
+
+void toGraph(const EdgeList &edges, Graph &graph) {
+    graph.clear();
+    for (std::size_t v = 0; v < edges.nodeCount; ++v) graph.addNode(std::to_string(v));
+    for (std::size_t e = 0; e < edges.size(); ++e)
+        graph.addEdge(edges.from[e], edges.to[e], edges.weights[e], edges.directed);
+}
+
+CsrGraph toCsr(const EdgeList &edges, unsigned threads) {
+    std::vector<std::string> names(edges.nodeCount);
+    parallelChunks(names.size(), ChunkSize, threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t v = begin; v < end; ++v) names[v] = std::to_string(v);
+    });
+    return CsrGraph(std::move(names),
+                    Span<NodeId>(edges.from.data(), edges.size()),
+                    Span<NodeId>(edges.to.data(), edges.size()),
+                    Span<int>(edges.weights.data(), edges.size()),
+                    edges.directed);
+}
+
+bool generateGraph(const GeneratorParams &params, Graph &graph, std::string *error) {
+    EdgeList edges;
+    if (!generateEdges(params, edges, error)) return false;
+    toGraph(edges, graph);
+    return true;
+}
@@ -0,0 +1,72 @@
+#ifndef GENERATORS_HPP
+#define GENERATORS_HPP
+
+#include "Graph.hpp"
+#include "CsrGraph.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Synthetic graph generators. Output is a flat edge list over vertices
+// 0..nodes-1 (named "0", "1", ...) that can be turned into a Graph for the
+// GUI or straight into a CsrGraph for batch runs and benchmarks.
+//
+// Generation is split into fixed-size chunks with their own seeded random
+// streams and spread over std::threads, so the same parameters give the
+// same graph whatever the thread count.
+
+enum class GeneratorKind {
+    RMat,            // recursive matrix (stochastic Kronecker, 2x2 initiator)
+    BarabasiAlbert,  // preferential attachment
+    RandomGeometric, // unit square, edge between points closer than a radius
+    Grid,            // 2D lattice, ceil(sqrt(nodes)) columns
+    ErdosRenyi,      // G(n, m): m uniformly random edges
+};
+
+struct GeneratorParams {
+    GeneratorKind kind = GeneratorKind::ErdosRenyi;
+    std::size_t nodes = 100;
+    std::size_t edges = 400;         // R-MAT, Erdos-Renyi; expected count for random geometric
+    std::size_t edgesPerNode = 4;    // Barabasi-Albert
+    double rmatA = 0.57, rmatB = 0.19, rmatC = 0.19; // R-MAT quadrant odds (d = the rest)
+    bool directed = false;
+    int minWeight = 1;
+    int maxWeight = 100;
+    std::uint64_t seed = 1;
+    unsigned threads = 0;            // 0 = all cores
+};
+
+struct EdgeList {
+    std::size_t nodeCount = 0;
+    bool directed = false;
+    std::vector<NodeId> from;
+    std::vector<NodeId> to;
+    std::vector<int> weights;
+    // where the generator placed each vertex (grid, random geometric);
+    // empty for the families without a layout
+    std::vector<Point> coordinates;
+
+    std::size_t size() const { return from.size(); }
+};
+
+// "rmat", "barabasi-albert", "geometric", "grid", "erdos-renyi"
+const char *generatorName(GeneratorKind kind);
+bool parseGeneratorKind(const std::string &name, GeneratorKind &kind);
+
+// Parse "kind[:key=value,...]" (keys: nodes, edges, m, a, b, c, directed,
+// wmin, wmax, seed, threads) on top of the defaults already in params.
+bool parseGeneratorSpec(const std::string &spec, GeneratorParams &params, std::string *error = nullptr);
+
+// Fill out with a fresh graph; false (and error) when params are invalid
+bool generateEdges(const GeneratorParams &params, EdgeList &out, std::string *error = nullptr);
+
+// Replace graph's contents with the edge list
+void toGraph(const EdgeList &edges, Graph &graph);
+
+// Snapshot with the same vertex/arc order toGraph() + CsrGraph(graph) would give
+CsrGraph toCsr(const EdgeList &edges, unsigned threads = 0);
+
+// generateEdges() followed by toGraph()
+bool generateGraph(const GeneratorParams &params, Graph &graph, std::string *error = nullptr);
+
+#endif // GENERATORS_HPP
@@ -1,11 +1,17 @@
 #include "Graph.hpp"
 #include <algorithm>
 
-// Add a node to the adjacency map if it doesn't already exist
-void Graph::addNode(const std::string &id) {
-    if (adjacency.find(id) == adjacency.end()) {
-        adjacency[id] = std::vector<Edge>{};
-    }
+// Intern a node name if it doesn't already exist
+NodeId Graph::addNode(const std::string &name) {
+    auto it = ids.find(name);
+    if (it != ids.end()) return it->second;
+
+    NodeId id = (NodeId)names.size();
+    ++changes;
+    names.push_back(name);
+    ids.emplace(name, id);
+    adjacency.emplace_back();
+    return id;
 }
 
 // Add an edge (optionally weighted, optionally directed).
@@ -13,86 +19,94 @@ void Graph::addNode(const std::string &id) {
 void Graph::addEdge(const std::string &from, const std::string &to,
                     std::optional<int> weight, bool directed) {
     // ensure both nodes exist
-    addNode(from);
-    addNode(to);
+    addEdge(addNode(from), addNode(to), weight, directed);
+}
 
+void Graph::addEdge(NodeId u, NodeId v, std::optional<int> weight, bool directed) {
     Edge e;
-    e.from = from;
-    e.to = to;
+    e.from = u;
+    e.to = v;
     e.weight = weight;
     e.directed = directed;
 
-    adjacency[from].push_back(e);
+    ++changes;
+    adjacency[u].push_back(e);
 
     // If the edge is undirected, also add reverse edge (with directed=false).
     if (!directed) {
         Edge rev;
-        rev.from = to;
-        rev.to = from;
+        rev.from = v;
+        rev.to = u;
         rev.weight = weight;
         rev.directed = false;
-        adjacency[to].push_back(rev);
+        adjacency[v].push_back(rev);
     }
 }
 
 void Graph::removeEdge(const std::string &from, const std::string &to, bool directed)
 {
-    auto itFrom = adjacency.find(from);
-    auto itTo = adjacency.find(to);
-    if(itFrom != adjacency.end()) {
-        itFrom->second.erase(std::remove_if(itFrom->second.begin(), itFrom->second.end(),
-                                           [&](const Edge &e){ return e.to == to; }),
-                             itFrom->second.end());
-    }
-    if(!directed && itTo != adjacency.end()) {
-        itTo->second.erase(std::remove_if(itTo->second.begin(), itTo->second.end(),
-                                         [&](const Edge &e){ return e.to == from; }),
-                           itTo->second.end());
+    NodeId u = id(from);
+    NodeId v = id(to);
+    if (u == InvalidNode || v == InvalidNode) return;
+
+    ++changes;
+    auto &outU = adjacency[u];
+    outU.erase(std::remove_if(outU.begin(), outU.end(),
+                              [&](const Edge &e){ return e.to == v; }),
+               outU.end());
+    if (!directed) {
+        auto &outV = adjacency[v];
+        outV.erase(std::remove_if(outV.begin(), outV.end(),
+                                  [&](const Edge &e){ return e.to == u; }),
+                   outV.end());
     }
 }
 
-bool Graph::hasNode(const std::string &id) const {
-    return adjacency.find(id) != adjacency.end();
+bool Graph::hasNode(const std::string &name) const {
+    return ids.find(name) != ids.end();
 }
 
-std::vector<std::string> Graph::nodes() const {
-    std::vector<std::string> out;
-    out.reserve(adjacency.size());
-    for (const auto &p : adjacency) {
-        out.push_back(p.first);
-    }
-    return out;
+NodeId Graph::id(const std::string &name) const {
+    auto it = ids.find(name);
+    return it == ids.end() ? InvalidNode : it->second;
 }
 
-std::vector<Edge> Graph::edges() const {
-    std::vector<Edge> out;
-    out.reserve(64);
+Graph::EdgeRange::iterator::iterator(const Graph *graph, std::size_t node, std::size_t index)
+    : graph(graph), node(node), index(index) {
+    settle();
+}
 
-    for (const auto &pair : adjacency) {
-        const std::string &u = pair.first;
-        for (const auto &e : pair.second) {
+void Graph::EdgeRange::iterator::settle() {
+    const auto &adjacency = graph->adjacency;
+    while (node < adjacency.size()) {
+        const auto &list = adjacency[node];
+        for (; index < list.size(); ++index) {
+            const Edge &e = list[index];
             // For directed edges: include as-is.
-            if (e.directed) {
-                out.push_back(e);
-            } else {
-                // For undirected edges we've stored both directions in adjacency.
-                // To avoid returning duplicates, only include the edge where from <= to lexicographically.
-                if (e.from <= e.to) {
-                    out.push_back(e);
-                }
-            }
+            // For undirected edges we've stored both directions in adjacency.
+            // To avoid returning duplicates, only include the edge where from <= to lexicographically.
+            if (e.directed || graph->names[e.from] <= graph->names[e.to]) return;
         }
+        ++node;
+        index = 0;
     }
-    return out;
+    index = 0; // canonical end position
+}
+
+Span<Edge> Graph::neighbors(const std::string &name) const {
+    return neighbors(id(name));
 }
 
-std::vector<Edge> Graph::neighbors(const std::string &id) const {
-    auto it = adjacency.find(id);
-    if (it == adjacency.end()) return {};
-    return it->second; // copy
+Span<Edge> Graph::neighbors(NodeId id) const {
+    if (id >= adjacency.size()) return {};
+    const auto &list = adjacency[id];
+    return Span<Edge>(list.data(), list.size());
 }
 
 void Graph::clear()
 {
+    ++changes;
+    names.clear();
+    ids.clear();
     adjacency.clear();
 }
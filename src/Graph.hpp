@@ -1,38 +1,132 @@
 #ifndef GRAPH_HPP
 #define GRAPH_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
 #include <string>
 #include <unordered_map>
 #include <vector>
 #include <optional>
 
+// Dense node identifier handed out by Graph's interning table
+using NodeId = std::uint32_t;
+constexpr NodeId InvalidNode = std::numeric_limits<NodeId>::max();
+
 struct Edge {
-    std::string from;
-    std::string to;
+    NodeId from;
+    NodeId to;
     std::optional<int> weight;
     bool directed;
 };
 
+// Position of a node in the plane (generator layouts, the GUI's drawing)
+struct Point {
+    double x = 0;
+    double y = 0;
+};
+
+// Non-owning view over a contiguous array (std::span stand-in for C++17).
+// Valid until the owning Graph is next mutated.
+template <typename T>
+class Span {
+public:
+    Span() = default;
+    Span(const T *first, std::size_t count) : first(first), count(count) {}
+
+    const T *begin() const { return first; }
+    const T *end() const { return first + count; }
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const T &operator[](std::size_t i) const { return first[i]; }
+
+private:
+    const T *first = nullptr;
+    std::size_t count = 0;
+};
+
 class Graph {
 public:
-    void addNode(const std::string &id);
+    // Forward range over every edge, reporting undirected edges once.
+    // Walks the adjacency lists in place; valid until the Graph is mutated.
+    class EdgeRange {
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Edge;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const Edge*;
+            using reference = const Edge&;
+
+            iterator(const Graph *graph, std::size_t node, std::size_t index);
+
+            reference operator*() const { return graph->adjacency[node][index]; }
+            pointer operator->() const { return &**this; }
+            iterator &operator++() { ++index; settle(); return *this; }
+            iterator operator++(int) { iterator old = *this; ++*this; return old; }
+            bool operator==(const iterator &o) const { return node == o.node && index == o.index; }
+            bool operator!=(const iterator &o) const { return !(*this == o); }
+
+        private:
+            // advance to the next edge that should be reported (or end)
+            void settle();
+
+            const Graph *graph;
+            std::size_t node;
+            std::size_t index;
+        };
+
+        explicit EdgeRange(const Graph *graph) : graph(graph) {}
+        iterator begin() const { return iterator(graph, 0, 0); }
+        iterator end() const { return iterator(graph, graph->adjacency.size(), 0); }
+
+    private:
+        const Graph *graph;
+    };
+
+    // Returns the node's id (existing id if the name is already known)
+    NodeId addNode(const std::string &name);
 
     void addEdge(const std::string &from, const std::string &to,
                  std::optional<int> weight = std::nullopt,
                  bool directed = false);
 
+    // Same, for nodes that already exist (no name lookups)
+    void addEdge(NodeId from, NodeId to, std::optional<int> weight = std::nullopt,
+                 bool directed = false);
+
     void removeEdge(const std::string &from, const std::string &to, bool directed = false);
 
 
-    bool hasNode(const std::string &id) const;
-    std::vector<std::string> nodes() const;
-    std::vector<Edge> edges() const;
-    std::vector<Edge> neighbors(const std::string &id) const;
+    bool hasNode(const std::string &name) const;
+
+    // Name <-> id resolution; id() returns InvalidNode for unknown names
+    NodeId id(const std::string &name) const;
+    const std::string &name(NodeId id) const { return names[id]; }
+    std::size_t nodeCount() const { return names.size(); }
+
+    // Zero-copy accessors: views into the graph's own storage
+    const std::vector<std::string> &nodes() const { return names; } // indexed by NodeId
+    EdgeRange edges() const { return EdgeRange(this); }
+    Span<Edge> neighbors(const std::string &name) const;
+    Span<Edge> neighbors(NodeId id) const;
 
     void clear();
 
+    // Bumped by every change to the nodes or edges (never reset, not even
+    // by clear()), so a cache built from the graph can tell it is stale
+    std::uint64_t revision() const { return changes; }
+
 private:
-    std::unordered_map<std::string, std::vector<Edge>> adjacency;
+    // Interning table: names[id] is the node name, ids maps it back.
+    // Ids are dense and stable until clear().
+    std::vector<std::string> names;
+    std::unordered_map<std::string, NodeId> ids;
+
+    std::vector<std::vector<Edge>> adjacency; // indexed by NodeId
+    std::uint64_t changes = 0;
 };
 
 #endif // GRAPH_HPP
@@ -0,0 +1,123 @@
+#include "GraphIO.hpp"
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+static std::string trim(const std::string &s) {
+    const char *ws = " \t\r\n";
+    auto first = s.find_first_not_of(ws);
+    if (first == std::string::npos) return {};
+    auto last = s.find_last_not_of(ws);
+    return s.substr(first, last - first + 1);
+}
+
+static bool parseInt(const std::string &s, int &out) {
+    try {
+        std::size_t used = 0;
+        long v = std::stol(s, &used);
+        if (used != s.size() || v < std::numeric_limits<int>::min() || v > std::numeric_limits<int>::max())
+            return false;
+        out = (int)v;
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+static bool parseDirected(const std::string &s, bool &out) {
+    if (s == "d" || s == "directed" || s == "yes" || s == "Yes" || s == "1") { out = true; return true; }
+    if (s == "u" || s == "undirected" || s == "no" || s == "No" || s == "0") { out = false; return true; }
+    return false;
+}
+
+// "A -> B Weight: 3 Directed: Yes" (as written by MainWindow's Save Output)
+static bool parseSavedEdge(const std::string &line, Graph &graph) {
+    auto arrow = line.find(" -> ");
+    auto weightAt = line.rfind(" Weight: ");
+    auto directedAt = line.rfind(" Directed: ");
+    if (arrow == std::string::npos || weightAt == std::string::npos ||
+        directedAt == std::string::npos || !(arrow < weightAt && weightAt < directedAt))
+        return false;
+
+    std::string from = line.substr(0, arrow);
+    std::string to = line.substr(arrow + 4, weightAt - arrow - 4);
+    std::string weightText = trim(line.substr(weightAt + 9, directedAt - weightAt - 9));
+    std::string directedText = trim(line.substr(directedAt + 11));
+
+    int weight = 0;
+    bool directed = false;
+    if (from.empty() || to.empty() || !parseInt(weightText, weight) || !parseDirected(directedText, directed))
+        return false;
+
+    graph.addEdge(from, to, weight, directed);
+    return true;
+}
+
+// "from to [weight] [directed]" or a single node name
+static bool parseListEdge(const std::string &line, Graph &graph) {
+    std::istringstream fields(line);
+    std::vector<std::string> tokens;
+    for (std::string t; fields >> t;) tokens.push_back(t);
+
+    if (tokens.size() == 1) {
+        graph.addNode(tokens[0]);
+        return true;
+    }
+    if (tokens.size() < 2 || tokens.size() > 4) return false;
+
+    std::optional<int> weight;
+    bool directed = false;
+    if (tokens.size() >= 3) {
+        int w = 0;
+        if (parseInt(tokens[2], w)) weight = w;
+        else if (tokens.size() == 3 && parseDirected(tokens[2], directed)) {} // "from to d"
+        else return false;
+    }
+    if (tokens.size() == 4 && !parseDirected(tokens[3], directed)) return false;
+
+    graph.addEdge(tokens[0], tokens[1], weight, directed);
+    return true;
+}
+
+bool readGraph(std::istream &in, Graph &graph, std::string *error) {
+    enum class Section { EdgeList, Nodes, Edges, Done };
+    Section section = Section::EdgeList;
+
+    std::string raw;
+    for (std::size_t lineNo = 1; section != Section::Done && std::getline(in, raw); ++lineNo) {
+        std::string line = trim(raw);
+        if (line.empty() || line[0] == '#') continue;
+
+        // Section headers of the GUI's saved format
+        if (line == "Nodes:") { section = Section::Nodes; continue; }
+        if (line == "Edges:") { section = Section::Edges; continue; }
+        if (line == "Adjacency List:" || line == "Algorithm Output:") { section = Section::Done; continue; }
+
+        bool ok = true;
+        switch (section) {
+        case Section::Nodes:    graph.addNode(line); break;
+        case Section::Edges:    ok = parseSavedEdge(line, graph); break;
+        case Section::EdgeList: ok = parseListEdge(line, graph); break;
+        case Section::Done:     break;
+        }
+        if (!ok) {
+            if (error) *error = "line " + std::to_string(lineNo) + ": cannot parse \"" + line + "\"";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool loadGraph(const std::string &path, Graph &graph, std::string *error) {
+    std::ifstream in(path);
+    if (!in) {
+        if (error) *error = "cannot open " + path;
+        return false;
+    }
+    if (!readGraph(in, graph, error)) {
+        if (error) *error = path + ": " + *error;
+        return false;
+    }
+    return true;
+}
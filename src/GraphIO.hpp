@@ -0,0 +1,25 @@
+#ifndef GRAPHIO_HPP
+#define GRAPHIO_HPP
+
+#include "Graph.hpp"
+#include <istream>
+#include <string>
+
+// Graph files understood by the loaders:
+//
+//  * the "Save Output" text written by the GUI (Nodes: / Edges: sections,
+//    edges as "A -> B Weight: 3 Directed: Yes"); the adjacency list and
+//    algorithm output that follow are ignored
+//  * a plain edge list, one edge per line: "from to [weight] [directed]"
+//    where directed is one of d / directed / yes / 1; a line with a single
+//    name adds an isolated node
+//
+// Blank lines and lines starting with '#' are skipped. Names in the edge
+// list form cannot contain whitespace.
+
+// Read into graph (appending to what it already holds).
+// On failure returns false and, if error is given, describes the first bad line.
+bool readGraph(std::istream &in, Graph &graph, std::string *error = nullptr);
+bool loadGraph(const std::string &path, Graph &graph, std::string *error = nullptr);
+
+#endif // GRAPHIO_HPP
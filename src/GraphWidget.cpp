@@ -1,53 +1,129 @@
 // GraphWidget.cpp
 #include "GraphWidget.hpp"
-#include <QGraphicsTextItem>
 #include <QResizeEvent>
+#include <QWheelEvent>
 #include <QPen>
 #include <QBrush>
 #include <QtMath>
+#include <algorithm>
+#include <functional>
 
 // small helper to compare points with tolerance
 static bool pointsNear(const QPointF &a, const QPointF &b, double tol = 1.5) {
     return qAbs(a.x() - b.x()) <= tol && qAbs(a.y() - b.y()) <= tol;
 }
 
+static const double NodeRadius = 26.0;
+static const double NodeSpacing = 50.0; // spiral scale: about 90px between neighbouring nodes
+static const double EdgeLength = 90.0;  // what the layout aims for, about the spiral's spacing
+
+// Where node `id` is drawn: a sunflower spiral, which fills a disc evenly
+// and places each node by its id alone, so adding nodes never moves the
+// ones already drawn
+static QPointF spiralPosition(NodeId id) {
+    const double goldenAngle = M_PI * (3.0 - qSqrt(5.0));
+    const double radius = NodeSpacing * qSqrt(id + 0.5);
+    return QPointF(radius * qCos(id * goldenAngle), radius * qSin(id * goldenAngle));
+}
+
+static std::uint64_t pairKey(NodeId from, NodeId to) {
+    return (std::uint64_t)from << 32 | to;
+}
+
+// Whether the graph's edge list reports e (undirected edges are stored at
+// both ends and reported once, see Graph::EdgeRange)
+static bool reportedEdge(const Graph &graph, const Edge &e) {
+    return e.directed || graph.name(e.from) <= graph.name(e.to);
+}
+
 GraphWidget::GraphWidget(QWidget *parent)
     : QGraphicsView(parent), scene(new QGraphicsScene(this)) {
 
     setScene(scene);
     setRenderHint(QPainter::Antialiasing);
+    setTransformationAnchor(QGraphicsView::AnchorUnderMouse);
+    setDragMode(QGraphicsView::ScrollHandDrag);
+    // items move every layout frame; a BSP index would be rebuilt each time
+    scene->setItemIndexMethod(QGraphicsScene::NoIndex);
+
+    nodes = new NodeLayer(NodeRadius);
+    nodes->setZValue(2.0); // above edges
+    scene->addItem(nodes);
+    edges = new EdgeLayer(nodes);
+    scene->addItem(edges);
 
     // Initialize theme-aware visuals
     setTheme(isDarkMode);
 
+    layoutTimer = new QTimer(this);
+    connect(layoutTimer, &QTimer::timeout, this, &GraphWidget::applyLayout);
+
     // note: MainWindow drives timing; GraphWidget processes messages immediately
 }
 
 void GraphWidget::setGraph(const Graph &graph) {
-    currentGraph = graph;
+    this->graph = &graph;
     drawGraph();
 }
 
-void GraphWidget::animateSteps(const std::vector<std::string> &steps) {
-    // Process messages immediately (MainWindow controls timing)
-    for (const auto &s : steps) {
-        processMessage(QString::fromStdString(s));
+void GraphWidget::addNewNodes() {
+    if (!graph) return;
+    std::vector<NodeId> added;
+    for (NodeId id = drawNewNodes(); id < nodes->size(); ++id) added.push_back(id);
+    refineLayout(std::move(added));
+}
+
+void GraphWidget::edgesChanged(NodeId u, NodeId v) {
+    if (!graph || u >= graph->nodeCount() || v >= graph->nodeCount()) return;
+    std::vector<NodeId> touched{u, v};
+    for (NodeId id = drawNewNodes(); id < nodes->size(); ++id) touched.push_back(id);
+
+    // Highest slot first, so the edge moved into a freed slot is never
+    // one still to be removed
+    std::vector<std::size_t> stale;
+    auto collect = [&](const std::unordered_multimap<std::uint64_t, std::size_t> &index, std::uint64_t key) {
+        auto range = index.equal_range(key);
+        for (auto it = range.first; it != range.second; ++it) stale.push_back(it->second);
+    };
+    collect(undirectedEdgeIndex, pairKey(std::min(u, v), std::max(u, v)));
+    collect(directedEdgeIndex, pairKey(u, v));
+    if (u != v) collect(directedEdgeIndex, pairKey(v, u));
+    std::sort(stale.begin(), stale.end(), std::greater<std::size_t>());
+    for (std::size_t i : stale) removeEdgeVisual(i);
+
+    // What the full redraw would show between them: u's edges to v, and
+    // v's to u
+    for (const Edge &e : graph->neighbors(u))
+        if (e.to == v && reportedEdge(*graph, e)) drawEdge(e);
+    if (u != v) {
+        for (const Edge &e : graph->neighbors(v))
+            if (e.to == u && reportedEdge(*graph, e)) drawEdge(e);
     }
+    refineLayout(std::move(touched));
 }
 
 void GraphWidget::clearGraph() {
-    // Remove all items from the scene, then clear our maps/vectors
-    scene->clear();
-
-    nodeItems.clear();
-    nodeLabels.clear();
-    edgeItems.clear();
+    stopLayout();
+
+    // the two layers stay in the scene; only what they draw goes
+    nodes->clear();
+    edges->clear();
+    directedEdgeIndex.clear();
+    undirectedEdgeIndex.clear();
+    adjacent.clear();
+    scene->setSceneRect(QRectF()); // back to following the items
+    userZoomed = false;
 }
 
 void GraphWidget::reset() {
     clearGraph();
-    Messages.clear();
-    currentStep = 0;
+}
+
+void GraphWidget::resetHighlights() {
+    // revert nodes and labels to normal
+    nodes->setColors(themeManager.nodeColor(isDarkMode), themeManager.textColor(isDarkMode));
+    // revert edges to normal
+    edges->resetStyles(themeManager.edgeColor(isDarkMode));
 }
 
 void GraphWidget::setTheme(bool darkMode) {
@@ -57,334 +133,333 @@ void GraphWidget::setTheme(bool darkMode) {
     scene->setBackgroundBrush(themeManager.backgroundColor(isDarkMode));
 
     // Recolor nodes & labels & edges
-    for (auto &p : nodeItems) {
-        if (p.second) p.second->setBrush(themeManager.nodeColor(isDarkMode));
-    }
-    for (auto &p : nodeLabels) {
-        if (p.second) p.second->setDefaultTextColor(themeManager.textColor(isDarkMode));
-    }
-    for (auto &ve : edgeItems) {
-        if (ve.line) ve.line->setPen(QPen(themeManager.edgeColor(isDarkMode), 2));
-        if (ve.arrow) {
-            ve.arrow->setBrush(themeManager.edgeColor(isDarkMode));
-            ve.arrow->setPen(QPen(themeManager.edgeColor(isDarkMode)));
-        }
+    resetHighlights();
+}
+
+std::vector<Point> GraphWidget::nodePositions() const {
+    std::vector<Point> positions(nodes->size());
+    for (std::size_t id = 0; id < nodes->size(); ++id) {
+        QPointF center = nodes->positionOf(id);
+        positions[id] = {center.x(), center.y()};
     }
+    return positions;
 }
 
 void GraphWidget::resizeEvent(QResizeEvent *event) {
     QGraphicsView::resizeEvent(event);
-    if (!scene->items().isEmpty()) {
+    if (!userZoomed && nodes->size() > 0) {
         fitInView(scene->itemsBoundingRect(), Qt::KeepAspectRatio);
     }
 }
 
+void GraphWidget::wheelEvent(QWheelEvent *event) {
+    // one notch (120) zooms by 15%
+    const double factor = std::pow(1.15, event->angleDelta().y() / 120.0);
+    scale(factor, factor);
+    userZoomed = true;
+    event->accept();
+}
+
 void GraphWidget::drawGraph() {
     clearGraph();
 
-    auto nodes = currentGraph.nodes();
-    int n = (int)nodes.size();
+    int n = graph ? (int)graph->nodeCount() : 0;
     if (n == 0) return;
 
-    // circle layout
-    double radius = qMin(width(), height()) / 2.7;
-    double cx = width() / 2.0;
-    double cy = height() / 2.0;
-    double angleStep = 2.0 * M_PI / n;
-
-    int i = 0;
-    for (const auto &node : nodes) {
-        double angle = i * angleStep;
-        double x = cx + radius * qCos(angle);
-        double y = cy + radius * qSin(angle);
-        drawNode(node, x, y);
-        ++i;
+    for (NodeId id = 0; id < (NodeId)n; ++id) {
+        nodes->add(spiralPosition(id), QString::fromStdString(graph->name(id)));
     }
+    adjacent.assign(n, {});
 
-    for (const auto &edge : currentGraph.edges()) {
+    for (const auto &edge : graph->edges()) {
         drawEdge(edge);
     }
 
     // ensure everything fits
     scene->setSceneRect(scene->itemsBoundingRect().adjusted(-40, -40, 40, 40));
-    fitInView(scene->sceneRect(), Qt::KeepAspectRatio);
-}
-
-void GraphWidget::drawNode(const std::string &id, double x, double y) {
-    const int r = 26;
-
-    // ellipse
-    auto *ellipse = scene->addEllipse(x - r, y - r, 2 * r, 2 * r,
-                                      QPen(Qt::black, 2),
-                                      QBrush(themeManager.nodeColor(isDarkMode)));
-    // set z so it's above edges
-    ellipse->setZValue(2.0);
+    fitScene();
 
-    nodeItems[id] = ellipse;
+    // the spiral is only the starting point
+    startLayout();
+}
 
-    // label centered
-    auto *label = scene->addText(QString::fromStdString(id));
-    QRectF bounds = label->boundingRect();
-    label->setPos(x - bounds.width() / 2.0, y - bounds.height() / 2.0);
-    label->setDefaultTextColor(themeManager.textColor(isDarkMode));
-    label->setZValue(3.0);
+NodeId GraphWidget::drawNewNodes() {
+    const NodeId first = (NodeId)nodes->size();
+    if (!graph || graph->nodeCount() <= first) return first;
 
-    nodeLabels[id] = label;
+    QRectF added;
+    for (NodeId id = first; id < graph->nodeCount(); ++id) {
+        QPointF at = spiralPosition(id);
+        nodes->add(at, QString::fromStdString(graph->name(id)));
+        added |= QRectF(at.x() - NodeRadius, at.y() - NodeRadius, 2 * NodeRadius, 2 * NodeRadius);
+    }
+    adjacent.resize(nodes->size());
+    growScene(added);
+    return first;
 }
 
 void GraphWidget::drawEdge(const Edge &edge) {
-    if (!nodeItems.count(edge.from) || !nodeItems.count(edge.to)) return;
-
-    QPointF p1 = nodeItems[edge.from]->rect().center() + nodeItems[edge.from]->pos();
-    QPointF p2 = nodeItems[edge.to]->rect().center() + nodeItems[edge.to]->pos();
-
-    // line
-    QPen pen(themeManager.edgeColor(isDarkMode), 2);
-    auto *line = scene->addLine(QLineF(p1, p2), pen);
-    line->setZValue(0.0); // behind nodes
-
-    VisualEdge ve;
-    ve.line = line;
-    ve.from = edge.from;
-    ve.to = edge.to;
-    ve.directed = edge.directed;
-    ve.arrow = nullptr;
-
-    // add arrow polygon for directed edges
-    if (edge.directed) {
-        // calculate arrow triangle at p2
-        const double arrowSize = 12.0;
-        QPointF vec = p1 - p2; // pointing from tip to base
-        double len = std::hypot(vec.x(), vec.y());
-        if (len < 1.0) len = 1.0;
-        double ux = vec.x() / len;
-        double uy = vec.y() / len;
-
-        // perpendicular
-        double px = -uy;
-        double py = ux;
-
-        QPointF tip = p2;
-        QPointF base1 = p2 + QPointF(ux * arrowSize + px * (arrowSize * 0.6),
-                                     uy * arrowSize + py * (arrowSize * 0.6));
-        QPointF base2 = p2 + QPointF(ux * arrowSize - px * (arrowSize * 0.6),
-                                     uy * arrowSize - py * (arrowSize * 0.6));
-
-        QPolygonF poly;
-        poly << tip << base1 << base2;
-        auto *arrow = scene->addPolygon(poly, QPen(themeManager.edgeColor(isDarkMode)), QBrush(themeManager.edgeColor(isDarkMode)));
-        // arrow behind nodes but above line so set z slightly higher than line
-        arrow->setZValue(0.5);
-        ve.arrow = arrow;
+    if (edge.from >= nodes->size() || edge.to >= nodes->size()) return;
+    const std::size_t i = edges->add(edge.from, edge.to, edge.directed);
+    edgeIndexFor(i).emplace(edgeIndexKey(i), i);
+    if (edge.from != edge.to) {
+        adjacent[edge.from].push_back(edge.to);
+        adjacent[edge.to].push_back(edge.from);
     }
-
-    edgeItems.push_back(ve);
 }
 
-GraphWidget::VisualEdge* GraphWidget::findVisualEdge(const std::string &from, const std::string &to, bool directed) {
-    for (auto &ve : edgeItems) {
-        if (directed) {
-            if (ve.directed && ve.from == from && ve.to == to) return &ve;
-        } else {
-            // undirected match either orientation
-            if (!ve.directed && ((ve.from == from && ve.to == to) || (ve.from == to && ve.to == from))) return &ve;
-            // also allow matching a directed visual when searching undirected pairs
-            if (ve.directed && ve.from == from && ve.to == to) return &ve;
-            if (ve.directed && ve.from == to && ve.to == from) return &ve;
+void GraphWidget::removeEdgeVisual(std::size_t i) {
+    // Point the index entry at slot `from` to slot `to` (none: drop it)
+    auto refile = [&](std::size_t from, std::size_t to) {
+        auto &index = edgeIndexFor(from);
+        auto range = index.equal_range(edgeIndexKey(from));
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second != from) continue;
+            if (to == NoEdge) index.erase(it);
+            else it->second = to;
+            return;
         }
+    };
+
+    // Drop one mention of b from a's neighbours
+    auto unlink = [&](NodeId a, NodeId b) {
+        std::vector<NodeId> &list = adjacent[a];
+        auto it = std::find(list.begin(), list.end(), b);
+        if (it == list.end()) return;
+        *it = list.back();
+        list.pop_back();
+    };
+
+    const std::size_t last = edges->size() - 1;
+    refile(i, NoEdge);
+    if (i != last) refile(last, i);
+    const NodeId from = edges->from(i), to = edges->to(i);
+    if (from != to) {
+        unlink(from, to);
+        unlink(to, from);
     }
-    return nullptr;
+    edges->remove(i);
 }
 
-void GraphWidget::highlightEdgeVisual(VisualEdge *ve, const QColor &color, int width) {
-    if (!ve) return;
-    if (ve->line) {
-        ve->line->setPen(QPen(color, width));
-    }
-    if (ve->arrow) {
-        ve->arrow->setBrush(QBrush(color));
-        ve->arrow->setPen(QPen(color));
-    }
+std::unordered_multimap<std::uint64_t, std::size_t> &GraphWidget::edgeIndexFor(std::size_t i) {
+    return edges->directed(i) ? directedEdgeIndex : undirectedEdgeIndex;
 }
 
+std::uint64_t GraphWidget::edgeIndexKey(std::size_t i) const {
+    const NodeId from = edges->from(i), to = edges->to(i);
+    if (edges->directed(i)) return pairKey(from, to);
+    return pairKey(std::min(from, to), std::max(from, to));
+}
 
-void GraphWidget::processMessage(const QString &msg) {
+void GraphWidget::growScene(const QRectF &rect) {
+    if (rect.isNull()) return;
+    scene->setSceneRect(scene->sceneRect().united(rect.adjusted(-40, -40, 40, 40)));
+    fitScene();
+}
 
-    // ---- Internal control to RESET colors (used when negative-cycle detected) ----
-    if (msg == "RESET_COLORS") {
-        // revert nodes to normal
-        for (auto &pair : nodeItems) {
-            pair.second->setBrush(themeManager.nodeColor(isDarkMode));
-        }
-        // revert edges to normal
-        for (auto &ve : edgeItems) {
-            if (ve.line) ve.line->setPen(QPen(themeManager.edgeColor(isDarkMode), 2));
-            if (ve.arrow) {
-                ve.arrow->setBrush(themeManager.edgeColor(isDarkMode));
-                ve.arrow->setPen(QPen(themeManager.edgeColor(isDarkMode)));
-            }
-        }
-        // revert labels
-        for (auto &pair : nodeLabels) {
-            pair.second->setDefaultTextColor(themeManager.textColor(isDarkMode));
+void GraphWidget::fitScene() {
+    if (userZoomed) return;
+    fitInView(scene->sceneRect(), Qt::KeepAspectRatio);
+}
+
+void GraphWidget::startLayout() {
+    if (!graph || graph->nodeCount() == 0) return;
+    settling.clear();
+    LayoutOptions options;
+    options.edgeLength = EdgeLength;
+    layoutRunner.start(std::make_shared<const CsrGraph>(*graph), nodePositions(), options);
+    layoutTimer->start(33); // ~30 frames a second
+}
+
+void GraphWidget::refineLayout(std::vector<NodeId> touched) {
+    if (!graph || touched.empty()) return;
+    if (layoutRunner.isRunning()) {
+        // the whole graph is still being laid out: carry on, edit included
+        if (settling.empty()) {
+            startLayout();
+            return;
         }
-        return;
+        touched.insert(touched.end(), settling.begin(), settling.end());
     }
+    std::sort(touched.begin(), touched.end());
+    touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+    settling = touched;
+
+    // The touched nodes and their neighbours move; every edge with a
+    // movable end goes in once, from its smaller movable end
+    LayoutPatch patch;
+    patch.positions = nodePositions();
+    std::vector<char> moves(nodes->size(), 0);
+    auto move = [&](NodeId id) {
+        if (moves[id]) return;
+        moves[id] = 1;
+        patch.movable.push_back(id);
+    };
+    for (NodeId id : touched) {
+        if (id >= nodes->size()) continue;
+        move(id);
+        for (NodeId w : adjacent[id]) move(w);
+    }
+    for (NodeId u : patch.movable)
+        for (NodeId w : adjacent[u])
+            if (!moves[w] || u < w) patch.edges.emplace_back(u, w);
+
+    LayoutOptions options;
+    options.edgeLength = EdgeLength;
+    options.refine = true;
+    layoutRunner.start(std::move(patch), options);
+    layoutTimer->start(33);
+}
 
-    // MST edge step (existing)
-    if (msg.startsWith("Edge added to MST")) {
-        QStringList parts = msg.split(" ");
-        if (parts.size() >= 7) {
-            QString u = parts[4];
-            QString v = parts[6];
-
-            // theme-aware MST highlight
-            QColor mstColor = themeManager.highlightColor(isDarkMode);
+void GraphWidget::stopLayout() {
+    layoutRunner.stop();
+    layoutTimer->stop();
+}
 
-            if (nodeItems.count(u.toStdString()))
-                nodeItems[u.toStdString()]->setBrush(QBrush(mstColor));
-            if (nodeItems.count(v.toStdString()))
-                nodeItems[v.toStdString()]->setBrush(QBrush(mstColor));
+void GraphWidget::applyLayout() {
+    // checked first: once it is over, take() has the last positions
+    const bool running = layoutRunner.isRunning();
+    std::vector<Point> positions;
+    if (layoutRunner.take(positions) && positions.size() == nodes->size()) {
+        nodes->setPositions(positions);
+        edges->nodesMoved();
 
-            // find and highlight the edge visual
-            VisualEdge *ve = findVisualEdge(u.toStdString(), v.toStdString(), false);
-            if (ve) highlightEdgeVisual(ve, mstColor, 3);
-        }
-        return;
+        scene->setSceneRect(nodes->boundingRect().adjusted(-40, -40, 40, 40));
+        fitScene();
     }
+    if (!running) layoutTimer->stop();
+}
 
-    // Cycles - expected exact formats:
-    // "Cycles detected (undirected): A -> B -> C -> D -> A"
-    // "Cycles detected (directed): A -> B -> C -> A"
-    if (msg.startsWith("Cycles detected (undirected):") || msg.startsWith("Cycles detected (directed):")) {
-        bool isDirected = msg.startsWith("Cycles detected (directed):");
+std::size_t GraphWidget::findVisualEdge(NodeId from, NodeId to, bool directed) const {
+    auto lookup = [&](const std::unordered_multimap<std::uint64_t, std::size_t> &index, std::uint64_t key) {
+        auto it = index.find(key);
+        return it == index.end() ? NoEdge : it->second;
+    };
+
+    if (directed) return lookup(directedEdgeIndex, pairKey(from, to));
+    // undirected match either orientation
+    std::size_t edge = lookup(undirectedEdgeIndex, pairKey(std::min(from, to), std::max(from, to)));
+    // also allow matching a directed visual when searching undirected pairs
+    if (edge == NoEdge) edge = lookup(directedEdgeIndex, pairKey(from, to));
+    if (edge == NoEdge) edge = lookup(directedEdgeIndex, pairKey(to, from));
+    return edge;
+}
 
-        // path string after the colon
-        QString pathStr = msg.section(":", 1).trimmed();
+void GraphWidget::setNodeBrush(NodeId id, const QColor &color) {
+    nodes->setColor(id, color);
+}
 
-        // split on "->"
-        QStringList nodes = pathStr.split("->", Qt::SkipEmptyParts);
-        for (QString &n : nodes) n = n.trimmed();
+void GraphWidget::highlightEdgeVisual(std::size_t edge, const QColor &color, int width) {
+    if (edge == NoEdge) return;
+    edges->setStyle(edge, color, width);
+}
 
-        // choose cycle color theme aware (fallback local shades)
-        QColor cycleColor = isDarkMode ? QColor("#ff8a80") : QColor("#d32f2f");
 
-        // highlight nodes
-        for (const QString &n : nodes) {
-            auto key = n.toStdString();
-            if (nodeItems.count(key)) {
-                nodeItems[key]->setBrush(QBrush(cycleColor));
-            }
-        }
+void GraphWidget::animateStep(const StepEvent &step, Span<std::uint32_t> payload) {
+    const QColor highlight = themeManager.highlightColor(isDarkMode);
+    // choose cycle color theme aware (fallback local shades)
+    const QColor cycleColor = isDarkMode ? QColor("#ff8a80") : QColor("#d32f2f");
+    const QColor routeColor = isDarkMode ? QColor("#80d8ff") : QColor("#1565c0");
+
+    switch (step.kind) {
+    // ---- Internal control to RESET colors (used when negative-cycle detected) ----
+    case StepKind::ResetColors:
+        resetHighlights();
+        return;
+
+    // MST edge: theme-aware highlight of both endpoints and the edge visual
+    case StepKind::MstAdd:
+        setNodeBrush(step.u, highlight);
+        setNodeBrush(step.v, highlight);
+        highlightEdgeVisual(findVisualEdge(step.u, step.v, false), highlight, 3);
+        return;
+
+    // Directed cycle: payload is the node sequence, closing node repeated
+    case StepKind::DirectedCycle:
+        for (NodeId n : payload) setNodeBrush(n, cycleColor);
 
         // highlight edges between consecutive nodes
-        for (int i = 0; i < nodes.size() - 1; ++i) {
-            QString u = nodes[i];
-            QString v = nodes[i + 1];
-            VisualEdge *ve = findVisualEdge(u.toStdString(), v.toStdString(), isDirected);
-            if (!ve) {
+        for (std::size_t i = 0; i + 1 < payload.size(); ++i) {
+            std::size_t edge = findVisualEdge(payload[i], payload[i + 1], true);
+            if (edge == NoEdge) {
                 // fallback: try opposite orientation (for undirected visuals)
-                ve = findVisualEdge(v.toStdString(), u.toStdString(), isDirected);
+                edge = findVisualEdge(payload[i + 1], payload[i], true);
             }
-            if (ve) highlightEdgeVisual(ve, cycleColor, 3);
+            highlightEdgeVisual(edge, cycleColor, 3);
         }
+        return;
 
-        // if undirected and path not closed explicitly by arrow list, connect last->first
-        if (!isDirected && nodes.size() > 1) {
-            QString u = nodes.last();
-            QString v = nodes.first();
-            VisualEdge *ve = findVisualEdge(u.toStdString(), v.toStdString(), false);
-            if (!ve) ve = findVisualEdge(v.toStdString(), u.toStdString(), false);
-            if (ve) highlightEdgeVisual(ve, cycleColor, 3);
-        }
+    // Undirected cycle: the back edge that closes it
+    case StepKind::UndirectedCycle:
+        setNodeBrush(step.u, cycleColor);
+        setNodeBrush(step.v, cycleColor);
+        highlightEdgeVisual(findVisualEdge(step.u, step.v, false), cycleColor, 3);
+        return;
 
+    // Shortest-path edge updates (Bellman-Ford / Floyd-Warshall)
+    case StepKind::EdgeHighlight: {
+        setNodeBrush(step.u, highlight);
+        setNodeBrush(step.v, highlight);
+
+        // an undirected lookup matches either orientation
+        highlightEdgeVisual(findVisualEdge(step.u, step.v, false), highlight, 3);
         return;
     }
 
-    // Completed message - do nothing graphical
-    if (msg.startsWith("Cycle Detection Completed") || msg.startsWith("Cycle Detection Completed !")) {
+    // Point-to-point result: every node and edge on the route
+    case StepKind::RouteFound:
+        for (NodeId n : payload) setNodeBrush(n, routeColor);
+        for (std::size_t i = 0; i + 1 < payload.size(); ++i)
+            highlightEdgeVisual(findVisualEdge(payload[i], payload[i + 1], false), routeColor, 4);
         return;
-    }
 
-    // ---- Floyd-Warshall structured update (FW_UPDATE u v k value) ----
-    if (msg.startsWith("FW_UPDATE")) {
-        // Format: "FW_UPDATE u v k <value>"
-        QStringList parts = msg.split(" ", Qt::SkipEmptyParts);
-        if (parts.size() >= 4) {
-            QString u = parts[1];
-            QString v = parts[2];
-            // highlight nodes with theme highlight color
-            if (nodeItems.count(u.toStdString()))
-                nodeItems[u.toStdString()]->setBrush(QBrush(themeManager.highlightColor(isDarkMode)));
-            if (nodeItems.count(v.toStdString()))
-                nodeItems[v.toStdString()]->setBrush(QBrush(themeManager.highlightColor(isDarkMode)));
-
-            // highlight matching visual edge if exists
-            VisualEdge *ve = findVisualEdge(u.toStdString(), v.toStdString(), false);
-            if (!ve) ve = findVisualEdge(v.toStdString(), u.toStdString(), false);
-            if (ve) highlightEdgeVisual(ve, themeManager.highlightColor(isDarkMode), 3);
-        }
+    // Every node on the reported path
+    case StepKind::PathUpdate:
+        for (NodeId n : payload) setNodeBrush(n, highlight);
         return;
-    }
 
-    // Legacy / human-readable variants that GUI previously handled:
-    // "Updated distance: A -> B = 42"
-    if (msg.startsWith("Updated distance:")) {
-        QString after = msg.section(':', 1).trimmed(); // "A -> B = 42"
-        QStringList parts = after.split("->", Qt::SkipEmptyParts);
-        if (parts.size() >= 2) {
-            QString u = parts[0].trimmed();
-            QString right = parts[1].trimmed(); // "B = 42"
-            QString v = right.split('=')[0].trimmed();
-
-            if (nodeItems.count(u.toStdString()))
-                nodeItems[u.toStdString()]->setBrush(QBrush(themeManager.highlightColor(isDarkMode)));
-            if (nodeItems.count(v.toStdString()))
-                nodeItems[v.toStdString()]->setBrush(QBrush(themeManager.highlightColor(isDarkMode)));
-
-            // attempt to find and highlight an edge between u and v (if present)
-            VisualEdge *ve = findVisualEdge(u.toStdString(), v.toStdString(), false);
-            if (!ve) ve = findVisualEdge(v.toStdString(), u.toStdString(), false);
-            if (ve) highlightEdgeVisual(ve, themeManager.highlightColor(isDarkMode), 3);
+    // Every endpoint of the final tree (payload is u, v, weight triples)
+    case StepKind::MstResult:
+        for (std::size_t i = 0; i + 2 < payload.size(); i += 3) {
+            setNodeBrush(payload[i], highlight);
+            setNodeBrush(payload[i + 1], highlight);
         }
         return;
-    }
 
-    // Another legacy form: "Edge update highlight: ...", keep compatibility
-    if (msg.startsWith("Edge update highlight:")) {
-        // format used elsewhere: "Edge update highlight: from A to B" or similar
-        // try to extract capitalized tokens
-        QStringList parts = msg.split(" ", Qt::SkipEmptyParts);
-        // naive extraction: find tokens that are node names (present in nodeItems)
-        QString u, v;
-        for (int i = 0; i < parts.size(); ++i) {
-            QString p = parts[i];
-            if (nodeItems.count(p.toStdString())) {
-                if (u.isEmpty()) u = p;
-                else if (v.isEmpty()) { v = p; break; }
-            }
-        }
-        if (!u.isEmpty() && !v.isEmpty()) {
-            if (nodeItems.count(u.toStdString()))
-                nodeItems[u.toStdString()]->setBrush(QBrush(themeManager.highlightColor(isDarkMode)));
-            if (nodeItems.count(v.toStdString()))
-                nodeItems[v.toStdString()]->setBrush(QBrush(themeManager.highlightColor(isDarkMode)));
-
-            VisualEdge *ve = findVisualEdge(u.toStdString(), v.toStdString(), false);
-            if (!ve) ve = findVisualEdge(v.toStdString(), u.toStdString(), false);
-            if (ve) highlightEdgeVisual(ve, themeManager.highlightColor(isDarkMode), 3);
+    // One strongly connected component: its own hue on its nodes and on
+    // the edges between them
+    case StepKind::StrongComponent: {
+        const QColor color = QColor::fromHsv((int)(step.value * 137 % 360), 160, isDarkMode ? 230 : 210);
+        for (NodeId n : payload) setNodeBrush(n, color);
+        if (payload.size() < 2 || !graph) return;
+        // members come in id order; follow their own edges, not every edge
+        for (NodeId n : payload) {
+            if (n >= graph->nodeCount()) continue;
+            for (const Edge &e : graph->neighbors(n))
+                if (std::binary_search(payload.begin(), payload.end(), e.to))
+                    highlightEdgeVisual(findVisualEdge(n, e.to, e.directed), color, 3);
         }
         return;
     }
 
-    // Fallback: other messages (DFS/BFS/Dijkstra steps) may mention nodes.
-    // We highlight any node names mentioned by the message (e.g. "Visited: A")
-    for (const auto &pair : nodeItems) {
-        const QString nodeName = QString::fromStdString(pair.first);
-        if (msg.contains(nodeName)) {
-            // small persistent highlight (use theme highlight color)
-            QColor col = themeManager.highlightColor(isDarkMode);
-            pair.second->setBrush(QBrush(col));
-        }
+    // Traversal steps: small persistent highlight on the node they mention
+    case StepKind::Started:
+    case StepKind::Visited:
+    case StepKind::Queued:
+    case StepKind::Processing:
+    case StepKind::DistanceUpdate:
+        setNodeBrush(step.u, highlight);
+        return;
+
+    case StepKind::MstConsider:
+    case StepKind::MstSkip:
+    case StepKind::MstReject:
+        setNodeBrush(step.u, highlight);
+        setNodeBrush(step.v, highlight);
+        return;
+
+    // Completed / informational steps - do nothing graphical
+    default:
+        return;
     }
 }
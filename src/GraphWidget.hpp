@@ -2,9 +2,6 @@
 
 #include <QGraphicsView>
 #include <QGraphicsScene>
-#include <QGraphicsEllipseItem>
-#include <QGraphicsLineItem>
-#include <QGraphicsPolygonItem>
 #include <QTimer>
 #include <unordered_map>
 #include <vector>
@@ -12,7 +9,11 @@
 
 #include "Graph.hpp"
 #include "Algorithms.hpp"
+#include "StepLog.hpp"
 #include "ThemeManager.hpp"
+#include "LayoutRunner.hpp"
+#include "NodeLayer.hpp"
+#include "EdgeLayer.hpp"
 
 // GraphWidget: handles drawing and animating the graph visuals
 class GraphWidget : public QGraphicsView {
@@ -21,12 +22,21 @@ class GraphWidget : public QGraphicsView {
 public:
     explicit GraphWidget(QWidget *parent = nullptr);
 
-    // Replace the graph model and redraw
+    // Show `graph` and redraw everything. The widget reads the caller's
+    // graph rather than a copy, so it must stay alive (or be replaced by
+    // another setGraph()) while the widget shows it.
     void setGraph(const Graph &graph);
 
-    // Process one or more step messages (MainWindow sends one step per tick)
-    // Widget will act on each message immediately (highlight nodes/edges, draw arrows, etc.)
-    void animateSteps(const std::vector<std::string> &steps);
+    // Incremental updates after the graph has been edited in place
+    // Draw the nodes the graph gained since they were last drawn
+    void addNewNodes();
+    // Redraw the edges between u and v after some were added or removed
+    // (drawing any nodes the graph gained too)
+    void edgesChanged(NodeId u, NodeId v);
+
+    // Apply one algorithm step (MainWindow sends one step per tick)
+    // Widget acts on it immediately (highlight nodes/edges, reset colors, etc.)
+    void animateStep(const StepEvent &step, Span<std::uint32_t> payload);
 
     // Clear visuals only
     void clearGraph();
@@ -34,53 +44,90 @@ public:
     // Reset widget state
     void reset();
 
+    // Back to the theme's colours after an algorithm's highlights
+    void resetHighlights();
+
     // Apply theme (light/dark)
     void setTheme(bool darkMode);
 
+    // Where each node is drawn, indexed by NodeId (A*'s straight-line
+    // heuristic). Nodes keep moving while the force-directed layout runs.
+    std::vector<Point> nodePositions() const;
+
 protected:
     void resizeEvent(QResizeEvent *event) override;
+    // Zoom about the mouse; the view stops following the layout until the
+    // next full redraw
+    void wheelEvent(QWheelEvent *event) override;
 
 private:
     QGraphicsScene *scene;
-    Graph currentGraph;
+    const Graph *graph = nullptr; // the caller's model, not a copy
     ThemeManager themeManager;
 
-    // Node visuals
-    std::unordered_map<std::string, QGraphicsEllipseItem*> nodeItems;
-    std::unordered_map<std::string, QGraphicsTextItem*> nodeLabels;
+    // Every drawn node, indexed by the graph's NodeId
+    NodeLayer *nodes;
 
-    // Edge visual object groups (line + optional arrow polygon)
-    struct VisualEdge {
-        QGraphicsLineItem *line = nullptr;
-        QGraphicsPolygonItem *arrow = nullptr; // only for directed edges
-        std::string from;
-        std::string to;
-        bool directed = false;
-    };
-    std::vector<VisualEdge> edgeItems;
+    // Every drawn edge (line + arrowhead for directed edges)
+    EdgeLayer *edges;
+    static constexpr std::size_t NoEdge = (std::size_t)-1;
 
-    // Step messages (widget processes immediately when animateSteps is called)
-    std::vector<std::string>  Messages;
-    int currentStep = 0;
+    // edges' indices by endpoints (from << 32 | to), so a step's highlight
+    // costs the same on any graph size. Undirected edges are keyed with
+    // the smaller id first; parallel edges share a key.
+    std::unordered_multimap<std::uint64_t, std::size_t> directedEdgeIndex;
+    std::unordered_multimap<std::uint64_t, std::size_t> undirectedEdgeIndex;
+
+    // Each drawn node's neighbours over the drawn edges, both ways and
+    // without self-loops: the layout's adjacency, kept up to date edit by
+    // edit so a refinement never has to snapshot the graph
+    std::vector<std::vector<NodeId>> adjacent;
 
     // Theme state
     bool isDarkMode = false;
 
+    bool userZoomed = false; // the user zoomed: don't refit the view to the scene
+
+    // Force-directed layout on a worker; layoutTimer moves the nodes to
+    // its latest positions
+    LayoutRunner layoutRunner;
+    QTimer *layoutTimer;
+    // Nodes whose neighbourhood the running refinement settles (empty
+    // while the whole graph is being laid out)
+    std::vector<NodeId> settling;
+
     // Helpers
     void drawGraph();
-    void drawNode(const std::string &id, double x, double y);
+    // Draw the nodes the graph gained; the first new id
+    NodeId drawNewNodes();
     void drawEdge(const Edge &edge);
-
-    // Find visual edge matching endpoints (directed respect direction, undirected match either)
-    VisualEdge* findVisualEdge(const std::string &from, const std::string &to, bool directed);
-
-    // Apply highlight / color to an edge visual (line + arrow)
-    void highlightEdgeVisual(VisualEdge *ve, const QColor &color, int width = 3);
-
-    // Process a single message (previously showNextStep in the earlier commits)
-    void processMessage(const QString &msg);
+    // Delete drawn edge i; the last edge takes its index
+    void removeEdgeVisual(std::size_t i);
+    // The index and key drawn edge i is filed under
+    std::unordered_multimap<std::uint64_t, std::size_t> &edgeIndexFor(std::size_t i);
+    std::uint64_t edgeIndexKey(std::size_t i) const;
+    // Widen the scene to take in `rect` and refit the view
+    void growScene(const QRectF &rect);
+    // Fit the scene into the view (unless the user zoomed)
+    void fitScene();
+    // Lay the whole graph out from where its nodes are now
+    void startLayout();
+    // Settle the drawn layout around an edit: only the touched nodes and
+    // their neighbours move (along with what a running refinement moves)
+    void refineLayout(std::vector<NodeId> touched);
+    void stopLayout();
+
+    // Find the drawn edge matching endpoints (directed respect direction,
+    // undirected match either); NoEdge if there is none
+    std::size_t findVisualEdge(NodeId from, NodeId to, bool directed) const;
+
+    // Paint a drawn node (no-op for ids that aren't drawn)
+    void setNodeBrush(NodeId id, const QColor &color);
+
+    // Apply highlight / color to a drawn edge (line + arrow); NoEdge is ignored
+    void highlightEdgeVisual(std::size_t edge, const QColor &color, int width = 3);
 
 private slots:
-    // kept private slot empty on header to avoid Qt moc issues if needed later
-    void dummySlot() {}
+    // Move the nodes to the layout's latest positions
+    void applyLayout();
 };
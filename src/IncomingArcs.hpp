@@ -0,0 +1,53 @@
+#ifndef INCOMINGARCS_HPP
+#define INCOMINGARCS_HPP
+
+#include "CsrGraph.hpp"
+#include <cstdint>
+#include <vector>
+
+// Arcs entering each vertex of a CsrGraph, for searches that walk the
+// graph backwards (bottom-up BFS, the backward half of bidirectional
+// Dijkstra). Graphs without directed edges list every arc at both ends,
+// so their outgoing arcs are used as they are and nothing is built.
+//
+// The arcs entering v are [begin(v), end(v)); source(i) is where arc i
+// comes from and arc(i) the outgoing arc it mirrors (same weight).
+class IncomingArcs {
+public:
+    using Vertex = CsrGraph::Vertex;
+
+    explicit IncomingArcs(const CsrGraph &graph) : graph(graph) {
+        bool directed = false;
+        for (std::size_t e = 0; e < graph.edgeCount() && !directed; ++e) directed = graph.edgeDirected(e);
+        if (!directed) return;
+
+        const std::size_t n = graph.vertexCount();
+        offsets.assign(n + 1, 0);
+        for (std::size_t a = 0; a < graph.arcCount(); ++a) ++offsets[graph.target(a) + 1];
+        for (std::size_t v = 0; v < n; ++v) offsets[v + 1] += offsets[v];
+        sources.resize(graph.arcCount());
+        arcs.resize(graph.arcCount());
+        std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+        for (Vertex u = 0; u < n; ++u) {
+            for (std::size_t a = graph.arcBegin(u); a < graph.arcEnd(u); ++a) {
+                const std::size_t i = fill[graph.target(a)]++;
+                sources[i] = u;
+                arcs[i] = (std::uint32_t)a;
+            }
+        }
+    }
+
+    std::size_t begin(Vertex v) const { return offsets.empty() ? graph.arcBegin(v) : offsets[v]; }
+    std::size_t end(Vertex v) const { return offsets.empty() ? graph.arcEnd(v) : offsets[v + 1]; }
+    Vertex source(std::size_t i) const { return offsets.empty() ? graph.target(i) : sources[i]; }
+    std::size_t arc(std::size_t i) const { return offsets.empty() ? i : arcs[i]; }
+    int weight(std::size_t i) const { return graph.weight(arc(i)); }
+
+private:
+    const CsrGraph &graph;
+    std::vector<std::size_t> offsets; // empty = same as the outgoing arcs
+    std::vector<Vertex> sources;
+    std::vector<std::uint32_t> arcs;
+};
+
+#endif // INCOMINGARCS_HPP
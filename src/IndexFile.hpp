@@ -0,0 +1,91 @@
+#ifndef INDEXFILE_HPP
+#define INDEXFILE_HPP
+
+#include "CsrGraph.hpp"
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Binary files for the preprocessed indexes (LandmarkIndex,
+// ContractionHierarchy). A file starts with an 8-byte magic naming the
+// index, a format version and the fingerprint of the graph it was built
+// from, followed by length-prefixed arrays of plain structs in the host's
+// byte order: an index is a cache for the machine that built it, not an
+// exchange format.
+
+// Hash of the vertex names and the arcs with their weights. An index only
+// answers queries on a graph with the same fingerprint.
+inline std::uint64_t graphFingerprint(const CsrGraph &graph) {
+    std::uint64_t hash = 0xcbf29ce484222325ULL; // FNV-1a, a word at a time
+    auto mix = [&](std::uint64_t word) {
+        hash ^= word;
+        hash *= 0x100000001b3ULL;
+    };
+    mix(graph.vertexCount());
+    for (const std::string &name : graph.nodes()) {
+        for (unsigned char c : name) mix(c);
+        mix(0x100); // end of name
+    }
+    for (CsrGraph::Vertex v = 0; v < graph.vertexCount(); ++v) {
+        mix(graph.arcEnd(v) - graph.arcBegin(v));
+        for (std::size_t a = graph.arcBegin(v); a < graph.arcEnd(v); ++a)
+            mix((std::uint64_t)graph.target(a) << 32 | (std::uint32_t)graph.weight(a));
+    }
+    return hash;
+}
+
+struct IndexHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t reserved;
+    std::uint64_t fingerprint;
+};
+
+inline void writeIndexHeader(std::ostream &out, const char (&magic)[9], std::uint32_t version,
+                             std::uint64_t fingerprint) {
+    IndexHeader header{};
+    std::memcpy(header.magic, magic, sizeof header.magic);
+    header.version = version;
+    header.fingerprint = fingerprint;
+    out.write(reinterpret_cast<const char *>(&header), sizeof header);
+}
+
+// False (and error) unless the header has this magic and version and
+// was written for `graph`
+inline bool readIndexHeader(std::istream &in, const char (&magic)[9], std::uint32_t version, const CsrGraph &graph,
+                            std::string *error) {
+    auto fail = [&](const char *message) {
+        if (error) *error = message;
+        return false;
+    };
+    IndexHeader header{};
+    if (!in.read(reinterpret_cast<char *>(&header), sizeof header)) return fail("index file is truncated");
+    if (std::memcmp(header.magic, magic, sizeof header.magic) != 0) return fail("not an index file of this kind");
+    if (header.version != version) return fail("index file has an unsupported version");
+    if (header.fingerprint != graphFingerprint(graph)) return fail("index file was built for another graph");
+    return true;
+}
+
+template <typename T>
+void writeIndexArray(std::ostream &out, const std::vector<T> &values) {
+    static_assert(std::is_trivially_copyable<T>::value, "index arrays hold plain data");
+    const std::uint64_t count = values.size();
+    out.write(reinterpret_cast<const char *>(&count), sizeof count);
+    out.write(reinterpret_cast<const char *>(values.data()), (std::streamsize)(count * sizeof(T)));
+}
+
+// Reads at most `limit` elements; false on a longer or truncated array
+template <typename T>
+bool readIndexArray(std::istream &in, std::vector<T> &values, std::uint64_t limit) {
+    static_assert(std::is_trivially_copyable<T>::value, "index arrays hold plain data");
+    std::uint64_t count = 0;
+    if (!in.read(reinterpret_cast<char *>(&count), sizeof count) || count > limit) return false;
+    values.resize((std::size_t)count);
+    return (bool)in.read(reinterpret_cast<char *>(values.data()), (std::streamsize)(count * sizeof(T)));
+}
+
+#endif // INDEXFILE_HPP
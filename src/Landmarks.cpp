@@ -0,0 +1,176 @@
+#include "Landmarks.hpp"
+#include "IncomingArcs.hpp"
+#include "IndexFile.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+
+namespace {
+
+using Vertex = CsrGraph::Vertex;
+constexpr long long Unreachable = PathDistances::Unreachable;
+
+// Dijkstra from root over the outgoing arcs, or over `incoming` for the
+// distances to root
+void distancesFrom(const CsrGraph &graph, const IncomingArcs *incoming, Vertex root, std::vector<long long> &dist) {
+    const std::size_t n = graph.vertexCount();
+    dist.assign(n, Unreachable);
+    RadixHeap<long long> queue(n);
+    dist[root] = 0;
+    queue.push(root, 0);
+    auto relax = [&](Vertex v, long long candidate) {
+        if (candidate >= dist[v]) return;
+        dist[v] = candidate;
+        queue.push(v, candidate);
+    };
+    while (!queue.empty()) {
+        auto [d, u] = queue.pop();
+        if (incoming) {
+            for (std::size_t i = incoming->begin(u); i < incoming->end(u); ++i)
+                relax(incoming->source(i), d + incoming->weight(i));
+        } else {
+            for (std::size_t a = graph.arcBegin(u); a < graph.arcEnd(u); ++a)
+                relax(graph.target(a), d + graph.weight(a));
+        }
+    }
+}
+
+// Column `column` of a vertex-major table; false if a distance doesn't fit
+bool storeColumn(const std::vector<long long> &dist, std::size_t column, std::size_t columns,
+                 std::vector<std::uint32_t> &table) {
+    for (std::size_t v = 0; v < dist.size(); ++v) {
+        if (dist[v] == Unreachable) continue;
+        if (dist[v] >= (long long)UINT32_MAX) return false;
+        table[v * columns + column] = (std::uint32_t)dist[v];
+    }
+    return true;
+}
+
+} // namespace
+
+bool LandmarkIndex::build(const CsrGraph &graph, std::size_t count, RunControl *control, std::string *error) {
+    *this = LandmarkIndex();
+    auto fail = [&](const char *message) {
+        *this = LandmarkIndex();
+        if (error) *error = message;
+        return false;
+    };
+    for (std::size_t a = 0; a < graph.arcCount(); ++a)
+        if (graph.weight(a) < 0) return fail("landmark bounds need non-negative weights");
+
+    const std::size_t n = graph.vertexCount();
+    if (n == 0) return true;
+    const std::size_t k = std::max<std::size_t>(1, std::min(count, n));
+    bool directed = false;
+    for (std::size_t e = 0; e < graph.edgeCount() && !directed; ++e) directed = graph.edgeDirected(e);
+
+    // Farthest-first: start from the vertex farthest from vertex 0, then
+    // repeatedly take the one farthest from its nearest landmark (never
+    // reached counts as farthest, so every component gets its landmarks)
+    std::vector<long long> dist, nearest(n, Unreachable);
+    distancesFrom(graph, nullptr, 0, dist);
+    Vertex next = 0;
+    for (Vertex v = 0; v < n; ++v)
+        if (dist[v] != Unreachable && dist[v] > dist[next]) next = v;
+
+    from.assign(n * k, Unreached);
+    for (std::size_t i = 0; i < k; ++i) {
+        if (control) {
+            if (control->isCancelled()) {
+                *this = LandmarkIndex();
+                return false;
+            }
+            control->report(i, k);
+        }
+        chosen.push_back(next);
+        distancesFrom(graph, nullptr, next, dist);
+        if (!storeColumn(dist, i, k, from)) return fail("distances too long for landmark tables");
+
+        for (Vertex v = 0; v < n; ++v) nearest[v] = std::min(nearest[v], dist[v]);
+        next = 0;
+        for (Vertex v = 1; v < n; ++v)
+            if (nearest[v] > nearest[next]) next = v;
+    }
+
+    // The tables to the landmarks are independent of each other
+    if (directed) {
+        const IncomingArcs incoming(graph);
+        to.assign(n * k, Unreached);
+        std::vector<char> fits(k, 1);
+        parallelChunks(k, 1, 0, [&](std::size_t, std::size_t begin, std::size_t end) {
+            std::vector<long long> back;
+            for (std::size_t i = begin; i < end; ++i) {
+                distancesFrom(graph, &incoming, chosen[i], back);
+                fits[i] = storeColumn(back, i, k, to);
+            }
+        });
+        if (std::find(fits.begin(), fits.end(), 0) != fits.end())
+            return fail("distances too long for landmark tables");
+    }
+
+    fingerprint = graphFingerprint(graph);
+    vertices = n;
+    return true;
+}
+
+long long LandmarkIndex::lowerBound(Vertex v, Vertex target) const {
+    const std::size_t k = chosen.size();
+    const std::vector<std::uint32_t> &back = to.empty() ? from : to;
+    const std::uint32_t *fromV = &from[v * k], *fromT = &from[target * k];
+    const std::uint32_t *toV = &back[v * k], *toT = &back[target * k];
+    long long bound = 0;
+    for (std::size_t i = 0; i < k; ++i) {
+        // d(L, t) <= d(L, v) + d(v, t): if L reaches v but not t, v can't reach t
+        if (fromV[i] != Unreached) {
+            if (fromT[i] == Unreached) return Unreachable;
+            bound = std::max(bound, (long long)fromT[i] - fromV[i]);
+        }
+        // d(v, L) <= d(v, t) + d(t, L): if t reaches L but v doesn't, v can't reach t
+        if (toT[i] != Unreached) {
+            if (toV[i] == Unreached) return Unreachable;
+            bound = std::max(bound, (long long)toV[i] - toT[i]);
+        }
+    }
+    return bound;
+}
+
+Heuristic LandmarkIndex::heuristic(Vertex target) const {
+    if (empty() || target >= vertices) return {};
+    return [this, target](Vertex v) { return lowerBound(v, target); };
+}
+
+// ---- Index file ----
+namespace {
+const char LandmarkMagic[9] = "YGGALT\0\0";
+constexpr std::uint32_t LandmarkVersion = 1;
+}
+
+bool LandmarkIndex::save(std::ostream &out) const {
+    writeIndexHeader(out, LandmarkMagic, LandmarkVersion, fingerprint);
+    writeIndexArray(out, chosen);
+    writeIndexArray(out, from);
+    writeIndexArray(out, to);
+    return (bool)out;
+}
+
+bool LandmarkIndex::load(std::istream &in, const CsrGraph &graph, std::string *error) {
+    *this = LandmarkIndex();
+    if (!readIndexHeader(in, LandmarkMagic, LandmarkVersion, graph, error)) return false;
+
+    const std::size_t n = graph.vertexCount();
+    LandmarkIndex loaded;
+    bool ok = readIndexArray(in, loaded.chosen, n);
+    const std::size_t cells = n * loaded.chosen.size();
+    ok = ok && readIndexArray(in, loaded.from, cells) && readIndexArray(in, loaded.to, cells) &&
+         loaded.from.size() == cells && (loaded.to.empty() || loaded.to.size() == cells) &&
+         (n == 0 || !loaded.chosen.empty());
+    for (std::size_t i = 0; ok && i < loaded.chosen.size(); ++i) ok = loaded.chosen[i] < n;
+    if (!ok) {
+        if (error) *error = "index file is damaged";
+        return false;
+    }
+
+    loaded.fingerprint = graphFingerprint(graph);
+    loaded.vertices = n;
+    *this = std::move(loaded);
+    return true;
+}
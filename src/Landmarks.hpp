@@ -0,0 +1,62 @@
+#ifndef LANDMARKS_HPP
+#define LANDMARKS_HPP
+
+#include "PointToPoint.hpp"
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// ALT lower bounds (Goldberg & Harrelson, "Computing the Shortest Path: A*
+// Search Meets Graph Theory") over a frozen CsrGraph with non-negative
+// weights. For a handful of landmarks L the index stores d(L, v) and
+// d(v, L) for every vertex, and the triangle inequality turns them into
+//
+//     d(v, t) >= max over L of  d(L, t) - d(L, v),  d(v, L) - d(t, L)
+//
+// an admissible, consistent A* heuristic that, unlike a straight-line one,
+// follows the weights. Landmarks are picked farthest-first: each next one
+// is the vertex farthest from those already chosen, so they end up on the
+// rim of the graph, behind most targets as seen from most sources.
+//
+// Tables are vertex-major (a vertex's distances share a cache line) and
+// 32-bit; build() fails if a distance does not fit. Like the contraction
+// hierarchy the index belongs to the graph it was built from.
+class LandmarkIndex {
+public:
+    using Vertex = CsrGraph::Vertex;
+    static constexpr std::size_t DefaultLandmarks = 8;
+
+    // Choose `count` landmarks (fewer on a smaller graph) and fill their
+    // tables. False if cancelled, or (with error) on a negative weight or
+    // a distance too long for the tables; the index is left empty then.
+    bool build(const CsrGraph &graph, std::size_t count = DefaultLandmarks, RunControl *control = nullptr,
+               std::string *error = nullptr);
+
+    bool empty() const { return vertices == 0; }
+    const std::vector<Vertex> &landmarks() const { return chosen; }
+
+    // Lower bound on d(v, target); Unreachable when a landmark proves there
+    // is no route at all
+    long long lowerBound(Vertex v, Vertex target) const;
+
+    // lowerBound(., target) for routeAStar(); refers to the index
+    Heuristic heuristic(Vertex target) const;
+
+    // Binary index file (see IndexFile.hpp); load() checks that it was
+    // written for `graph` and leaves the index empty otherwise
+    bool save(std::ostream &out) const;
+    bool load(std::istream &in, const CsrGraph &graph, std::string *error = nullptr);
+
+private:
+    static constexpr std::uint32_t Unreached = UINT32_MAX;
+
+    std::uint64_t fingerprint = 0;
+    std::size_t vertices = 0;
+    std::vector<Vertex> chosen;
+    std::vector<std::uint32_t> from; // from[v * landmarks + i] = d(L_i, v)
+    std::vector<std::uint32_t> to;   // d(v, L_i); empty when the graph is undirected (to == from)
+};
+
+#endif // LANDMARKS_HPP
@@ -0,0 +1,74 @@
+#include "LayoutRunner.hpp"
+
+LayoutRunner::~LayoutRunner() {
+    stop();
+}
+
+template <typename Make>
+void LayoutRunner::launch(Make make) {
+    stop();
+
+    control.reset();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        fresh = false;
+        running = true;
+    }
+
+    worker = std::thread([this, make = std::move(make)]() mutable {
+        ForceLayout layout = make();
+        while (!control.isCancelled() && layout.step()) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (fresh && !layout.finished()) continue;
+            }
+            std::vector<Point> reached = layout.positions();
+            std::lock_guard<std::mutex> lock(mutex);
+            if (control.isCancelled()) break;
+            latest = std::move(reached);
+            fresh = true;
+        }
+
+        // cleared under the lock so take() never misses the last positions
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+    });
+}
+
+void LayoutRunner::start(std::shared_ptr<const CsrGraph> graph, std::vector<Point> positions,
+                         const LayoutOptions &options) {
+    // coarsening a large graph takes a moment too, so it happens on the worker
+    launch([graph = std::move(graph), positions = std::move(positions), options]() mutable {
+        return ForceLayout(*graph, std::move(positions), options);
+    });
+}
+
+void LayoutRunner::start(LayoutPatch patch, const LayoutOptions &options) {
+    launch([patch = std::move(patch), options] { return ForceLayout(patch, options); });
+}
+
+void LayoutRunner::stop() {
+    control.cancel();
+    join();
+    std::lock_guard<std::mutex> lock(mutex);
+    fresh = false;
+    running = false;
+}
+
+bool LayoutRunner::take(std::vector<Point> &out) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!fresh) return false;
+    out = std::move(latest);
+    latest.clear();
+    fresh = false;
+    return true;
+}
+
+bool LayoutRunner::isRunning() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return running;
+}
+
+void LayoutRunner::join() {
+    if (worker.joinable()) worker.join();
+}
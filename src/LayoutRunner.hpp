@@ -0,0 +1,52 @@
+#ifndef LAYOUTRUNNER_HPP
+#define LAYOUTRUNNER_HPP
+
+#include "ForceLayout.hpp"
+#include "RunControl.hpp"
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// LayoutRunner: runs ForceLayout on a worker thread. After an iteration
+// the worker publishes the positions reached, unless the GUI has not yet
+// taken the previous ones, so a slow frame rate never holds it back.
+class LayoutRunner {
+public:
+    LayoutRunner() = default;
+    ~LayoutRunner();
+
+    LayoutRunner(const LayoutRunner&) = delete;
+    LayoutRunner &operator=(const LayoutRunner&) = delete;
+
+    // Stop any previous layout, then lay out `graph` from `positions`
+    void start(std::shared_ptr<const CsrGraph> graph, std::vector<Point> positions, const LayoutOptions &options = {});
+    // Stop any previous layout, then settle the movable vertices of `patch`
+    void start(LayoutPatch patch, const LayoutOptions &options = {});
+
+    // Stop the layout where it is; nothing more is published
+    void stop();
+
+    // Move the newest positions into `out` (GUI thread only); false if
+    // nothing was published since the last take()
+    bool take(std::vector<Point> &out);
+
+    bool isRunning() const;
+
+private:
+    // Run the layout `make` builds on the worker
+    template <typename Make>
+    void launch(Make make);
+    void join();
+
+    std::thread worker;
+    RunControl control;
+
+    mutable std::mutex mutex;
+    std::vector<Point> latest; // guarded by mutex
+    bool fresh = false;        // latest not taken yet; guarded by mutex
+    bool running = false;      // guarded by mutex
+};
+
+#endif // LAYOUTRUNNER_HPP
@@ -2,6 +2,8 @@
 #include "ThemeManager.hpp"
 #include "Algorithms.hpp"
 #include "ManPageTexts.hpp"
+#include "Generators.hpp"
+#include "RouteIndex.hpp"
 
 #include <QStackedWidget>
 #include <QVBoxLayout>
@@ -14,10 +16,11 @@
 #include <QScrollArea>
 #include <QScrollBar>
 #include <QLabel>
+#include <QDialogButtonBox>
 #include <QCoreApplication>
 #include <cstring>
+#include <memory>
 
-using StepCallback = std::function<void(const std::string&)>;
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent),
@@ -25,6 +28,9 @@ MainWindow::MainWindow(QWidget *parent)
       themeManager(new ThemeManager()),
       isDarkMode(false) {
 
+    // The widget draws straight from `graph`; edits then update it in place
+    graphWidget->setGraph(graph);
+
     // Central Split View
     QSplitter *splitter = new QSplitter(this);
     splitter->addWidget(createControlPanel());
@@ -46,22 +52,25 @@ QWidget* MainWindow::createControlPanel() {
     QWidget *panel = new QWidget(this);
     QVBoxLayout *layout = new QVBoxLayout(panel);
 
-    // Top layout: Help + Save + Theme + Clear Graph
+    // Top layout: Help + Save + Generate + Clear Graph + Theme
     QHBoxLayout *topLayout = new QHBoxLayout();
     QPushButton *helpBtn = new QPushButton("Help", panel);
     saveOutputBtn = new QPushButton("Save Output", panel);
     themeToggleBtn = new QPushButton("Toggle Theme", panel);
     QPushButton *clearGraphBtn = new QPushButton("Clear Graph", panel);
+    QPushButton *generateBtn = new QPushButton("Generate…", panel);
 
     topLayout->addWidget(helpBtn);
     topLayout->addStretch();
     topLayout->addWidget(saveOutputBtn);
+    topLayout->addWidget(generateBtn);
     topLayout->addWidget(clearGraphBtn);
     topLayout->addWidget(themeToggleBtn);
     layout->addLayout(topLayout);
 
     connect(themeToggleBtn, &QPushButton::clicked, this, &MainWindow::toggleTheme);
     connect(clearGraphBtn, &QPushButton::clicked, this, &MainWindow::clearGraph);
+    connect(generateBtn, &QPushButton::clicked, this, &MainWindow::showGenerateDialog);
     connect(helpBtn, &QPushButton::clicked, this, &MainWindow::showHelp);
 
     connect(saveOutputBtn, &QPushButton::clicked, [this]() {
@@ -72,20 +81,20 @@ QWidget* MainWindow::createControlPanel() {
 
         QTextStream out(&file);
         out << "Nodes:\n";
-        for (auto &node : graph.nodes()) out << QString::fromStdString(node) << "\n";
+        for (const auto &node : graph.nodes()) out << QString::fromStdString(node) << "\n";
 
         out << "\nEdges:\n";
-        for (auto &edge : graph.edges())
-            out << QString::fromStdString(edge.from) << " -> "
-                << QString::fromStdString(edge.to)
+        for (const auto &edge : graph.edges())
+            out << QString::fromStdString(graph.name(edge.from)) << " -> "
+                << QString::fromStdString(graph.name(edge.to))
                 << " Weight: " << edge.weight.value_or(1)
                 << " Directed: " << (edge.directed ? "Yes" : "No") << "\n";
 
         out << "\nAdjacency List:\n";
-        for (auto &node : graph.nodes()) {
-            out << QString::fromStdString(node) << ": ";
-            for (auto &e : graph.neighbors(node))
-                out << QString::fromStdString(e.to) << "("
+        for (NodeId id = 0; id < graph.nodeCount(); ++id) {
+            out << QString::fromStdString(graph.name(id)) << ": ";
+            for (auto &e : graph.neighbors(id))
+                out << QString::fromStdString(graph.name(e.to)) << "("
                     << e.weight.value_or(1) << ") ";
             out << "\n";
         }
@@ -125,7 +134,7 @@ QWidget* MainWindow::createControlPanel() {
         }
         bool directed = directedInput->isChecked();
         graph.removeEdge(from.toStdString(), to.toStdString(), directed);
-        graphWidget->setGraph(graph);
+        graphWidget->edgesChanged(graph.id(from.toStdString()), graph.id(to.toStdString()));
         edgeFromInput->clear(); edgeToInput->clear();
     });
 
@@ -141,17 +150,30 @@ QWidget* MainWindow::createControlPanel() {
     QFormLayout *algoLayout = new QFormLayout(algoBox);
     algorithmBox = new QComboBox(algoBox);
 
-    algorithmBox->addItems({"DFS", "BFS", "Detect Cycles","Dijkstra","Bellman-Ford","Floyd-Warshall","Prim's MST","Kruskal's MST"});
+    algorithmBox->addItems({"DFS", "BFS", "Detect Cycles","Dijkstra","Delta-Stepping","Bidirectional Dijkstra","A*","Contraction Hierarchy","ALT (Landmarks)","Bellman-Ford","Floyd-Warshall","Prim's MST","Kruskal's MST","Borůvka's MST","Strongly Connected Components"});
 
     startNodeInput = new QLineEdit(algoBox);
     endNodeInput = new QLineEdit(algoBox);
     runBtn = new QPushButton("Run", algoBox);
     connect(runBtn, &QPushButton::clicked, this, &MainWindow::runAlgorithm);
+    cancelBtn = new QPushButton("Cancel", algoBox);
+    cancelBtn->setEnabled(false);
+    connect(cancelBtn, &QPushButton::clicked, this, &MainWindow::cancelAlgorithm);
+
+    // Progress of the algorithm itself (the animation may lag behind it)
+    progressBar = new QProgressBar(algoBox);
+    progressBar->setRange(0, 1000);
+    progressBar->setValue(0);
+
+    QHBoxLayout *runLayout = new QHBoxLayout();
+    runLayout->addWidget(runBtn);
+    runLayout->addWidget(cancelBtn);
 
     algoLayout->addRow("Algorithm:", algorithmBox);
     algoLayout->addRow("Start Node:", startNodeInput);
     algoLayout->addRow("Goal Node:", endNodeInput);
-    algoLayout->addRow("", runBtn);
+    algoLayout->addRow("", runLayout);
+    algoLayout->addRow("Progress:", progressBar);
 
     // Disable Start/End automatically for MST
     connect(algorithmBox, QOverload<int>::of(&QComboBox::currentIndexChanged),
@@ -185,7 +207,7 @@ void MainWindow::addNode() {
     QString id = nodeInput->text().trimmed();
     if (id.isEmpty()) { QMessageBox::warning(this,"Invalid Input","Node ID cannot be empty."); return; }
     graph.addNode(id.toStdString());
-    graphWidget->setGraph(graph);
+    graphWidget->addNewNodes();
     nodeInput->clear();
 }
 
@@ -198,7 +220,7 @@ void MainWindow::addEdge() {
     graph.addEdge(from.toStdString(), to.toStdString(),
                   directed ? std::make_optional(weight) : std::nullopt,
                   directed);
-    graphWidget->setGraph(graph);
+    graphWidget->edgesChanged(graph.id(from.toStdString()), graph.id(to.toStdString()));
     edgeFromInput->clear(); edgeToInput->clear(); weightInput->setValue(0);
 }
 
@@ -206,12 +228,9 @@ void MainWindow::runAlgorithm() {
     // Reset state
     outputBox->clear();
 
-    // First run, GraphWidget is not destroyed, but
-    // from the 2nd run onwards, the GraphWidget is destroyed and rebuilt.
-    if (!isFirstRun) {
-        graphWidget->reset();       // clear visuals
-        graphWidget->setGraph(graph); // redraw from Graph model
-    }
+    // From the 2nd run onwards, clear the previous run's highlights (the
+    // drawing itself stays, so the layout isn't started over)
+    if (!isFirstRun) graphWidget->resetHighlights();
 
     isFirstRun = false;
 
@@ -222,33 +241,80 @@ void MainWindow::runAlgorithm() {
 
     // BFS, DFS, Prim's MST Algorithms must have a start node.
     // Bellman-Ford & Dijkstra's Algorithms must have a start node.
+    // Point-to-point routes also need a goal node.
+    bool needsGoal = algo == "Bidirectional Dijkstra" || algo == "A*" || algo == "Contraction Hierarchy" ||
+                     algo == "ALT (Landmarks)";
 
-    if(algo == "DFS" || algo == "BFS" || algo == "Dijkstra" || algo == "Bellman-Ford" || algo == "Prim's MST")
+    if(algo == "DFS" || algo == "BFS" || algo == "Dijkstra" || algo == "Delta-Stepping" || algo == "Bellman-Ford" || algo == "Prim's MST" || needsGoal)
     {
         if (start.empty()) {
             QMessageBox::warning(this,"Invalid Input","Start Node cannot be empty."); 
             return; 
         }
     }
+    if (needsGoal && end.empty()) {
+        QMessageBox::warning(this,"Invalid Input","Goal Node cannot be empty.");
+        return;
+    }
 
-    currentSteps.clear();
-    currentStepIndex = 0;
-
-    StepCallback callback = [&](const std::string &msg) {
-        currentSteps.push_back(msg);
-    };
+    // Freeze the graph for the worker; later edits don't affect this run
+    auto snapshot = std::make_shared<const CsrGraph>(graph);
+    runGraph = snapshot; // names for rendering the run's steps
+
+    AlgorithmRunner::Job job;
+    if (algo=="DFS") job = [=](StepLog &steps, RunControl *rc) { dfs(*snapshot, start, steps, rc); };
+    else if (algo=="BFS") job = [=](StepLog &steps, RunControl *rc) { bfs(*snapshot, start, steps, rc); };
+    else if (algo=="Dijkstra") job = [=](StepLog &steps, RunControl *rc) { dijkstra(*snapshot, start, steps, rc); };
+    else if (algo=="Delta-Stepping") job = [=](StepLog &steps, RunControl *rc) { deltaStepping(*snapshot, start, steps, rc); };
+    else if (needsGoal) {
+        // The index, with the route searches it leases, outlives the run:
+        // reuse it until the graph is edited
+        if (!routeIndex || routeIndexRevision != graph.revision()) {
+            routeIndex = std::make_shared<RouteIndex>(snapshot);
+            routeIndexRevision = graph.revision();
+        }
+        auto index = routeIndex;
+        runGraph = index->sharedGraph();
+        if (algo=="Bidirectional Dijkstra")
+            job = [=](StepLog &steps, RunControl *rc) { bidirectionalDijkstra(*index, start, end, steps, rc); };
+        else if (algo=="A*") {
+            // straight-line distance between the nodes as drawn
+            auto positions = std::make_shared<const std::vector<Point>>(graphWidget->nodePositions());
+            job = [=](StepLog &steps, RunControl *rc) { aStar(*index, start, end, steps, rc, positions); };
+        }
+        else if (algo=="Contraction Hierarchy")
+            job = [=](StepLog &steps, RunControl *rc) { contractionHierarchy(*index, start, end, steps, rc); };
+        else
+            job = [=](StepLog &steps, RunControl *rc) { landmarkAStar(*index, start, end, steps, rc); };
+    }
+    else if (algo=="Bellman-Ford") job = [=](StepLog &steps, RunControl *rc) { bellmanFord(*snapshot, start, steps, rc, end); };
+    else if (algo=="Floyd-Warshall") job = [=](StepLog &steps, RunControl *rc) { floydWarshall(*snapshot, steps, rc); };
+    else if (algo=="Prim's MST") job = [=](StepLog &steps, RunControl *rc) { primMST(*snapshot, start, steps, rc); };
+    else if (algo=="Kruskal's MST") job = [=](StepLog &steps, RunControl *rc) { kruskalMST(*snapshot, steps, rc); };
+    else if (algo=="Borůvka's MST") job = [=](StepLog &steps, RunControl *rc) { boruvkaMST(*snapshot, steps, rc); };
+    else if (algo == "Detect Cycles") job = [=](StepLog &steps, RunControl *rc) { detectCycles(*snapshot, steps, rc); };
+    else if (algo == "Strongly Connected Components")
+        job = [=](StepLog &steps, RunControl *rc) { stronglyConnectedComponents(*snapshot, steps, rc); };
+    if (!job) return;
+
+    runner.start(std::move(job));
+    setRunning(true);
+
+    // Start animation timer; it streams steps while the worker produces them
+    startStepAnimation();
+}
 
-    if (algo=="DFS") dfs(graph, start, callback);
-    else if (algo=="BFS") bfs(graph, start, callback);
-    else if (algo=="Dijkstra") dijkstra(graph, start, callback);
-    else if (algo=="Bellman-Ford") bellmanFord(graph, start, callback);
-    else if (algo=="Floyd-Warshall") floydWarshall(graph, callback);
-    else if (algo=="Prim's MST") primMST(graph, start, callback);
-    else if (algo=="Kruskal's MST") kruskalMST(graph, callback);
-    else if (algo == "Detect Cycles") detectCycles(graph, callback);
+void MainWindow::cancelAlgorithm() {
+    runner.cancel();
+    if (stepTimer) stepTimer->stop();
+    setRunning(false);
+    appendHighlightedStep("⏹ Run cancelled.");
+}
 
-    // Start animation timer
-    startStepAnimation();
+void MainWindow::setRunning(bool running) {
+    runBtn->setEnabled(!running);
+    cancelBtn->setEnabled(running);
+    if (running) progressBar->setValue(0);
 }
 
 void MainWindow::startStepAnimation() {
@@ -262,19 +328,28 @@ void MainWindow::startStepAnimation() {
 }
 
 void MainWindow::showNextStep() {
-    if (currentStepIndex >= (int)currentSteps.size()) {
+    progressBar->setValue(runner.progress());
+
+    AlgorithmRunner::Step step;
+    switch (runner.poll(step)) {
+    case AlgorithmRunner::Poll::Waiting:
+        return; // worker hasn't produced the next step yet
+    case AlgorithmRunner::Poll::Finished:
         stepTimer->stop();
+        setRunning(false);
         return;
+    case AlgorithmRunner::Poll::Step:
+        break;
     }
 
-    bool isFinal = (currentStepIndex == (int)currentSteps.size() - 1);
-    QString stepText = QString::fromStdString(currentSteps[currentStepIndex]);
-
-    // Special internal control to revert visuals
-    bool isResetSignal = (stepText == "RESET_COLORS");
+    // Special internal control to revert visuals; it has no text
+    bool isResetSignal = (step.event->kind == StepKind::ResetColors);
 
      if (!isResetSignal) {
-        appendHighlightedStep(stepText, isFinal);
+        // Text is only built for the step actually shown
+        QString stepText = QString::fromStdString(
+            describeStep(*step.event, step.payload, runGraph->nodes()));
+        appendHighlightedStep(stepText, step.isFinal);
         outputBox->verticalScrollBar()->setValue(outputBox->verticalScrollBar()->maximum());
     }
 
@@ -284,9 +359,7 @@ void MainWindow::showNextStep() {
     //outputBox->verticalScrollBar()->setValue(outputBox->verticalScrollBar()->maximum());
 
     // also animate in GraphWidget
-    graphWidget->animateSteps({ currentSteps[currentStepIndex] });
-
-    currentStepIndex++;
+    graphWidget->animateStep(*step.event, step.payload);
 }
 
 void MainWindow::appendHighlightedStep(const QString &text, bool isFinal) {
@@ -334,13 +407,16 @@ void MainWindow::updateAlgorithmControls(int index) {
     //startNodeInput->setDisabled(isMST);
     //endNodeInput->setDisabled(isMST);
 
-    // DFS / BFS / Dijkstra / Bellman-Ford / Prim's MST requires a start node
-    if(algo == "DFS" || algo == "BFS" || algo == "Dijkstra" || algo == "Bellman-Ford" || algo == "Prim's MST"){
+    // DFS / BFS / Dijkstra / Bellman-Ford / Prim's MST requires a start node;
+    // point-to-point routes (Bidirectional Dijkstra, A*, CH, ALT) keep the goal node enabled,
+    // and Bellman-Ford takes an optional one to show the path to
+    if(algo == "DFS" || algo == "BFS" || algo == "Dijkstra" || algo == "Delta-Stepping" || algo == "Prim's MST"){
         endNodeInput->setDisabled(true);
         (*endNodeInput).clear();
     }
 
-    if(algo == "Kruskal's MST" || algo == "Floyd-Warshall" || algo.contains("Cycle")){
+    if(algo == "Kruskal's MST" || algo == "Borůvka's MST" || algo == "Floyd-Warshall" || algo.contains("Cycle") ||
+       algo == "Strongly Connected Components"){
         startNodeInput->setDisabled(true);
         (*startNodeInput).clear();
 
@@ -351,11 +427,95 @@ void MainWindow::updateAlgorithmControls(int index) {
 
 // Clear graph manually
 void MainWindow::clearGraph() {
+    if (runner.isRunning() || (stepTimer && stepTimer->isActive())) cancelAlgorithm();
     graph.clear();
+    routeIndex.reset(); // a graph moved in afterwards may reuse its revision
     graphWidget->reset();
     outputBox->clear();
 }
 
+// Replace the graph with a synthetic one (see Generators.hpp)
+void MainWindow::showGenerateDialog() {
+    QDialog dialog(this);
+    dialog.setWindowTitle("Generate Graph");
+
+    QFormLayout *form = new QFormLayout(&dialog);
+
+    QComboBox *kindBox = new QComboBox(&dialog);
+    kindBox->addItem("Erdős–Rényi", (int)GeneratorKind::ErdosRenyi);
+    kindBox->addItem("R-MAT (Kronecker)", (int)GeneratorKind::RMat);
+    kindBox->addItem("Barabási–Albert", (int)GeneratorKind::BarabasiAlbert);
+    kindBox->addItem("Random geometric", (int)GeneratorKind::RandomGeometric);
+    kindBox->addItem("Grid", (int)GeneratorKind::Grid);
+
+    QSpinBox *nodesInput = new QSpinBox(&dialog);
+    nodesInput->setRange(1, 100000);
+    nodesInput->setValue(20);
+    QSpinBox *edgesInput = new QSpinBox(&dialog);
+    edgesInput->setRange(0, 500000);
+    edgesInput->setValue(40);
+    QSpinBox *perNodeInput = new QSpinBox(&dialog);
+    perNodeInput->setRange(1, 50);
+    perNodeInput->setValue(2);
+    QSpinBox *minWeightInput = new QSpinBox(&dialog);
+    minWeightInput->setRange(-9999, 9999);
+    minWeightInput->setValue(1);
+    QSpinBox *maxWeightInput = new QSpinBox(&dialog);
+    maxWeightInput->setRange(-9999, 9999);
+    maxWeightInput->setValue(20);
+    QSpinBox *seedInput = new QSpinBox(&dialog);
+    seedInput->setRange(0, 999999);
+    seedInput->setValue(1);
+    QCheckBox *directedBox = new QCheckBox("Directed", &dialog);
+
+    form->addRow("Model:", kindBox);
+    form->addRow("Nodes:", nodesInput);
+    form->addRow("Edges:", edgesInput);
+    form->addRow("Edges per node:", perNodeInput);
+    form->addRow("Min weight:", minWeightInput);
+    form->addRow("Max weight:", maxWeightInput);
+    form->addRow("Seed:", seedInput);
+    form->addRow("", directedBox);
+
+    // Only the inputs the chosen model uses are enabled
+    auto updateInputs = [=]() {
+        auto kind = (GeneratorKind)kindBox->currentData().toInt();
+        edgesInput->setEnabled(kind == GeneratorKind::ErdosRenyi || kind == GeneratorKind::RMat ||
+                               kind == GeneratorKind::RandomGeometric);
+        perNodeInput->setEnabled(kind == GeneratorKind::BarabasiAlbert);
+    };
+    connect(kindBox, QOverload<int>::of(&QComboBox::currentIndexChanged), &dialog, updateInputs);
+    updateInputs();
+
+    QDialogButtonBox *buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, &dialog);
+    connect(buttons, &QDialogButtonBox::accepted, &dialog, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
+    form->addRow(buttons);
+
+    if (dialog.exec() != QDialog::Accepted) return;
+
+    GeneratorParams params;
+    params.kind = (GeneratorKind)kindBox->currentData().toInt();
+    params.nodes = (std::size_t)nodesInput->value();
+    params.edges = (std::size_t)edgesInput->value();
+    params.edgesPerNode = (std::size_t)perNodeInput->value();
+    params.minWeight = minWeightInput->value();
+    params.maxWeight = maxWeightInput->value();
+    params.seed = (std::uint64_t)seedInput->value();
+    params.directed = directedBox->isChecked();
+
+    Graph generated;
+    std::string error;
+    if (!generateGraph(params, generated, &error)) {
+        QMessageBox::warning(this, "Invalid Input", QString::fromStdString(error));
+        return;
+    }
+
+    clearGraph();
+    graph = std::move(generated);
+    graphWidget->setGraph(graph);
+}
+
 // Show Help window
 void MainWindow::showHelp() {
     QDialog *helpDialog = new QDialog(this);
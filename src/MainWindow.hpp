@@ -15,13 +15,19 @@
 #include <QGroupBox>
 #include <QWidget>
 #include <QTimer>
+#include <QProgressBar>
 
+#include <cstdint>
+#include <memory>
 #include <vector>
 
 #include "Graph.hpp"
+#include "AlgorithmRunner.hpp"
 #include "GraphWidget.hpp"
 #include "ThemeManager.hpp"
 
+class RouteIndex;
+
 class MainWindow : public QMainWindow {
     Q_OBJECT
 
@@ -32,10 +38,12 @@ private slots:
     void addNode();
     void addEdge();
     void runAlgorithm();
+    void cancelAlgorithm();
     void toggleTheme();
     void updateAlgorithmControls(int index);
     void showHelp();       // new
     void clearGraph();     // new
+    void showGenerateDialog();
 
 private:
     Graph graph;
@@ -58,17 +66,25 @@ private:
     QLineEdit *startNodeInput;
     QLineEdit *endNodeInput;
     QPushButton *runBtn;
+    QPushButton *cancelBtn;
+    QProgressBar *progressBar;
 
     QTextEdit *outputBox;
     QPushButton *clearOutputBtn;
 
     QWidget* createControlPanel();
 
-    QTimer *stepTimer;
-    std::vector<std::string> currentSteps;
-    int currentStepIndex;
+    QTimer *stepTimer = nullptr;
+
+    // Runs the selected algorithm off the GUI thread; showNextStep drains it
+    AlgorithmRunner runner;
+    std::shared_ptr<const CsrGraph> runGraph; // snapshot the current run works on
+    // Route indexes (CH, ALT) built for the graph as of routeIndexRevision
+    std::shared_ptr<RouteIndex> routeIndex;
+    std::uint64_t routeIndexRevision = 0;
 
     void startStepAnimation();
+    void setRunning(bool running);
     void showNextStep();
     void appendHighlightedStep(const QString &text, bool isFinal = false);
 
@@ -35,6 +35,8 @@ class ManPagetexts{
     "<li>✨ Step-by-step simulation with node/edge highlighting.</li>"
     "<li>📜 Output box shows traversal, paths, or MST steps.</li>"
     "<li>🔄 Graph updates automatically as you edit it.</li>"
+    "<li>🕸️ Nodes arrange themselves with a force-directed layout: linked nodes pull together and all nodes push apart, so clusters separate and edges stay short. After an edit only the neighbourhood settles again.</li>"
+    "<li>🔍 Scroll to zoom and drag to pan. Zoomed far out, labels and arrowheads are hidden and crowded nodes merge into dots; zooming back in brings them back.</li>"
     "</ul>"
 
     "<h3 style='color:#2d8659;'>🛠️ Utility Features</h3>"
@@ -28,18 +28,25 @@ class ManPageTexts{
     "<li>🔍 <b>DFS</b> (Depth-First Search)</li>"
     "<li>🔎 <b>BFS</b> (Breadth-First Search)</li>"
     "<li>🛣️ <b>Dijkstra</b> (Shortest Path)</li>"
+    "<li>🪣 <b>Delta-Stepping</b> (Parallel Shortest Path)</li>"
+    "<li>🎯 <b>Bidirectional Dijkstra</b> and <b>A*</b> (Start → Goal route)</li>"
+    "<li>🗺️ <b>Contraction Hierarchy</b> and <b>ALT (Landmarks)</b> (preprocessed Start → Goal routes)</li>"
     "<li>⚖️ <b>Bellman-Ford</b> (Shortest Path with negatives)</li>"
     "<li>🌐 <b>Floyd-Warshall</b> (All-Pairs Shortest Paths)</li>"
     "<li>🌲 <b>Prim's Algorithm to find Minimal Spanning Tree </b></li>"
     "<li>🌳 <b>Kruskal's Algorithm to find Minimal Spanning Tree </b></li>"
+    "<li>🌴 <b>Borůvka's Algorithm to find Minimal Spanning Tree </b></li>"
+    "<li>🧩 <b>Strongly Connected Components</b> (each component in its own colour)</li>"
     "</ul>"
-    "<p style='color:#cc6600;'><i>Note: Start/End node fields are disabled for MST algorithms.</i></p>"
+    "<p style='color:#cc6600;'><i>Note: Start/End node fields are disabled for MST algorithms; the Goal Node is used by the Start → Goal route algorithms and, optionally, by Bellman-Ford.</i></p>"
 
     "<h3 style='color:#2d8659;'>🎨 Visualization & Output</h3>"
     "<ul>"
     "<li>✨ Step-by-step simulation with node/edge highlighting.</li>"
     "<li>📜 Output box shows traversal, paths, or MST steps.</li>"
     "<li>🔄 Graph updates automatically as you edit it.</li>"
+    "<li>🕸️ Nodes arrange themselves with a force-directed layout: linked nodes pull together and all nodes push apart, so clusters separate and edges stay short. After an edit only the neighbourhood settles again.</li>"
+    "<li>🔍 Scroll to zoom and drag to pan. Zoomed far out, labels and arrowheads are hidden and crowded nodes merge into dots; zooming back in brings them back.</li>"
     "</ul>"
 
     "<h3 style='color:#2d8659;'>🛠️ Utility Features</h3>"
@@ -61,11 +68,18 @@ class ManPageTexts{
                 "<li><b>DFS (Depth-First Search):</b> Explores as far as possible along each branch before backtracking. It uses a stack (implicit via recursion or explicit). Useful for path finding, cycle detection, and topological sorting in directed acyclic graphs.</li>"
                 "<li><b>BFS (Breadth-First Search):</b> Explores neighbors level by level, ensuring the shortest path in terms of edge count is found in unweighted graphs. It uses a queue and is also applied in bipartite checking and shortest path problems without weights.</li>"
                 "<li><b>Dijkstra’s Algorithm:</b> A greedy algorithm that finds the shortest path from a single source to all other nodes, provided all edge weights are non-negative. It repeatedly selects the node with the smallest tentative distance and updates its neighbors.</li>"
-                "<li><b>Bellman-Ford Algorithm:</b> Handles graphs with negative weights by relaxing all edges N−1 times (where N is the number of vertices). It can also detect negative weight cycles, which Dijkstra cannot handle.</li>"
+                "<li><b>Delta-Stepping:</b> Finds the same distances as Dijkstra, but groups tentative distances into buckets of width Δ. All nodes in the lowest bucket are processed together, first along their light edges (weight ≤ Δ) until the bucket stays empty, then along their heavy edges, so the work can be spread over all CPU cores.</li>"
+                "<li><b>Bidirectional Dijkstra:</b> Finds the shortest route from the Start node to the Goal node by running Dijkstra forwards from the start and backwards from the goal at the same time. It stops as soon as the two searches have met along the best route, usually long before either has covered the graph.</li>"
+                "<li><b>A* Search:</b> Dijkstra towards a single Goal node, always expanding the node with the smallest distance travelled plus an estimate of the distance left. The estimate here is the straight-line distance between the nodes as drawn, scaled so it never exceeds the real remaining cost, which keeps the route optimal while steering the search towards the goal.</li>"
+                "<li><b>Contraction Hierarchy:</b> Preprocesses the graph once by removing nodes one at a time, least important first, and adding shortcut edges wherever a removed node lay on a shortest path. A route is then found by two small searches that only climb towards more important nodes and meet at the top. The preprocessing is kept until the graph is edited, so repeated queries are answered almost instantly.</li>"
+                "<li><b>ALT (Landmarks):</b> A* whose estimate comes from a few landmark nodes on the rim of the graph. Their distances to and from every node are computed once; by the triangle inequality they give a lower bound on the distance left that follows the edge weights rather than the drawing. Like the hierarchy, the tables are kept until the graph is edited.</li>"
+                "<li><b>Bellman-Ford Algorithm:</b> Handles graphs with negative weights, which Dijkstra cannot. It keeps a queue of the nodes whose distance has just dropped and only re-examines their edges, until no distance changes any more. A negative weight cycle is reported as soon as the recorded predecessors loop back on themselves. Enter a Goal node to have the shortest path to it shown at the end.</li>"
                 "<li><b>Floyd-Warshall Algorithm:</b> A dynamic programming algorithm that computes shortest paths between all pairs of nodes. It systematically considers each node as an intermediate point and updates distances accordingly. Can detect negative cycles as well.</li>"
                 "<li><b>Prim’s MST Algorithm:</b> A greedy algorithm that builds a Minimum Spanning Tree by starting from a chosen node and repeatedly adding the smallest edge that connects a visited node to an unvisited one.</li>"
                 "<li><b>Kruskal’s MST Algorithm:</b> Builds a Minimum Spanning Tree by sorting all edges by weight and adding them one by one, provided they don’t form a cycle (detected using a union-find/disjoint-set structure).</li>"
+                "<li><b>Borůvka’s MST Algorithm:</b> Starts with every node as its own component. In each round every component picks the lightest edge leaving it, and all of those edges are added at once, at least halving the number of components. The picks of one round are independent of each other, so large graphs are processed on all CPU cores.</li>"
                 "<li><b>Cycle Detection:</b> Determines if the graph contains cycles. In undirected graphs, DFS detects back-edges. In directed graphs, DFS with a recursion stack or topological sort can detect cycles.</li>"
+                "<li><b>Strongly Connected Components:</b> Splits the graph into groups of nodes that can all reach one another; an undirected edge counts both ways. Tarjan's algorithm finds them in a single depth-first search, and each component is drawn in its own colour. The summary line counts the components, those containing a cycle, and the edges of the condensation: the graph with every component shrunk to one node, which never has a cycle. Large graphs without the animation are first trimmed of nodes with no way in or out, then the biggest component is found by searching forwards and backwards from one node on all CPU cores.</li>"
         "</ul>";
 
 
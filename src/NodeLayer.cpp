@@ -0,0 +1,126 @@
+#include "NodeLayer.hpp"
+
+#include <QPainter>
+#include <QPen>
+#include <QStyleOptionGraphicsItem>
+#include <algorithm>
+#include <cmath>
+#include <unordered_set>
+
+namespace {
+
+constexpr double LabelZoom = 0.45;    // labels from this scale on (text about 6px high)
+constexpr double AggregatePixels = 4; // nodes narrower than this on screen are aggregated
+
+} // namespace
+
+NodeLayer::NodeLayer(double radius) : radius(radius) {
+    setFlag(ItemUsesExtendedStyleOption); // paint() gets the exposed rectangle
+}
+
+void NodeLayer::clear() {
+    prepareGeometryChange();
+    position.clear();
+    fill.clear();
+    label.clear();
+    bounds = QRectF();
+    grid.clear();
+    indexed = false;
+}
+
+void NodeLayer::add(const QPointF &at, const QString &name) {
+    position.push_back(at);
+    fill.push_back(baseFill);
+    label.push_back(name);
+    indexed = false;
+
+    const QRectF rect = nodeRect(position.size() - 1);
+    if (!bounds.contains(rect)) {
+        prepareGeometryChange();
+        bounds = bounds.isNull() ? rect : bounds.united(rect);
+    }
+    update(rect);
+}
+
+void NodeLayer::setPositions(const std::vector<Point> &positions) {
+    prepareGeometryChange();
+    bounds = QRectF();
+    for (std::size_t id = 0; id < position.size() && id < positions.size(); ++id) {
+        position[id] = QPointF(positions[id].x, positions[id].y);
+        bounds = bounds.isNull() ? nodeRect(id) : bounds.united(nodeRect(id));
+    }
+    indexed = false;
+    update();
+}
+
+void NodeLayer::setColor(std::size_t id, const QColor &color) {
+    if (id >= fill.size()) return;
+    fill[id] = color;
+    update(nodeRect(id).adjusted(-2, -2, 2, 2));
+}
+
+void NodeLayer::setColors(const QColor &nodeFill, const QColor &text) {
+    baseFill = nodeFill;
+    textColor = text;
+    std::fill(fill.begin(), fill.end(), nodeFill);
+    update();
+}
+
+QRectF NodeLayer::boundingRect() const {
+    // the pen reaches a pixel beyond the circles
+    return bounds.adjusted(-2, -2, 2, 2);
+}
+
+QRectF NodeLayer::nodeRect(std::size_t id) const {
+    return QRectF(position[id].x() - radius, position[id].y() - radius, 2 * radius, 2 * radius);
+}
+
+void NodeLayer::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *) {
+    if (position.empty()) return;
+    if (!indexed) {
+        std::vector<SpatialGrid::Box> boxes(position.size());
+        for (std::size_t id = 0; id < position.size(); ++id)
+            boxes[id] = {position[id].x(), position[id].y(), position[id].x(), position[id].y()};
+        grid.build(boxes);
+        indexed = true;
+    }
+
+    // Nodes whose circle reaches into the exposed rectangle
+    const QRectF exposed = option->exposedRect.adjusted(-radius - 2, -radius - 2, radius + 2, radius + 2);
+    std::vector<std::uint32_t> visible;
+    grid.query({exposed.left(), exposed.top(), exposed.right(), exposed.bottom()}, [&](std::uint32_t id) {
+        if (exposed.contains(position[id])) visible.push_back(id);
+    });
+
+    const double lod = option->levelOfDetailFromTransform(painter->worldTransform());
+    if (2 * radius * lod < AggregatePixels) {
+        // Far out: one square per screen cell that holds any node, cut to
+        // that node's pen reach so it stays inside boundingRect() and the
+        // area setColor() repaints
+        const double cell = AggregatePixels / lod;
+        std::unordered_set<std::uint64_t> taken;
+        painter->setPen(Qt::NoPen);
+        for (std::uint32_t id : visible) {
+            const std::int64_t x = (std::int64_t)std::floor(position[id].x() / cell);
+            const std::int64_t y = (std::int64_t)std::floor(position[id].y() / cell);
+            if (!taken.insert((std::uint64_t)x << 32 ^ (std::uint32_t)y).second) continue;
+            painter->setBrush(fill[id]);
+            const QRectF square(x * cell, y * cell, cell, cell);
+            painter->drawRect(square.intersected(nodeRect(id).adjusted(-2, -2, 2, 2)));
+        }
+        return;
+    }
+
+    painter->setPen(QPen(Qt::black, 2));
+    for (std::uint32_t id : visible) {
+        painter->setBrush(fill[id]);
+        painter->drawEllipse(position[id], radius, radius);
+    }
+
+    if (lod < LabelZoom) return;
+    painter->setPen(QPen(textColor));
+    for (std::uint32_t id : visible) {
+        const QRectF box(position[id].x() - 2 * radius, position[id].y() - radius, 4 * radius, 2 * radius);
+        painter->drawText(box, Qt::AlignCenter | Qt::TextDontClip, label[id]);
+    }
+}
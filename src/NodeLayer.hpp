@@ -0,0 +1,55 @@
+#ifndef NODELAYER_HPP
+#define NODELAYER_HPP
+
+#include <QGraphicsItem>
+#include <QColor>
+#include <QString>
+#include <vector>
+
+#include "Graph.hpp"
+#include "SpatialGrid.hpp"
+
+// NodeLayer: every node of the graph in one scene item. Nodes are plain
+// arrays (position, fill, label) rather than an ellipse and a text item
+// each, and paint() draws only those in the exposed rectangle, found
+// through a SpatialGrid. How much it draws depends on the zoom:
+//   - labels only once they are large enough to read;
+//   - when nodes shrink to a few pixels, one dot per screen cell, in the
+//     colour of a node inside it, instead of overlapping circles.
+class NodeLayer : public QGraphicsItem {
+public:
+    explicit NodeLayer(double radius);
+
+    void clear();
+    // Append a node (its id is the previous size())
+    void add(const QPointF &at, const QString &name);
+    std::size_t size() const { return position.size(); }
+
+    QPointF positionOf(std::size_t id) const { return position[id]; }
+    // Move every node at once; one point per node
+    void setPositions(const std::vector<Point> &positions);
+
+    void setColor(std::size_t id, const QColor &color);
+    // Every node back to `fill`, labels in `text`
+    void setColors(const QColor &nodeFill, const QColor &text);
+
+    QRectF boundingRect() const override;
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget = nullptr) override;
+
+private:
+    QRectF nodeRect(std::size_t id) const;
+
+    const double radius;
+    std::vector<QPointF> position;
+    std::vector<QColor> fill;
+    std::vector<QString> label;
+    QColor baseFill = Qt::white;
+    QColor textColor = Qt::black;
+    QRectF bounds;
+
+    // rebuilt by the first paint() after the nodes moved
+    SpatialGrid grid;
+    bool indexed = false;
+};
+
+#endif // NODELAYER_HPP
@@ -0,0 +1,106 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Number of worker threads to use when the caller passes 0 (= "all cores")
+inline unsigned resolveThreads(unsigned requested) {
+    if (requested) return requested;
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw ? hw : 1;
+}
+
+// Run body(chunk, begin, end) over [0, count) split into fixed-size chunks
+// handed out round-robin to `threads` std::threads (0 = all cores).
+// Chunk boundaries depend only on chunkSize, never on the thread count,
+// so per-chunk work (e.g. seeded RNG streams) is reproducible.
+template <typename Body>
+void parallelChunks(std::size_t count, std::size_t chunkSize, unsigned threads, Body body) {
+    if (count == 0) return;
+    chunkSize = std::max<std::size_t>(chunkSize, 1);
+    const std::size_t chunks = (count + chunkSize - 1) / chunkSize;
+    const unsigned workers = (unsigned)std::min<std::size_t>(resolveThreads(threads), chunks);
+
+    auto run = [&](unsigned worker) {
+        for (std::size_t c = worker; c < chunks; c += workers) {
+            std::size_t begin = c * chunkSize;
+            body(c, begin, std::min(begin + chunkSize, count));
+        }
+    };
+
+    if (workers == 1) {
+        run(0);
+        return;
+    }
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (unsigned w = 1; w < workers; ++w) pool.emplace_back(run, w);
+    run(0);
+    for (auto &t : pool) t.join();
+}
+
+// Reusable rendezvous point for a fixed team of threads (std::barrier is C++20)
+class Barrier {
+public:
+    explicit Barrier(unsigned count) : count(count) {}
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        const std::size_t arrivedIn = generation;
+        if (++arrived == count) {
+            arrived = 0;
+            ++generation;
+            wakeUp.notify_all();
+            return;
+        }
+        wakeUp.wait(lock, [&] { return generation != arrivedIn; });
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    const unsigned count;
+    unsigned arrived = 0;
+    std::size_t generation = 0;
+};
+
+// Run body(worker) for worker = 0..workers-1 on its own std::thread, the
+// calling thread being worker 0. For phased work that a Barrier keeps in step.
+template <typename Body>
+void parallelTeam(unsigned workers, Body body) {
+    workers = std::max(workers, 1u);
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (unsigned w = 1; w < workers; ++w) pool.emplace_back(body, w);
+    body(0u);
+    for (auto &t : pool) t.join();
+}
+
+// std::sort on `threads` workers (0 = all cores): one run per worker is
+// sorted in parallel, then runs are merged pairwise, in parallel where
+// there are several pairs. Small ranges are sorted on the calling thread.
+template <typename Iterator, typename Less>
+void parallelSort(Iterator first, Iterator last, Less less, unsigned threads = 0) {
+    const std::size_t count = (std::size_t)(last - first);
+    const unsigned workers = resolveThreads(threads);
+    if (workers == 1 || count < ((std::size_t)1 << 15)) {
+        std::sort(first, last, less);
+        return;
+    }
+    std::size_t run = (count + workers - 1) / workers;
+    parallelChunks(count, run, workers, [&](std::size_t, std::size_t begin, std::size_t end) {
+        std::sort(first + begin, first + end, less);
+    });
+    for (; run < count; run *= 2) {
+        parallelChunks(count, 2 * run, workers, [&](std::size_t, std::size_t begin, std::size_t end) {
+            if (begin + run < end) std::inplace_merge(first + begin, first + begin + run, first + end, less);
+        });
+    }
+}
+
+#endif // PARALLEL_HPP
@@ -0,0 +1,305 @@
+#include "ParallelBfs.hpp"
+#include "IncomingArcs.hpp"
+#include "Parallel.hpp"
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace {
+
+using Vertex = CsrGraph::Vertex;
+using Word = std::uint64_t;
+
+// Switching thresholds from the paper: go bottom-up once a growing
+// frontier's arcs exceed 1/Alpha of the unexplored ones, back top-down
+// once the frontier shrinks below 1/Beta of the vertices
+constexpr std::size_t Alpha = 15;
+constexpr std::size_t Beta = 18;
+
+// parallelChunks() granularity: frontier vertices per top-down chunk, and
+// vertices per bottom-up chunk (a multiple of 64, so a chunk owns whole
+// bitmap words and updates them with plain stores)
+constexpr std::size_t FrontierChunk = 1024;
+constexpr std::size_t VertexChunk = 1 << 14;
+
+int lowestBit(Word bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(bits);
+#else
+    int bit = 0;
+    for (; !(bits & 1); bits >>= 1) ++bit;
+    return bit;
+#endif
+}
+
+class Bitmap {
+public:
+    explicit Bitmap(std::size_t bits = 0) : words((bits + 63) / 64) {}
+
+    bool test(std::size_t i) const { return (words[i >> 6].load(std::memory_order_relaxed) >> (i & 63)) & 1; }
+    void set(std::size_t i) { words[i >> 6].fetch_or(mask(i), std::memory_order_relaxed); }
+    void reset(std::size_t i) { words[i >> 6].fetch_and(~mask(i), std::memory_order_relaxed); }
+    // Set bit i; true if this caller was the one to set it
+    bool claim(std::size_t i) { return !(words[i >> 6].fetch_or(mask(i), std::memory_order_relaxed) & mask(i)); }
+
+    std::size_t wordCount() const { return words.size(); }
+    Word word(std::size_t w) const { return words[w].load(std::memory_order_relaxed); }
+    void setWord(std::size_t w, Word value) { words[w].store(value, std::memory_order_relaxed); }
+
+private:
+    static Word mask(std::size_t i) { return Word(1) << (i & 63); }
+    std::vector<std::atomic<Word>> words;
+};
+
+} // namespace
+
+bool bfsDirectionOptimizing(const CsrGraph &graph, Vertex source, std::vector<std::uint32_t> &level,
+                            std::vector<Vertex> &parent, RunControl *control, unsigned threads) {
+    const std::size_t n = graph.vertexCount();
+    level.assign(n, BfsTree::Unreached);
+    parent.assign(n, CsrGraph::npos);
+    if (source >= n) return true;
+
+    const unsigned workers = resolveThreads(threads);
+
+    Bitmap visited(n);       // reached on an earlier level (stale after serial levels)
+    bool visitedStale = false;
+    Bitmap claimed;          // reached on the current parallel top-down level
+    Bitmap front, nextFront; // bottom-up frontiers
+    std::unique_ptr<IncomingArcs> incoming;
+    // Parallel top-down levels race to lower lowest[w], then copy it to parent[w]
+    std::unique_ptr<std::atomic<Vertex>[]> lowest;
+
+    std::vector<Vertex> frontier{source}, next;
+    std::vector<std::vector<Vertex>> buffers; // per chunk: top-down discoveries, bitmap -> queue
+    std::vector<std::size_t> counts;          // per chunk: arcs or vertices found
+
+    visited.set(source);
+    level[source] = 0;
+
+    auto degree = [&](Vertex v) { return graph.arcEnd(v) - graph.arcBegin(v); };
+    auto chunkCount = [](std::size_t count, std::size_t chunk) { return (count + chunk - 1) / chunk; };
+
+    // Expand a frontier of several chunks on several workers; returns the
+    // arcs leaving the new frontier
+    auto topDown = [&](std::uint32_t depth) {
+        if (!lowest) {
+            claimed = Bitmap(n);
+            lowest.reset(new std::atomic<Vertex>[n]);
+            parallelChunks(n, VertexChunk, threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+                for (std::size_t v = begin; v < end; ++v) lowest[v].store(CsrGraph::npos, std::memory_order_relaxed);
+            });
+        }
+
+        const std::size_t chunks = chunkCount(frontier.size(), FrontierChunk);
+        if (buffers.size() < chunks) buffers.resize(chunks);
+        counts.assign(chunks, 0);
+        parallelChunks(frontier.size(), FrontierChunk, threads, [&](std::size_t c, std::size_t begin, std::size_t end) {
+            std::vector<Vertex> &found = buffers[c];
+            found.clear();
+            for (std::size_t i = begin; i < end; ++i) {
+                const Vertex u = frontier[i];
+                for (std::size_t a = graph.arcBegin(u); a < graph.arcEnd(u); ++a) {
+                    const Vertex w = graph.target(a);
+                    if (visited.test(w)) continue;
+                    Vertex current = lowest[w].load(std::memory_order_relaxed);
+                    while (u < current && !lowest[w].compare_exchange_weak(current, u, std::memory_order_relaxed)) {}
+                    if (claimed.claim(w)) {
+                        found.push_back(w);
+                        counts[c] += degree(w);
+                    }
+                }
+            }
+        });
+
+        next.clear();
+        std::size_t scout = 0;
+        for (std::size_t c = 0; c < chunks; ++c) {
+            next.insert(next.end(), buffers[c].begin(), buffers[c].end());
+            scout += counts[c];
+        }
+        parallelChunks(next.size(), FrontierChunk, threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const Vertex w = next[i];
+                visited.set(w);
+                claimed.reset(w);
+                level[w] = depth + 1;
+                parent[w] = lowest[w].load(std::memory_order_relaxed);
+            }
+        });
+        std::swap(frontier, next);
+        return scout;
+    };
+
+    // Every unvisited vertex looks for a parent in `front`; returns how many found one
+    auto bottomUp = [&](std::uint32_t depth) {
+        const std::size_t chunks = chunkCount(n, VertexChunk);
+        counts.assign(chunks, 0);
+        parallelChunks(n, VertexChunk, threads, [&](std::size_t c, std::size_t begin, std::size_t end) {
+            for (std::size_t w = begin / 64; w < chunkCount(end, 64); ++w) {
+                const Word seen = visited.word(w);
+                if (seen == ~Word(0)) {
+                    nextFront.setWord(w, 0);
+                    continue;
+                }
+                Word fresh = 0;
+                for (std::size_t v = w * 64; v < std::min(end, w * 64 + 64); ++v) {
+                    if ((seen >> (v & 63)) & 1) continue;
+                    for (std::size_t a = incoming->begin((Vertex)v); a < incoming->end((Vertex)v); ++a) {
+                        const Vertex u = incoming->source(a);
+                        if (!front.test(u)) continue;
+                        parent[v] = u;
+                        level[v] = depth + 1;
+                        fresh |= Word(1) << (v & 63);
+                        ++counts[c];
+                        break;
+                    }
+                }
+                if (fresh) visited.setWord(w, seen | fresh);
+                nextFront.setWord(w, fresh);
+            }
+        });
+        std::swap(front, nextFront);
+
+        std::size_t awake = 0;
+        for (std::size_t count : counts) awake += count;
+        return awake;
+    };
+
+    auto queueToBitmap = [&] {
+        parallelChunks(front.wordCount(), VertexChunk / 64, threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (std::size_t w = begin; w < end; ++w) front.setWord(w, 0);
+        });
+        parallelChunks(frontier.size(), FrontierChunk, threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) front.set(frontier[i]);
+        });
+    };
+
+    // Frontier bitmap back to a queue in vertex order
+    auto bitmapToQueue = [&] {
+        const std::size_t chunks = chunkCount(n, VertexChunk);
+        if (buffers.size() < chunks) buffers.resize(chunks);
+        parallelChunks(n, VertexChunk, threads, [&](std::size_t c, std::size_t begin, std::size_t end) {
+            std::vector<Vertex> &found = buffers[c];
+            found.clear();
+            for (std::size_t w = begin / 64; w < chunkCount(end, 64); ++w)
+                for (Word bits = front.word(w); bits; bits &= bits - 1)
+                    found.push_back((Vertex)(w * 64 + lowestBit(bits)));
+        });
+        frontier.clear();
+        for (std::size_t c = 0; c < chunks; ++c) frontier.insert(frontier.end(), buffers[c].begin(), buffers[c].end());
+    };
+
+    // Frontiers that are one chunk or less (paths, grids, the first levels
+    // of anything) or with nobody to share them: a plain FIFO on this
+    // thread across as many levels as stay that way. Later finds of a
+    // vertex queued on the same level still lower its parent, so the tree
+    // matches the parallel levels'.
+    std::size_t unexplored = graph.arcCount(); // arcs not yet scanned top-down
+    std::size_t scout = degree(source);
+    bool growing = true; // frontier larger than the level before
+    std::size_t reached = 1;
+    std::uint32_t depth = 0;
+
+    auto serialLevels = [&] {
+        // locals, so stores into level/parent cannot alias them
+        std::uint32_t *levels = level.data();
+        Vertex *parents = parent.data();
+        std::uint32_t d = depth;
+        std::size_t arcs = 0, head = 0, levelBegin = 0, levelEnd = frontier.size();
+        bool finished = true;
+        unexplored -= std::min(unexplored, scout);
+
+        while (head < frontier.size()) {
+            const Vertex u = frontier[head++];
+            for (std::size_t a = graph.arcBegin(u); a < graph.arcEnd(u); ++a) {
+                const Vertex w = graph.target(a);
+                if (levels[w] == BfsTree::Unreached) {
+                    levels[w] = d + 1;
+                    parents[w] = u;
+                    frontier.push_back(w);
+                    arcs += degree(w);
+                } else if (levels[w] == d + 1 && u < parents[w]) {
+                    parents[w] = u;
+                }
+            }
+            if (head < levelEnd) continue;
+
+            // level done; frontier[levelEnd..] is the next one
+            ++d;
+            const std::size_t size = frontier.size() - levelEnd;
+            reached += size;
+            growing = size > levelEnd - levelBegin;
+            if ((workers > 1 && size > FrontierChunk) || (growing && arcs * Alpha > unexplored)) break;
+            if (control && (d & 255) == 0) {
+                if (control->isCancelled()) {
+                    finished = false;
+                    break;
+                }
+                control->report(reached, n);
+            }
+            unexplored -= std::min(unexplored, arcs);
+            arcs = 0;
+            if (head >= FrontierChunk) {
+                frontier.erase(frontier.begin(), frontier.begin() + head);
+                head = 0;
+            }
+            levelBegin = head;
+            levelEnd = frontier.size();
+        }
+        frontier.erase(frontier.begin(), frontier.begin() + head);
+        visitedStale = true;
+        depth = d;
+        scout = arcs;
+        return finished;
+    };
+
+    // Serial levels only fill in `level`; the bitmap phases need `visited`
+    auto refreshVisited = [&] {
+        if (!visitedStale) return;
+        parallelChunks(visited.wordCount(), VertexChunk / 64, threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (std::size_t w = begin; w < end; ++w) {
+                Word bits = 0;
+                for (std::size_t v = w * 64; v < std::min(n, w * 64 + 64); ++v)
+                    if (level[v] != BfsTree::Unreached) bits |= Word(1) << (v & 63);
+                visited.setWord(w, bits);
+            }
+        });
+        visitedStale = false;
+    };
+
+    while (!frontier.empty()) {
+        if (control && control->isCancelled()) return false;
+        if (control) control->report(reached, n);
+
+        if (growing && scout * Alpha > unexplored) {
+            if (!incoming) {
+                incoming = std::make_unique<IncomingArcs>(graph);
+                front = Bitmap(n);
+                nextFront = Bitmap(n);
+            }
+            refreshVisited();
+            queueToBitmap();
+            std::size_t awake = frontier.size(), previous;
+            do {
+                if (control && control->isCancelled()) return false;
+                previous = awake;
+                awake = bottomUp(depth++);
+                reached += awake;
+            } while (awake && (awake >= previous || awake > n / Beta));
+            bitmapToQueue();
+            scout = 1;
+            growing = false;
+        } else if (workers == 1 || frontier.size() <= FrontierChunk) {
+            if (!serialLevels()) return false;
+        } else {
+            const std::size_t previous = frontier.size();
+            refreshVisited();
+            unexplored -= std::min(unexplored, scout);
+            scout = topDown(depth++);
+            reached += frontier.size();
+            growing = frontier.size() > previous;
+        }
+    }
+    return true;
+}
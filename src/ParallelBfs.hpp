@@ -0,0 +1,23 @@
+#ifndef PARALLELBFS_HPP
+#define PARALLELBFS_HPP
+
+#include "Algorithms.hpp"
+#include <cstdint>
+#include <vector>
+
+// Level-synchronous BFS behind bfsTree(). Each level either expands the
+// frontier queue (top-down) or lets every unvisited vertex look for a
+// parent in the frontier bitmap (bottom-up), whichever touches fewer arcs
+// (Beamer, Asanovic & Patterson, "Direction-Optimizing Breadth-First
+// Search"). Levels run in fixed-size chunks over `threads` workers
+// (0 = all cores); small frontiers stay on the calling thread.
+//
+// level[v] is the hop count from source (BfsTree::Unreached if none) and
+// parent[v] a vertex one level up with an arc to v (npos for the source
+// and unreached vertices). Top-down levels keep the smallest such parent,
+// bottom-up levels the first in v's incoming arc order, so the tree does
+// not depend on the thread count. Returns false if cancelled.
+bool bfsDirectionOptimizing(const CsrGraph &graph, CsrGraph::Vertex source, std::vector<std::uint32_t> &level,
+                            std::vector<CsrGraph::Vertex> &parent, RunControl *control, unsigned threads = 0);
+
+#endif // PARALLELBFS_HPP
@@ -0,0 +1,236 @@
+#include "PointToPoint.hpp"
+#include "BellmanFord.hpp"
+#include "IncomingArcs.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+using Vertex = CsrGraph::Vertex;
+constexpr long long Unreachable = PathDistances::Unreachable;
+
+bool hasNegativeArc(const CsrGraph &graph) {
+    for (std::size_t a = 0; a < graph.arcCount(); ++a)
+        if (graph.weight(a) < 0) return true;
+    return false;
+}
+
+// Progress and cancellation, looked at every 1024 pops
+bool interrupted(RunControl *control, std::size_t settled, std::size_t total) {
+    if (!control || (settled & 1023) != 0) return false;
+    control->report(settled, total);
+    return control->isCancelled();
+}
+
+// Graphs with a negative arc: the label-correcting engine from the source
+// over the whole graph (a negative arc found later may still lower the
+// target's distance, so it can't stop there), the route read off its tree
+bool labelCorrecting(const CsrGraph &graph, Vertex source, Vertex target, Route &out, RunControl *control,
+                     StepLog *steps) {
+    ShortestPathTree tree;
+    if (!ssspBellmanFord(graph, source, tree, control, steps)) return false;
+    out.settled = tree.scanned;
+    out.negativeCycle = tree.negativeCycle;
+    if (tree.negativeCycle || tree.dist[target] == Unreachable) return true;
+    out.distance = tree.dist[target];
+    out.path = tree.path(target);
+    return true;
+}
+
+// Lowest weight per unit of straight-line length over all arcs, shaved so
+// rounding can't lift an estimate past an arc's weight; 0 when there is
+// no usable one (coordinates short of the graph, no arc of positive
+// length, or one of weight 0)
+double euclideanScale(const CsrGraph &graph, const std::vector<Point> &coordinates) {
+    if (coordinates.size() < graph.vertexCount()) return 0;
+    double scale = HUGE_VAL;
+    for (Vertex u = 0; u < graph.vertexCount(); ++u) {
+        for (std::size_t a = graph.arcBegin(u); a < graph.arcEnd(u); ++a) {
+            const Vertex v = graph.target(a);
+            const double len = std::hypot(coordinates[u].x - coordinates[v].x, coordinates[u].y - coordinates[v].y);
+            if (len > 0) scale = std::min(scale, graph.weight(a) / len);
+        }
+    }
+    if (!(scale > 0) || scale == HUGE_VAL) return 0;
+    return scale * (1 - 1e-9);
+}
+
+// `scale` times the straight-line distance to `goal`
+template <typename Points>
+Heuristic straightLine(Points coordinates, double scale, Point goal) {
+    return [coordinates, scale, goal](Vertex v) {
+        const Point &p = (*coordinates)[v];
+        return (long long)std::floor(scale * std::hypot(p.x - goal.x, p.y - goal.y));
+    };
+}
+
+} // namespace
+
+bool routeBidirectional(const CsrGraph &graph, Vertex source, Vertex target, Route &out, RunControl *control,
+                        StepLog *steps) {
+    return RouteSearch(graph).bidirectional(source, target, out, control, steps);
+}
+
+bool routeAStar(const CsrGraph &graph, Vertex source, Vertex target, const Heuristic &heuristic, Route &out,
+                RunControl *control, StepLog *steps) {
+    return RouteSearch(graph).aStar(source, target, heuristic, out, control, steps);
+}
+
+Heuristic euclideanHeuristic(const CsrGraph &graph, const std::vector<Point> &coordinates, Vertex target) {
+    if (target >= graph.vertexCount()) return {};
+    const double scale = euclideanScale(graph, coordinates);
+    if (scale == 0) return {};
+    return straightLine(&coordinates, scale, coordinates[target]);
+}
+
+// ------------------ RouteSearch ------------------
+RouteSearch::RouteSearch(const CsrGraph &graph) : network(graph), negative(hasNegativeArc(graph)) {
+    for (Side *side : {&forward, &backward})
+        side->labels.assign(graph.vertexCount(), Label{Unreachable, 0, CsrGraph::npos});
+}
+
+RouteSearch::~RouteSearch() = default;
+
+void RouteSearch::nextStamp() {
+    if (++stamp != 0) return;
+    for (Side *side : {&forward, &backward})
+        for (Label &label : side->labels) label.seen = 0;
+    stamp = 1;
+}
+
+void RouteSearch::trace(const Side &side, Vertex target, std::vector<Vertex> &path) const {
+    path.clear();
+    for (Vertex v = target; v != CsrGraph::npos; v = side.labels[v].pred) path.push_back(v);
+    std::reverse(path.begin(), path.end());
+}
+
+// The queue in `slot`, emptied of what an early stop left in it
+template <typename Queue>
+Queue &RouteSearch::queue(std::unique_ptr<Queue> &slot) {
+    if (!slot) slot = std::make_unique<Queue>(network.vertexCount());
+    else slot->clear();
+    return *slot;
+}
+
+template <typename Queue>
+bool RouteSearch::bidirectionalSearch(Queue &forwardQueue, Queue &backwardQueue, Vertex source, Vertex target,
+                                      Route &out, RunControl *control, StepLog *steps) {
+    const std::size_t n = network.vertexCount();
+    forward.labels[source] = Label{0, stamp, CsrGraph::npos};
+    forwardQueue.push(source, 0);
+    backward.labels[target] = Label{0, stamp, CsrGraph::npos};
+    backwardQueue.push(target, 0);
+    long long best = source == target ? 0 : Unreachable;
+    Vertex meet = source == target ? source : CsrGraph::npos;
+
+    // Lower v's distance on `self`; a vertex both sides reach joins two halves of a route
+    auto relax = [&](Side &self, Queue &queue, const Side &other, Vertex u, Vertex v, long long candidate,
+                     std::size_t arc) {
+        if (candidate >= dist(self, v)) return;
+        self.labels[v] = Label{candidate, stamp, u};
+        queue.push(v, candidate);
+        if (steps) steps->push(StepKind::DistanceUpdate, v, u, candidate, (std::uint32_t)arc);
+        const long long rest = dist(other, v);
+        if (rest != Unreachable && candidate + rest < best) {
+            best = candidate + rest;
+            meet = v;
+        }
+    };
+
+    while (!forwardQueue.empty() && !backwardQueue.empty()) {
+        const long long forwardMin = forwardQueue.top().first, backwardMin = backwardQueue.top().first;
+        // no unsettled vertex can lie on a route shorter than best
+        if (forwardMin + backwardMin >= best) break;
+
+        if (forwardMin <= backwardMin) {
+            auto [d, u] = forwardQueue.pop();
+            if (interrupted(control, ++out.settled, n)) return false;
+            if (steps) steps->push(StepKind::Processing, u, CsrGraph::npos, d);
+            for (std::size_t a = network.arcBegin(u); a < network.arcEnd(u); ++a)
+                relax(forward, forwardQueue, backward, u, network.target(a), d + network.weight(a), a);
+        } else {
+            auto [d, u] = backwardQueue.pop();
+            if (interrupted(control, ++out.settled, n)) return false;
+            if (steps) steps->push(StepKind::Processing, u, CsrGraph::npos, d);
+            for (std::size_t i = incoming->begin(u); i < incoming->end(u); ++i)
+                relax(backward, backwardQueue, forward, u, incoming->source(i), d + incoming->weight(i),
+                      incoming->arc(i));
+        }
+    }
+
+    if (meet == CsrGraph::npos) return true;
+    out.distance = best;
+    trace(forward, meet, out.path);
+    for (Vertex v = backward.labels[meet].pred; v != CsrGraph::npos; v = backward.labels[v].pred)
+        out.path.push_back(v);
+    return true;
+}
+
+template <typename Queue>
+bool RouteSearch::aStarSearch(Queue &queue, Vertex source, Vertex target, const Heuristic &heuristic, Route &out,
+                              RunControl *control, StepLog *steps) {
+    const std::size_t n = network.vertexCount();
+    // Each vertex's estimate is asked for once, when it is first reached
+    auto lowerBound = [&](Vertex v) { return heuristic ? std::max(0LL, heuristic(v)) : 0; };
+    forward.labels[source] = Label{0, stamp, CsrGraph::npos};
+    estimate[source] = lowerBound(source);
+    queue.push(source, estimate[source]);
+
+    while (!queue.empty()) {
+        const Vertex u = queue.pop().second;
+        if (interrupted(control, ++out.settled, n)) return false;
+        const long long d = forward.labels[u].dist;
+        if (steps) steps->push(StepKind::Processing, u, CsrGraph::npos, d);
+        if (u == target) break;
+        for (std::size_t a = network.arcBegin(u); a < network.arcEnd(u); ++a) {
+            const Vertex v = network.target(a);
+            const long long candidate = d + network.weight(a);
+            const long long known = dist(forward, v);
+            if (candidate >= known) continue;
+            if (known == Unreachable) estimate[v] = lowerBound(v);
+            forward.labels[v] = Label{candidate, stamp, u};
+            queue.push(v, candidate + estimate[v]);
+            if (steps) steps->push(StepKind::DistanceUpdate, v, u, candidate, (std::uint32_t)a);
+        }
+    }
+
+    if (dist(forward, target) == Unreachable) return true;
+    out.distance = forward.labels[target].dist;
+    trace(forward, target, out.path);
+    return true;
+}
+
+bool RouteSearch::bidirectional(Vertex source, Vertex target, Route &out, RunControl *control, StepLog *steps) {
+    out = Route();
+    if (source >= network.vertexCount() || target >= network.vertexCount()) return true;
+    if (negative) return labelCorrecting(network, source, target, out, control, steps);
+    if (!incoming) incoming = std::make_unique<const IncomingArcs>(network);
+    nextStamp();
+    // the radix heap pops equal distances in no set order, which only steps show
+    if (steps)
+        return bidirectionalSearch(queue(forward.quad), queue(backward.quad), source, target, out, control, steps);
+    return bidirectionalSearch(queue(forward.radix), queue(backward.radix), source, target, out, control, steps);
+}
+
+bool RouteSearch::aStar(Vertex source, Vertex target, const Heuristic &heuristic, Route &out, RunControl *control,
+                        StepLog *steps) {
+    out = Route();
+    if (source >= network.vertexCount() || target >= network.vertexCount()) return true;
+    if (negative) return labelCorrecting(network, source, target, out, control, steps);
+    if (estimate.empty()) estimate.resize(network.vertexCount());
+    nextStamp();
+    // keys only grow without a heuristic, but an inconsistent one can lower them
+    if (steps || heuristic) return aStarSearch(queue(forward.quad), source, target, heuristic, out, control, steps);
+    return aStarSearch(queue(forward.radix), source, target, heuristic, out, control, steps);
+}
+
+void RouteSearch::setCoordinates(std::shared_ptr<const std::vector<Point>> coordinates) {
+    if (coordinates == points) return;
+    points = std::move(coordinates);
+    scale = points ? euclideanScale(network, *points) : 0;
+}
+
+Heuristic RouteSearch::euclidean(Vertex target) const {
+    if (scale == 0 || target >= network.vertexCount()) return {};
+    return straightLine(points, scale, (*points)[target]);
+}
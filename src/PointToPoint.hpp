@@ -0,0 +1,115 @@
+#ifndef POINTTOPOINT_HPP
+#define POINTTOPOINT_HPP
+
+#include "Algorithms.hpp"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+class IncomingArcs;
+
+// Point-to-point shortest routes behind shortestRoute(), bidirectionalDijkstra()
+// and aStar(). Both searches stop as soon as the route to the target is
+// known, so a nearby target costs a small part of a full Dijkstra run.
+//
+// Graphs with a negative arc can't stop early: they get a label-correcting
+// search from the source that runs to the end, and give up on a reachable
+// negative cycle (Route::negativeCycle). With a StepLog the searches record
+// a Processing step per vertex taken off a queue and a DistanceUpdate step
+// per lowered distance. They return false if cancelled.
+
+// Lower bound on the distance from a vertex to the target. A* expects it to
+// be admissible (never above the real distance); a consistent one (h(u) <=
+// w(u, v) + h(v) for every arc) also takes every vertex off the queue once.
+using Heuristic = std::function<long long(CsrGraph::Vertex)>;
+
+// Dijkstra from the source and, over the incoming arcs, from the target,
+// growing whichever side has the smaller queue minimum. Every distance a
+// side lowers is checked against the other side's for the best route so
+// far; the search ends once the two minima add up to at least that.
+// One-off query (allocates a RouteSearch).
+bool routeBidirectional(const CsrGraph &graph, CsrGraph::Vertex source, CsrGraph::Vertex target, Route &out,
+                        RunControl *control, StepLog *steps = nullptr);
+
+// A* (Hart, Nilsson & Raphael): Dijkstra keyed by distance + heuristic,
+// ending when the target comes off the queue. Vertices are reopened when
+// an inconsistent heuristic finds them a shorter distance later. An empty
+// heuristic counts as zero (Dijkstra stopping at the target). One-off
+// query (allocates a RouteSearch).
+bool routeAStar(const CsrGraph &graph, CsrGraph::Vertex source, CsrGraph::Vertex target, const Heuristic &heuristic,
+                Route &out, RunControl *control, StepLog *steps = nullptr);
+
+// Straight-line distance to the target, scaled by the lowest weight per
+// unit of length over all arcs so no arc is shorter than the heuristic
+// claims: consistent whenever the weights are non-negative. Zero when the
+// coordinates don't cover the graph or an arc of weight 0 has a length.
+Heuristic euclideanHeuristic(const CsrGraph &graph, const std::vector<Point> &coordinates,
+                             CsrGraph::Vertex target);
+
+// The searches above as a reusable query object for one graph. Whether an
+// arc is negative, the incoming arcs and the straight-line scale are found
+// once, not per query, and the per-vertex labels and queues are kept: a
+// query only resets what the one before it touched. One query at a time;
+// the graph must outlive it.
+class RouteSearch {
+public:
+    using Vertex = CsrGraph::Vertex;
+
+    explicit RouteSearch(const CsrGraph &graph);
+    ~RouteSearch();
+
+    const CsrGraph &graph() const { return network; }
+
+    // routeBidirectional() and routeAStar() on this graph
+    bool bidirectional(Vertex source, Vertex target, Route &out, RunControl *control = nullptr,
+                       StepLog *steps = nullptr);
+    bool aStar(Vertex source, Vertex target, const Heuristic &heuristic, Route &out, RunControl *control = nullptr,
+               StepLog *steps = nullptr);
+
+    // euclideanHeuristic() over the coordinates last set. Setting them
+    // works out the scale, which takes a pass over the arcs unless they
+    // are the ones already set; the search keeps them alive.
+    void setCoordinates(std::shared_ptr<const std::vector<Point>> coordinates);
+    Heuristic euclidean(Vertex target) const;
+
+private:
+    // Everything a side keeps per vertex; valid where seen == the query's stamp
+    struct Label {
+        long long dist;
+        std::uint32_t seen;
+        Vertex pred; // towards the side's root
+    };
+
+    // One direction of the search; its queues are made on first use
+    struct Side {
+        std::vector<Label> labels;
+        std::unique_ptr<QuadHeap<long long>> quad;
+        std::unique_ptr<RadixHeap<long long>> radix;
+    };
+
+    void nextStamp();
+    long long dist(const Side &side, Vertex v) const {
+        return side.labels[v].seen == stamp ? side.labels[v].dist : PathDistances::Unreachable;
+    }
+    void trace(const Side &side, Vertex target, std::vector<Vertex> &path) const;
+    template <typename Queue>
+    Queue &queue(std::unique_ptr<Queue> &slot);
+    template <typename Queue>
+    bool bidirectionalSearch(Queue &forwardQueue, Queue &backwardQueue, Vertex source, Vertex target, Route &out,
+                             RunControl *control, StepLog *steps);
+    template <typename Queue>
+    bool aStarSearch(Queue &queue, Vertex source, Vertex target, const Heuristic &heuristic, Route &out,
+                     RunControl *control, StepLog *steps);
+
+    const CsrGraph &network;
+    bool negative;                                // label-correcting search instead
+    std::unique_ptr<const IncomingArcs> incoming; // built by the first bidirectional query
+    Side forward, backward;
+    std::vector<long long> estimate; // A*: heuristic per vertex forward has reached
+    std::uint32_t stamp = 0;
+    std::shared_ptr<const std::vector<Point>> points;
+    double scale = 0; // straight-line scale for points, 0 if there is no usable one
+};
+
+#endif // POINTTOPOINT_HPP
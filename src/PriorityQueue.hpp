@@ -0,0 +1,267 @@
+#ifndef PRIORITYQUEUE_HPP
+#define PRIORITYQUEUE_HPP
+
+#include "CsrGraph.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+// Min-priority queues over the vertices 0..n-1 of a graph, each vertex
+// queued with at most one key at a time. They share one interface, so
+// algorithms can take the queue as a template parameter:
+//
+//   Queue(std::size_t n)
+//   bool empty()
+//   void push(Vertex v, Key key)      insert v, or change the key it is queued with
+//   std::pair<Key, Vertex> top()      smallest (key, vertex), left queued
+//   std::pair<Key, Vertex> pop()      remove the smallest (key, vertex)
+//   void clear()                      empty it, in time proportional to what it holds
+//   static constexpr bool Monotone    keys pushed must not be below the last popped one
+//
+// A popped vertex may be pushed again (label-correcting runs). Ties are
+// broken by the smaller vertex id, except in RadixHeap.
+
+// std::priority_queue with lazy deletion: push adds an entry and pop
+// skips entries whose key is no longer the vertex's current one
+template <typename Key>
+class LazyHeap {
+public:
+    using Vertex = CsrGraph::Vertex;
+    static constexpr bool Monotone = false;
+
+    explicit LazyHeap(std::size_t n) : current(n), queued(n, 0) {}
+
+    bool empty() {
+        while (!entries.empty() && !isCurrent(entries.top())) entries.pop();
+        return entries.empty();
+    }
+
+    void push(Vertex v, Key key) {
+        current[v] = key;
+        queued[v] = 1;
+        entries.push({key, v});
+    }
+
+    std::pair<Key, Vertex> top() {
+        empty(); // drop stale entries above the minimum
+        return entries.top();
+    }
+
+    std::pair<Key, Vertex> pop() {
+        empty();
+        std::pair<Key, Vertex> top = entries.top();
+        entries.pop();
+        queued[top.second] = 0;
+        return top;
+    }
+
+    void clear() {
+        for (; !entries.empty(); entries.pop()) queued[entries.top().second] = 0;
+    }
+
+private:
+    using Entry = std::pair<Key, Vertex>;
+
+    bool isCurrent(const Entry &e) const { return queued[e.second] && current[e.second] == e.first; }
+
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> entries;
+    std::vector<Key> current;
+    std::vector<char> queued;
+};
+
+// Indexed d-ary heap with decrease-key. Each vertex has one slot, so the
+// heap never grows past n and holds no stale entries; a wider node makes
+// the tree shallower and sift-down scans children in one cache line.
+template <typename Key, unsigned Arity>
+class DaryHeap {
+public:
+    using Vertex = CsrGraph::Vertex;
+    static constexpr bool Monotone = false;
+
+    explicit DaryHeap(std::size_t n) : keys(n), slot(n, Absent) {}
+
+    bool empty() const { return heap.empty(); }
+
+    void push(Vertex v, Key key) {
+        if (slot[v] != Absent && keys[v] < key) {
+            keys[v] = key;
+            siftDown(slot[v]);
+            return;
+        }
+        keys[v] = key;
+        if (slot[v] == Absent) {
+            slot[v] = (std::uint32_t)heap.size();
+            heap.push_back(v);
+        }
+        siftUp(slot[v]);
+    }
+
+    std::pair<Key, Vertex> top() const { return {keys[heap.front()], heap.front()}; }
+
+    std::pair<Key, Vertex> pop() {
+        const Vertex top = heap.front();
+        slot[top] = Absent;
+        const Vertex last = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            heap[0] = last;
+            slot[last] = 0;
+            siftDown(0);
+        }
+        return {keys[top], top};
+    }
+
+    void clear() {
+        for (Vertex v : heap) slot[v] = Absent;
+        heap.clear();
+    }
+
+private:
+    static constexpr std::uint32_t Absent = ~std::uint32_t(0);
+
+    bool before(Vertex a, Vertex b) const { return keys[a] < keys[b] || (!(keys[b] < keys[a]) && a < b); }
+
+    void place(std::size_t i, Vertex v) {
+        heap[i] = v;
+        slot[v] = (std::uint32_t)i;
+    }
+
+    void siftUp(std::size_t i) {
+        const Vertex v = heap[i];
+        while (i > 0) {
+            const std::size_t parent = (i - 1) / Arity;
+            if (!before(v, heap[parent])) break;
+            place(i, heap[parent]);
+            i = parent;
+        }
+        place(i, v);
+    }
+
+    void siftDown(std::size_t i) {
+        const Vertex v = heap[i];
+        for (;;) {
+            const std::size_t first = i * Arity + 1;
+            if (first >= heap.size()) break;
+            const std::size_t end = std::min<std::size_t>(first + Arity, heap.size());
+            std::size_t best = first;
+            for (std::size_t c = first + 1; c < end; ++c)
+                if (before(heap[c], heap[best])) best = c;
+            if (!before(heap[best], v)) break;
+            place(i, heap[best]);
+            i = best;
+        }
+        place(i, v);
+    }
+
+    std::vector<Vertex> heap;
+    std::vector<Key> keys;
+    std::vector<std::uint32_t> slot; // position in heap, Absent if not queued
+};
+
+template <typename Key>
+using QuadHeap = DaryHeap<Key, 4>;
+
+// Indexed radix heap for non-negative integer keys that never drop below
+// the last popped one (Dijkstra with non-negative weights). Bucket 0 holds
+// keys equal to the last popped key, bucket b > 0 those whose highest bit
+// differing from it is b - 1. Pop refills bucket 0 by spreading the lowest
+// non-empty bucket over the ones below it, so each vertex moves down at
+// most 64 times. Vertices with equal keys come out in no particular order.
+template <typename Key>
+class RadixHeap {
+public:
+    using Vertex = CsrGraph::Vertex;
+    static constexpr bool Monotone = true;
+
+    explicit RadixHeap(std::size_t n) : keys(n), bucketOf(n, Absent), slot(n) {}
+
+    bool empty() const { return size == 0; }
+
+    void push(Vertex v, Key key) {
+        if (bucketOf[v] != Absent) unlink(v);
+        else ++size;
+        keys[v] = key;
+        link(v, bucketFor(key));
+    }
+
+    std::pair<Key, Vertex> top() {
+        if (buckets[0].empty()) refill();
+        return {keys[buckets[0].back()], buckets[0].back()};
+    }
+
+    std::pair<Key, Vertex> pop() {
+        if (buckets[0].empty()) refill();
+        const Vertex v = buckets[0].back();
+        buckets[0].pop_back();
+        bucketOf[v] = Absent;
+        --size;
+        return {keys[v], v};
+    }
+
+    // also forgets the last popped key, so keys may start over from 0
+    void clear() {
+        for (std::vector<Vertex> &bucket : buckets) {
+            for (Vertex v : bucket) bucketOf[v] = Absent;
+            bucket.clear();
+        }
+        size = 0;
+        last = 0;
+    }
+
+private:
+    static constexpr unsigned Buckets = 65;
+    static constexpr std::uint8_t Absent = 0xff;
+
+    static unsigned highestBit(std::uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - (unsigned)__builtin_clzll(bits);
+#else
+        unsigned bit = 0;
+        while (bits >>= 1) ++bit;
+        return bit;
+#endif
+    }
+
+    unsigned bucketFor(Key key) const {
+        const std::uint64_t diff = (std::uint64_t)key ^ (std::uint64_t)last;
+        return diff ? highestBit(diff) + 1 : 0;
+    }
+
+    void link(Vertex v, unsigned b) {
+        bucketOf[v] = (std::uint8_t)b;
+        slot[v] = (std::uint32_t)buckets[b].size();
+        buckets[b].push_back(v);
+    }
+
+    void unlink(Vertex v) {
+        std::vector<Vertex> &bucket = buckets[bucketOf[v]];
+        const Vertex moved = bucket.back();
+        bucket[slot[v]] = moved;
+        slot[moved] = slot[v];
+        bucket.pop_back();
+    }
+
+    void refill() {
+        unsigned b = 1;
+        while (buckets[b].empty()) ++b;
+        std::vector<Vertex> spread;
+        spread.swap(buckets[b]);
+        last = keys[spread.front()];
+        for (Vertex v : spread) last = std::min(last, keys[v]);
+        for (Vertex v : spread) link(v, bucketFor(keys[v]));
+        spread.clear();
+        buckets[b].swap(spread); // keep the capacity
+    }
+
+    std::vector<Vertex> buckets[Buckets];
+    std::vector<Key> keys;
+    std::vector<std::uint8_t> bucketOf; // Absent if not queued
+    std::vector<std::uint32_t> slot;    // position in its bucket
+    std::size_t size = 0;
+    Key last = 0;
+};
+
+#endif // PRIORITYQUEUE_HPP
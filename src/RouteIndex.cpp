@@ -0,0 +1,94 @@
+#include "RouteIndex.hpp"
+
+namespace {
+
+// The index in `slot`, building it first if it's neither there nor known
+// to be unbuildable
+template <typename Index, typename Build>
+const Index *acquire(std::unique_ptr<Index> &slot, std::string &failure, Build build, RunControl *control,
+                     std::string *error) {
+    if (slot) return slot.get();
+    if (!failure.empty()) {
+        if (error) *error = failure;
+        return nullptr;
+    }
+    auto index = std::make_unique<Index>();
+    std::string why;
+    if (build(*index, &why)) {
+        slot = std::move(index);
+        return slot.get();
+    }
+    // a cancelled build is not held against the graph
+    if (control && control->isCancelled()) why = "cancelled";
+    else failure = why;
+    if (error) *error = why;
+    return nullptr;
+}
+
+template <typename Index>
+bool load(std::unique_ptr<Index> &slot, std::string &failure, std::istream &in, const CsrGraph &graph,
+          std::string *error) {
+    auto index = std::make_unique<Index>();
+    if (!index->load(in, graph, error)) return false;
+    slot = std::move(index);
+    failure.clear();
+    return true;
+}
+
+} // namespace
+
+RouteIndex::RouteIndex(std::shared_ptr<const CsrGraph> graph) : frozen(std::move(graph)) {}
+
+const LandmarkIndex *RouteIndex::landmarks(RunControl *control, std::string *error) {
+    std::lock_guard<std::mutex> guard(lock);
+    return acquire(alt.index, alt.failure,
+                   [&](LandmarkIndex &index, std::string *why) {
+                       return index.build(*frozen, LandmarkIndex::DefaultLandmarks, control, why);
+                   },
+                   control, error);
+}
+
+const ContractionHierarchy *RouteIndex::hierarchy(RunControl *control, std::string *error) {
+    std::lock_guard<std::mutex> guard(lock);
+    return acquire(ch.index, ch.failure,
+                   [&](ContractionHierarchy &index, std::string *why) { return index.build(*frozen, control, why); },
+                   control, error);
+}
+
+RouteIndex::Lease RouteIndex::search() {
+    {
+        std::lock_guard<std::mutex> guard(idleLock);
+        if (!idle.empty()) {
+            std::unique_ptr<RouteSearch> search = std::move(idle.back());
+            idle.pop_back();
+            return Lease(*this, std::move(search));
+        }
+    }
+    // built outside the lock: it takes a pass over the graph
+    return Lease(*this, std::make_unique<RouteSearch>(*frozen));
+}
+
+void RouteIndex::giveBack(std::unique_ptr<RouteSearch> search) {
+    std::lock_guard<std::mutex> guard(idleLock);
+    idle.push_back(std::move(search));
+}
+
+bool RouteIndex::loadLandmarks(std::istream &in, std::string *error) {
+    std::lock_guard<std::mutex> guard(lock);
+    return load(alt.index, alt.failure, in, *frozen, error);
+}
+
+bool RouteIndex::loadHierarchy(std::istream &in, std::string *error) {
+    std::lock_guard<std::mutex> guard(lock);
+    return load(ch.index, ch.failure, in, *frozen, error);
+}
+
+bool RouteIndex::saveLandmarks(std::ostream &out) {
+    const LandmarkIndex *index = landmarks();
+    return index && index->save(out);
+}
+
+bool RouteIndex::saveHierarchy(std::ostream &out) {
+    const ContractionHierarchy *index = hierarchy();
+    return index && index->save(out);
+}
@@ -0,0 +1,84 @@
+#ifndef ROUTEINDEX_HPP
+#define ROUTEINDEX_HPP
+
+#include "ContractionHierarchy.hpp"
+#include "Landmarks.hpp"
+#include "PointToPoint.hpp"
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Preprocessed route indexes for one frozen graph, built the first time a
+// query asks for them and kept for every query after that. Whoever owns
+// the RouteIndex drops it when the graph changes (Graph::revision()).
+//
+// The accessors may be called from several threads; the first caller
+// builds, the others wait for it. An index that can't be built (negative
+// weights, overlong distances) is remembered as such and not retried, one
+// whose build was cancelled is tried again next time.
+//
+// Queries without an index lease a RouteSearch, so the graph-wide setup
+// and the per-vertex scratch of one query serve the next; concurrent
+// queries each get their own.
+class RouteIndex {
+public:
+    // A RouteSearch on the graph held by one caller, handed back to the
+    // index when the Lease goes
+    class Lease {
+    public:
+        Lease(RouteIndex &owner, std::unique_ptr<RouteSearch> search) : owner(owner), held(std::move(search)) {}
+        Lease(const Lease &) = delete;
+        Lease &operator=(const Lease &) = delete;
+        ~Lease() { owner.giveBack(std::move(held)); }
+
+        RouteSearch &operator*() const { return *held; }
+        RouteSearch *operator->() const { return held.get(); }
+
+    private:
+        RouteIndex &owner;
+        std::unique_ptr<RouteSearch> held;
+    };
+
+    explicit RouteIndex(std::shared_ptr<const CsrGraph> graph);
+
+    const CsrGraph &graph() const { return *frozen; }
+    std::shared_ptr<const CsrGraph> sharedGraph() const { return frozen; }
+
+    // The index, or nullptr (and error) if it can't be built or the build
+    // was cancelled
+    const LandmarkIndex *landmarks(RunControl *control = nullptr, std::string *error = nullptr);
+    const ContractionHierarchy *hierarchy(RunControl *control = nullptr, std::string *error = nullptr);
+
+    // An idle search from an earlier query, or a new one
+    Lease search();
+
+    // Index files (see IndexFile.hpp). load*() fails, keeping whatever was
+    // there, on a file built for another graph; save*() builds the index
+    // first if need be.
+    bool loadLandmarks(std::istream &in, std::string *error = nullptr);
+    bool loadHierarchy(std::istream &in, std::string *error = nullptr);
+    bool saveLandmarks(std::ostream &out);
+    bool saveHierarchy(std::ostream &out);
+
+private:
+    // One lazily built index and why it couldn't be
+    template <typename Index>
+    struct Slot {
+        std::unique_ptr<Index> index;
+        std::string failure; // empty while untried or buildable
+    };
+
+    std::shared_ptr<const CsrGraph> frozen;
+    std::mutex lock;
+    Slot<LandmarkIndex> alt;
+    Slot<ContractionHierarchy> ch;
+    std::mutex idleLock; // apart from lock, which is held through index builds
+    std::vector<std::unique_ptr<RouteSearch>> idle;
+
+    void giveBack(std::unique_ptr<RouteSearch> search);
+};
+
+#endif // ROUTEINDEX_HPP
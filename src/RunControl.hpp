@@ -0,0 +1,32 @@
+#ifndef RUNCONTROL_HPP
+#define RUNCONTROL_HPP
+
+#include <atomic>
+#include <cstddef>
+
+// RunControl: shared between the thread running an algorithm and the one
+// watching it. Algorithms poll isCancelled() in their outer loops and stop
+// cooperatively; they publish progress as a per-mille fraction.
+class RunControl {
+public:
+    void cancel() { cancelled.store(true, std::memory_order_relaxed); }
+    bool isCancelled() const { return cancelled.load(std::memory_order_relaxed); }
+
+    void report(std::size_t done, std::size_t total) {
+        int value = total ? (int)(done * 1000 / total) : 1000;
+        permille.store(value > 1000 ? 1000 : value, std::memory_order_relaxed);
+    }
+    int progress() const { return permille.load(std::memory_order_relaxed); } // 0..1000
+
+    // Ready the control for another run
+    void reset() {
+        cancelled.store(false, std::memory_order_relaxed);
+        permille.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<bool> cancelled{false};
+    std::atomic<int> permille{0};
+};
+
+#endif // RUNCONTROL_HPP
@@ -0,0 +1,175 @@
+#include "SpanningForest.hpp"
+#include "Parallel.hpp"
+#include <atomic>
+
+namespace {
+
+using Vertex = CsrGraph::Vertex;
+
+constexpr std::size_t Chunk = 1 << 14;          // keys per parallel work item
+constexpr std::size_t KruskalRange = 1 << 12;   // filter-Kruskal sorts ranges this small
+constexpr std::uint64_t NoEdge = UINT64_MAX;
+
+// An edge with its key and endpoints side by side, so partitioning and
+// filtering stream through one array instead of chasing edge ids
+struct Candidate {
+    std::uint64_t key;
+    Vertex u, v;
+
+    bool operator<(const Candidate &other) const { return key < other.key; }
+};
+
+bool cancelled(const RunControl *control) {
+    return control && control->isCancelled();
+}
+
+// Keep the items[0, count) that `keep` accepts, in order; returns how
+// many. Chunks count their survivors, then copy them to their offsets in
+// scratch.
+template <typename Item, typename Keep>
+std::size_t compact(Item *items, std::size_t count, std::vector<Item> &scratch, unsigned threads, Keep keep) {
+    const std::size_t chunks = (count + Chunk - 1) / Chunk;
+    std::vector<std::size_t> offset(chunks + 1, 0);
+    parallelChunks(count, Chunk, threads, [&](std::size_t c, std::size_t begin, std::size_t end) {
+        std::size_t kept = 0;
+        for (std::size_t i = begin; i < end; ++i) kept += keep(items[i]);
+        offset[c + 1] = kept;
+    });
+    for (std::size_t c = 0; c < chunks; ++c) offset[c + 1] += offset[c];
+
+    scratch.resize(offset[chunks]);
+    parallelChunks(count, Chunk, threads, [&](std::size_t c, std::size_t begin, std::size_t end) {
+        std::size_t to = offset[c];
+        for (std::size_t i = begin; i < end; ++i)
+            if (keep(items[i])) scratch[to++] = items[i];
+    });
+    std::copy(scratch.begin(), scratch.end(), items);
+    return scratch.size();
+}
+
+// Every edge that is not a self-loop, unsorted
+std::vector<Candidate> candidates(const CsrGraph &graph, unsigned threads) {
+    std::vector<Candidate> edges(graph.edgeCount());
+    parallelChunks(edges.size(), Chunk, threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t e = begin; e < end; ++e)
+            edges[e] = {edgeKey(graph, e), graph.edgeSource(e), graph.edgeTarget(e)};
+    });
+    std::vector<Candidate> scratch;
+    edges.resize(compact(edges.data(), edges.size(), scratch, threads, [](const Candidate &c) { return c.u != c.v; }));
+    return edges;
+}
+
+void take(const CsrGraph &graph, std::uint64_t key, SpanningForest &out) {
+    out.edges.push_back(keyEdge(key));
+    out.weight += graph.edgeWeight(keyEdge(key));
+}
+
+// ---- Filter-Kruskal ----
+class FilterKruskal {
+public:
+    FilterKruskal(const CsrGraph &graph, SpanningForest &out, RunControl *control, unsigned threads)
+        : graph(graph), out(out), control(control), threads(threads), sets(graph.vertexCount()) {}
+
+    bool run(Candidate *first, std::size_t count) {
+        if (cancelled(control)) return false;
+        if (full() || count == 0) return true;
+        if (count <= KruskalRange) {
+            std::sort(first, first + count);
+            for (std::size_t i = 0; i < count && !full(); ++i)
+                if (sets.unite(first[i].u, first[i].v)) take(graph, first[i].key, out);
+            if (control) control->report(out.edges.size(), graph.vertexCount() - 1);
+            return true;
+        }
+
+        // The middle of three spread samples is neither the smallest nor
+        // the largest key, so both halves shrink
+        std::uint64_t sample[3] = {first[0].key, first[count / 2].key, first[count - 1].key};
+        std::sort(sample, sample + 3);
+        const std::uint64_t pivot = sample[1];
+        Candidate *heavy = std::partition(first, first + count, [&](const Candidate &c) { return c.key < pivot; });
+        const std::size_t light = (std::size_t)(heavy - first);
+
+        if (!run(first, light)) return false;
+        if (full()) return true;
+        // no one unites while the filter runs, so find() may be shared
+        std::size_t kept = compact(heavy, count - light, scratch, threads,
+                                   [&](const Candidate &c) { return sets.find(c.u) != sets.find(c.v); });
+        return run(heavy, kept);
+    }
+
+private:
+    bool full() const { return out.edges.size() + 1 >= graph.vertexCount(); }
+
+    const CsrGraph &graph;
+    SpanningForest &out;
+    RunControl *control;
+    unsigned threads;
+    UnionFind sets;
+    std::vector<Candidate> scratch;
+};
+
+} // namespace
+
+void sortedEdgeKeys(const CsrGraph &graph, std::vector<std::uint64_t> &keys, unsigned threads) {
+    keys.resize(graph.edgeCount());
+    parallelChunks(keys.size(), Chunk, threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t e = begin; e < end; ++e) keys[e] = edgeKey(graph, e);
+    });
+    parallelSort(keys.begin(), keys.end(), std::less<std::uint64_t>(), threads);
+}
+
+bool spanningForestFilterKruskal(const CsrGraph &graph, SpanningForest &out, RunControl *control,
+                                 unsigned threads) {
+    out = SpanningForest();
+    std::vector<Candidate> edges = candidates(graph, threads);
+    FilterKruskal search(graph, out, control, threads);
+    return search.run(edges.data(), edges.size());
+}
+
+bool spanningForestBoruvka(const CsrGraph &graph, SpanningForest &out, RunControl *control, unsigned threads) {
+    out = SpanningForest();
+    const std::size_t n = graph.vertexCount();
+    std::vector<Candidate> live = candidates(graph, threads), scratch;
+    UnionFind sets(n);
+
+    // component[v]: the union-find root v's component had at the start of
+    // the round; lightest[c]: key of component c's lightest outgoing edge
+    std::vector<Vertex> component(n), roots(n);
+    for (Vertex v = 0; v < n; ++v) component[v] = roots[v] = v;
+    std::vector<std::atomic<std::uint64_t>> lightest(n);
+
+    auto lower = [](std::atomic<std::uint64_t> &slot, std::uint64_t key) {
+        std::uint64_t seen = slot.load(std::memory_order_relaxed);
+        while (key < seen && !slot.compare_exchange_weak(seen, key, std::memory_order_relaxed)) {
+        }
+    };
+
+    while (!live.empty()) {
+        if (cancelled(control)) return false;
+        for (Vertex c : roots) lightest[c].store(NoEdge, std::memory_order_relaxed);
+        parallelChunks(live.size(), Chunk, threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                lower(lightest[component[live[i].u]], live[i].key);
+                lower(lightest[component[live[i].v]], live[i].key);
+            }
+        });
+
+        // Two components picking the same edge take it once
+        for (Vertex c : roots) {
+            std::uint64_t key = lightest[c].load(std::memory_order_relaxed);
+            if (key == NoEdge) continue;
+            std::uint32_t e = keyEdge(key);
+            if (sets.unite(graph.edgeSource(e), graph.edgeTarget(e))) take(graph, key, out);
+        }
+        if (control) control->report(out.edges.size(), n - 1);
+
+        roots.erase(std::remove_if(roots.begin(), roots.end(), [&](Vertex c) { return sets.find(c) != c; }),
+                    roots.end());
+        parallelChunks(n, Chunk, threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (std::size_t v = begin; v < end; ++v) component[v] = sets.find(component[v]);
+        });
+        live.resize(compact(live.data(), live.size(), scratch, threads,
+                            [&](const Candidate &c) { return component[c.u] != component[c.v]; }));
+    }
+    return true;
+}
@@ -0,0 +1,80 @@
+#ifndef SPANNINGFOREST_HPP
+#define SPANNINGFOREST_HPP
+
+#include "Algorithms.hpp"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// Minimum spanning forests behind minimumSpanningForest(), over the edge
+// list of a CsrGraph with directions ignored (as kruskalMST() does).
+//
+// Edges are ordered by (weight, edge id), a total order, so the forest is
+// unique: Borůvka, filter-Kruskal and kruskalMST() all pick the same edges.
+// An edge's place in that order is its key, weight in the high half and id
+// in the low half, so keys compare as plain integers.
+
+// Disjoint sets over vertex ids with path halving and union by rank.
+// find() may run on several threads at once while no one unites: halving
+// only ever points a vertex at one of its own ancestors, so every thread
+// still reaches the same root.
+class UnionFind {
+public:
+    explicit UnionFind(std::size_t n) : parent(n), rank(n, 0) {
+        for (std::size_t v = 0; v < n; ++v) parent[v].store((CsrGraph::Vertex)v, std::memory_order_relaxed);
+    }
+
+    CsrGraph::Vertex find(CsrGraph::Vertex x) {
+        for (;;) {
+            CsrGraph::Vertex up = parent[x].load(std::memory_order_relaxed);
+            if (up == x) return x;
+            CsrGraph::Vertex above = parent[up].load(std::memory_order_relaxed);
+            parent[x].store(above, std::memory_order_relaxed);
+            x = above;
+        }
+    }
+
+    // False if x and y were already in one set
+    bool unite(CsrGraph::Vertex x, CsrGraph::Vertex y) {
+        x = find(x);
+        y = find(y);
+        if (x == y) return false;
+        if (rank[x] < rank[y]) std::swap(x, y);
+        parent[y].store(x, std::memory_order_relaxed);
+        if (rank[x] == rank[y]) ++rank[x];
+        return true;
+    }
+
+private:
+    std::vector<std::atomic<CsrGraph::Vertex>> parent;
+    std::vector<std::uint8_t> rank; // a tree of rank r has at least 2^r vertices
+};
+
+inline std::uint64_t edgeKey(const CsrGraph &graph, std::size_t e) {
+    // flipping the sign bit keeps negative weights below positive ones
+    std::uint32_t weight = (std::uint32_t)graph.edgeWeight(e) ^ 0x80000000u;
+    return (std::uint64_t)weight << 32 | (std::uint32_t)e;
+}
+
+inline std::uint32_t keyEdge(std::uint64_t key) { return (std::uint32_t)key; }
+
+// Every edge's key, sorted, on `threads` workers (0 = all cores)
+void sortedEdgeKeys(const CsrGraph &graph, std::vector<std::uint64_t> &keys, unsigned threads = 0);
+
+// Borůvka: each round every component takes its lightest edge, found in
+// parallel over the edges still joining two components; components are
+// merged and edges inside one dropped before the next round. At most
+// log2(V) rounds. Edges are listed round by round.
+bool spanningForestBoruvka(const CsrGraph &graph, SpanningForest &out, RunControl *control = nullptr,
+                           unsigned threads = 0);
+
+// Filter-Kruskal (Osipov, Sanders & Singler, "The Filter-Kruskal Minimum
+// Spanning Tree Algorithm"): quicksort-style partitioning around a sampled
+// pivot key. The light half is handled first; the heavy half is then
+// filtered in parallel, dropping edges whose endpoints the light half has
+// already joined, so most heavy edges are never sorted. Small ranges are
+// sorted and scanned as in Kruskal. Edges are listed in key order.
+bool spanningForestFilterKruskal(const CsrGraph &graph, SpanningForest &out, RunControl *control = nullptr,
+                                 unsigned threads = 0);
+
+#endif // SPANNINGFOREST_HPP
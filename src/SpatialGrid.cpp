@@ -0,0 +1,70 @@
+#include "SpatialGrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+void SpatialGrid::build(const std::vector<Box> &boxes) {
+    clear();
+    if (boxes.empty()) return;
+
+    double maxX = boxes[0].maxX, maxY = boxes[0].maxY;
+    originX = boxes[0].minX;
+    originY = boxes[0].minY;
+    for (const Box &b : boxes) {
+        originX = std::min(originX, b.minX);
+        originY = std::min(originY, b.minY);
+        maxX = std::max(maxX, b.maxX);
+        maxY = std::max(maxY, b.maxY);
+    }
+
+    // about two items per cell, and never more cells than a few per item
+    const double width = std::max(maxX - originX, 1.0), height = std::max(maxY - originY, 1.0);
+    cell = std::max(std::sqrt(2 * width * height / boxes.size()), 1e-6);
+    columns = std::min((long)(width / cell) + 1, 4096L);
+    rows = std::min((long)(height / cell) + 1, 4096L);
+    cell = std::max(width / columns, height / rows) * (1 + 1e-9);
+
+    // Counting sort of the (cell, item) pairs
+    cellBegin.assign((std::size_t)(columns * rows) + 1, 0);
+    std::vector<bool> wide(boxes.size(), false);
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+        long x0, y0, x1, y1;
+        cellRange(boxes[i], x0, y0, x1, y1);
+        if ((std::size_t)((x1 - x0 + 1) * (y1 - y0 + 1)) > MaxSpan) {
+            wide[i] = true;
+            large.push_back((std::uint32_t)i);
+            continue;
+        }
+        for (long y = y0; y <= y1; ++y)
+            for (long x = x0; x <= x1; ++x) ++cellBegin[(std::size_t)(y * columns + x) + 1];
+    }
+    for (std::size_t c = 0; c + 1 < cellBegin.size(); ++c) cellBegin[c + 1] += cellBegin[c];
+    items.resize(cellBegin.back());
+    std::vector<std::uint32_t> fill(cellBegin.begin(), cellBegin.end() - 1);
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+        if (wide[i]) continue;
+        long x0, y0, x1, y1;
+        cellRange(boxes[i], x0, y0, x1, y1);
+        for (long y = y0; y <= y1; ++y)
+            for (long x = x0; x <= x1; ++x) items[fill[(std::size_t)(y * columns + x)]++] = (std::uint32_t)i;
+    }
+    seen.assign(boxes.size(), 0);
+}
+
+void SpatialGrid::clear() {
+    columns = rows = 0;
+    cellBegin.clear();
+    items.clear();
+    large.clear();
+    seen.clear();
+    generation = 0;
+}
+
+void SpatialGrid::cellRange(const Box &box, long &x0, long &y0, long &x1, long &y1) const {
+    auto column = [&](double x) { return std::clamp((long)std::floor((x - originX) / cell), 0L, columns - 1); };
+    auto row = [&](double y) { return std::clamp((long)std::floor((y - originY) / cell), 0L, rows - 1); };
+    x0 = column(box.minX);
+    x1 = column(box.maxX);
+    y0 = row(box.minY);
+    y1 = row(box.maxY);
+}
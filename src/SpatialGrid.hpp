@@ -0,0 +1,72 @@
+#ifndef SPATIALGRID_HPP
+#define SPATIALGRID_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// SpatialGrid: uniform grid over axis-aligned boxes, for finding the items
+// a viewport rectangle may touch without testing every one of them.
+//
+// Cells are sized so each holds a couple of items on average. A box is
+// filed under every cell it overlaps; one spanning more than MaxSpan cells
+// (a long edge) is kept on a short list that every query reports instead.
+class SpatialGrid {
+public:
+    struct Box {
+        double minX, minY, maxX, maxY;
+    };
+
+    // Index boxes[i] as item i, replacing whatever was indexed before
+    void build(const std::vector<Box> &boxes);
+    void clear();
+
+    // Call visit(i) once for every item filed under a cell `area` overlaps:
+    // each item whose box intersects `area`, and possibly a few nearby ones
+    template <typename Visit>
+    void query(const Box &area, Visit visit) const;
+
+private:
+    static constexpr std::size_t MaxSpan = 64;
+
+    // Cells `box` overlaps, clamped to the grid
+    void cellRange(const Box &box, long &x0, long &y0, long &x1, long &y1) const;
+
+    double originX = 0, originY = 0, cell = 1;
+    long columns = 0, rows = 0;
+    std::vector<std::uint32_t> cellBegin; // items of cell c: items[cellBegin[c] .. cellBegin[c + 1])
+    std::vector<std::uint32_t> items;
+    std::vector<std::uint32_t> large;     // boxes spanning too many cells
+
+    // Items already reported by the running query carry its generation
+    mutable std::vector<std::uint32_t> seen;
+    mutable std::uint32_t generation = 0;
+};
+
+template <typename Visit>
+void SpatialGrid::query(const Box &area, Visit visit) const {
+    for (std::uint32_t i : large) visit(i);
+    if (columns == 0 || area.maxX < originX || area.maxY < originY ||
+        area.minX > originX + columns * cell || area.minY > originY + rows * cell)
+        return;
+
+    if (++generation == 0) {
+        std::fill(seen.begin(), seen.end(), 0);
+        generation = 1;
+    }
+    long x0, y0, x1, y1;
+    cellRange(area, x0, y0, x1, y1);
+    for (long y = y0; y <= y1; ++y) {
+        for (long x = x0; x <= x1; ++x) {
+            const std::size_t c = (std::size_t)(y * columns + x);
+            for (std::uint32_t k = cellBegin[c]; k < cellBegin[c + 1]; ++k) {
+                const std::uint32_t i = items[k];
+                if (seen[i] == generation) continue;
+                seen[i] = generation;
+                visit(i);
+            }
+        }
+    }
+}
+
+#endif // SPATIALGRID_HPP
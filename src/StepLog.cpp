@@ -0,0 +1,161 @@
+#include "StepLog.hpp"
+#include <algorithm>
+#include <sstream>
+
+void StepLog::reserve(std::size_t eventCount, std::size_t payloadCount) {
+    events.reserve(eventCount);
+    payloadWords.reserve(payloadCount);
+}
+
+void StepLog::push(StepKind kind, Span<std::uint32_t> payload, std::int64_t value) {
+    if (!enabled) return;
+    StepEvent e{kind, InvalidNode, InvalidNode, InvalidEdge, value,
+                (std::uint32_t)payloadWords.size(), (std::uint32_t)payload.size()};
+    payloadWords.insert(payloadWords.end(), payload.begin(), payload.end());
+    events.push_back(e);
+    if (sink && events.size() >= flushAt) flush();
+}
+
+void StepLog::clear() {
+    events.clear();
+    payloadWords.clear();
+}
+
+void StepLog::setSink(Sink newSink, std::size_t newMaxChunk) {
+    sink = std::move(newSink);
+    maxChunk = std::max<std::size_t>(newMaxChunk, 1);
+    flushAt = 1;
+}
+
+void StepLog::flush() {
+    if (!sink || events.empty()) return;
+
+    StepLog chunk;
+    chunk.events.swap(events);
+    chunk.payloadWords.swap(payloadWords);
+    sink(std::move(chunk));
+
+    flushAt = std::min(flushAt * 2, maxChunk);
+    events.reserve(flushAt);
+}
+
+static const char *algorithmName(std::int64_t kind) {
+    switch ((AlgorithmKind)kind) {
+    case AlgorithmKind::DFS:            return "DFS";
+    case AlgorithmKind::BFS:            return "BFS";
+    case AlgorithmKind::Dijkstra:       return "Dijkstra";
+    case AlgorithmKind::BellmanFord:    return "Bellman-Ford";
+    case AlgorithmKind::FloydWarshall:  return "Floyd-Warshall";
+    case AlgorithmKind::Prim:           return "Prim's MST";
+    case AlgorithmKind::Kruskal:        return "Kruskal's MST";
+    case AlgorithmKind::CycleDetection: return "Cycle detection";
+    case AlgorithmKind::DeltaStepping:  return "Delta-stepping";
+    case AlgorithmKind::BidirectionalDijkstra: return "Bidirectional Dijkstra";
+    case AlgorithmKind::AStar:          return "A*";
+    case AlgorithmKind::ContractionHierarchy: return "Contraction hierarchy";
+    case AlgorithmKind::Landmarks:      return "ALT (landmark A*)";
+    case AlgorithmKind::Boruvka:        return "Borůvka's MST";
+    case AlgorithmKind::StrongComponents: return "Strongly Connected Components";
+    }
+    return "Algorithm";
+}
+
+std::string describeStep(const StepEvent &e, Span<std::uint32_t> payload,
+                         const std::vector<std::string> &names) {
+    auto name = [&](NodeId id) -> std::string {
+        return id < names.size() ? names[id] : std::string("?");
+    };
+    const std::string value = std::to_string(e.value);
+
+    switch (e.kind) {
+    case StepKind::Started:
+        if (e.u == InvalidNode) return std::string("Starting ") + algorithmName(e.value);
+        return std::string("Starting ") + algorithmName(e.value) + " from " + name(e.u);
+    case StepKind::Completed:
+        if ((AlgorithmKind)e.value == AlgorithmKind::CycleDetection) return "Cycle detection completed.";
+        return std::string("✅ ") + algorithmName(e.value) + " completed successfully!";
+    case StepKind::StartNotFound:
+        return "Start node not found in graph.";
+    case StepKind::NoNodes:
+        return std::string(algorithmName(e.value)) + ": graph has no nodes.";
+    case StepKind::Visited:
+        return "Visited: " + name(e.u);
+    case StepKind::Queued:
+        return "Queued: " + name(e.u);
+    case StepKind::Processing:
+        return "Processing: " + name(e.u) + " (distance " + value + ")";
+    case StepKind::DistanceUpdate:
+        return "Updating: " + name(e.u) + " to " + value;
+    case StepKind::PathUpdate: {
+        std::string path;
+        for (std::size_t i = 0; i < payload.size(); ++i) {
+            if (i) path += " -> ";
+            path += name(payload[i]);
+        }
+        return "Path: " + path + " = " + value;
+    }
+    case StepKind::EdgeHighlight:
+        return "Edge update highlight: " + name(e.u) + " -> " + name(e.v);
+    case StepKind::NegativeCycle:
+        return "❌ Negative weight cycle detected! Aborting visualization.";
+    case StepKind::ResetColors:
+        return "RESET_COLORS";
+    case StepKind::MstConsider:
+        return "Considering edge " + name(e.u) + " - " + name(e.v) + " (weight " + value + ")";
+    case StepKind::MstAdd:
+        return "Edge added to MST: " + name(e.u) + " - " + name(e.v) + " (weight " + value + ")";
+    case StepKind::MstSkip:
+        return "Skipping edge (already in MST or would form cycle): " + name(e.u) + " - " + name(e.v) + " (weight " + value + ")";
+    case StepKind::MstReject:
+        return "Rejected (would form cycle): " + name(e.u) + " - " + name(e.v);
+    case StepKind::MstResult: {
+        // machine-parsable: "MST_RESULT: total=T; edges=u-v:w,..."
+        std::ostringstream oss;
+        oss << "MST_RESULT: total=" << e.value << "; edges=";
+        for (std::size_t i = 0; i + 2 < payload.size(); i += 3) {
+            if (i) oss << ",";
+            oss << name(payload[i]) << "-" << name(payload[i + 1]) << ":" << (std::int32_t)payload[i + 2];
+        }
+        return oss.str();
+    }
+    case StepKind::DirectedCycle: {
+        std::string cycle = "Cycle detected (Directed): ";
+        for (std::size_t i = 0; i < payload.size(); ++i) {
+            if (i) cycle += " -> ";
+            cycle += name(payload[i]);
+        }
+        return cycle;
+    }
+    case StepKind::UndirectedCycle:
+        return "Cycle detected (Undirected): " + name(e.u) + " <-> " + name(e.v);
+    case StepKind::GoalNotFound:
+        return "Goal node not found in graph.";
+    case StepKind::RouteFound: {
+        std::string route;
+        for (std::size_t i = 0; i < payload.size(); ++i) {
+            if (i) route += " -> ";
+            route += name(payload[i]);
+        }
+        return "Shortest route: " + route + " = " + value;
+    }
+    case StepKind::NoRoute:
+        return "No route from the start node to the goal node.";
+    case StepKind::StrongComponent: {
+        std::string members;
+        for (std::size_t i = 0; i < payload.size(); ++i) {
+            if (i) members += ", ";
+            members += name(payload[i]);
+        }
+        return "Strongly connected component " + value + ": " + members;
+    }
+    case StepKind::SccResult: {
+        // machine-parsable: "SCC_RESULT: components=K; cyclic=C; on_cycles=N; dag_edges=E"
+        std::ostringstream oss;
+        oss << "SCC_RESULT: components=" << e.value;
+        if (payload.size() == 3)
+            oss << "; cyclic=" << payload[0] << "; on_cycles=" << payload[1] << "; dag_edges=" << payload[2];
+        return oss.str();
+    }
+    }
+    return {};
+}
@@ -0,0 +1,111 @@
+#ifndef STEPLOG_HPP
+#define STEPLOG_HPP
+
+#include "Graph.hpp"
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+
+// Which algorithm a Started/Completed step belongs to
+enum class AlgorithmKind : std::uint8_t {
+    DFS, BFS, Dijkstra, BellmanFord, FloydWarshall, Prim, Kruskal, CycleDetection,
+    DeltaStepping, BidirectionalDijkstra, AStar, ContractionHierarchy, Landmarks, Boruvka,
+    StrongComponents
+};
+
+enum class StepKind : std::uint8_t {
+    Started,          // u = start node (or none), value = AlgorithmKind
+    Completed,        // value = AlgorithmKind
+    StartNotFound,    // the requested start node is not in the graph
+    NoNodes,          // graph is empty, value = AlgorithmKind
+    Visited,          // u
+    Queued,           // u
+    Processing,       // u settled at distance value
+    DistanceUpdate,   // u's tentative distance lowered to value
+    PathUpdate,       // payload = path of node ids from the source, value = distance
+    EdgeHighlight,    // u -> v
+    NegativeCycle,
+    ResetColors,      // GUI control: revert every highlight
+    MstConsider,      // u - v, value = weight
+    MstAdd,           // u - v, value = weight
+    MstSkip,          // u - v, value = weight (Prim: target already in tree)
+    MstReject,        // u - v (Kruskal: would close a cycle)
+    MstResult,        // value = total weight, payload = (u, v, weight) triples
+    DirectedCycle,    // payload = cycle nodes, closing node repeated at the end
+    UndirectedCycle,  // u <-> v
+    GoalNotFound,     // the requested goal node is not in the graph
+    RouteFound,       // payload = route from start to goal, value = its length
+    NoRoute,          // the goal can't be reached from the start
+    StrongComponent,  // payload = member nodes, value = component id
+    SccResult,        // value = component count, payload = (cyclic components, nodes on cycles, DAG edges)
+};
+
+constexpr std::uint32_t InvalidEdge = std::numeric_limits<std::uint32_t>::max();
+
+// One algorithm step. Plain data: no strings, no ownership.
+struct StepEvent {
+    StepKind kind;
+    NodeId u;
+    NodeId v;
+    std::uint32_t edge;         // CsrGraph arc index, or InvalidEdge
+    std::int64_t value;
+    std::uint32_t payloadBegin; // range in the owning StepLog's payload arena
+    std::uint32_t payloadSize;
+};
+
+// StepLog: append-only buffer of StepEvents plus a payload arena for the
+// few steps that carry a variable-length node list. Algorithms append to
+// it; text is only produced by describeStep() when a step is displayed.
+//
+// With a sink attached, the log hands out its contents in chunks (sizes
+// doubling from 1 up to maxChunk) so a consumer on another thread sees the
+// first steps immediately and later ones in cheap batches.
+class StepLog {
+public:
+    using Sink = std::function<void(StepLog &&chunk)>;
+
+    explicit StepLog(bool enabled = true) : enabled(enabled) {}
+
+    // A disabled log drops everything (benchmarks, batch runs)
+    bool isEnabled() const { return enabled; }
+
+    void reserve(std::size_t eventCount, std::size_t payloadWords = 0);
+
+    void push(StepKind kind, NodeId u = InvalidNode, NodeId v = InvalidNode,
+              std::int64_t value = 0, std::uint32_t edge = InvalidEdge) {
+        if (!enabled) return;
+        events.push_back({kind, u, v, edge, value, 0, 0});
+        if (sink && events.size() >= flushAt) flush();
+    }
+
+    void push(StepKind kind, Span<std::uint32_t> payload, std::int64_t value = 0);
+
+    std::size_t size() const { return events.size(); }
+    bool empty() const { return events.empty(); }
+    const StepEvent &operator[](std::size_t i) const { return events[i]; }
+    Span<std::uint32_t> payload(const StepEvent &e) const {
+        return Span<std::uint32_t>(payloadWords.data() + e.payloadBegin, e.payloadSize);
+    }
+
+    void clear();
+
+    void setSink(Sink sink, std::size_t maxChunk);
+    void flush(); // hand buffered steps to the sink now
+
+private:
+    bool enabled;
+    std::vector<StepEvent> events;
+    std::vector<std::uint32_t> payloadWords;
+
+    Sink sink;
+    std::size_t flushAt = 1;
+    std::size_t maxChunk = 1;
+};
+
+// Human-readable text for one step (node names indexed by NodeId)
+std::string describeStep(const StepEvent &event, Span<std::uint32_t> payload,
+                         const std::vector<std::string> &names);
+
+#endif // STEPLOG_HPP
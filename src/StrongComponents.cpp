@@ -0,0 +1,303 @@
+#include "StrongComponents.hpp"
+#include "DepthFirst.hpp"
+#include "IncomingArcs.hpp"
+#include "Parallel.hpp"
+#include <atomic>
+
+namespace {
+
+using Vertex = CsrGraph::Vertex;
+
+constexpr std::size_t FrontierChunk = 1024;  // frontier vertices per parallel work item
+constexpr std::size_t VertexChunk = 1 << 14; // vertices per parallel work item
+constexpr std::uint32_t CancelPoll = 4096;   // Tarjan checks for cancellation every this many vertices
+
+bool cancelled(const RunControl *control) {
+    return control && control->isCancelled();
+}
+
+// Tarjan's lowlinks on the DepthFirstSearch hooks. examine() only sees arcs
+// to visited vertices; a tree arc's lowlink comes back when its child
+// finishes, at which point the parent is again on top of the path.
+struct TarjanVisitor : DfsVisitor {
+    const DepthFirstSearch &search;
+    std::vector<Vertex> &label;
+    RunControl *control;
+    std::vector<std::uint32_t> index, low;
+    std::vector<char> onStack;
+    std::vector<Vertex> stack;
+    std::uint32_t discovered = 0;
+
+    TarjanVisitor(const DepthFirstSearch &search, std::vector<Vertex> &label, RunControl *control)
+        : search(search), label(label), control(control), index(label.size()), low(label.size()),
+          onStack(label.size(), 0) {}
+
+    bool discover(Vertex v) {
+        index[v] = low[v] = discovered++;
+        stack.push_back(v);
+        onStack[v] = 1;
+        return discovered % CancelPoll != 0 || !cancelled(control);
+    }
+
+    bool examine(Vertex from, std::size_t, Vertex to) {
+        if (onStack[to]) low[from] = std::min(low[from], index[to]);
+        return true;
+    }
+
+    void finish(Vertex v) {
+        if (low[v] == index[v]) {
+            // v is the root of a component: everything above it on the stack
+            Vertex w;
+            do {
+                w = stack.back();
+                stack.pop_back();
+                onStack[w] = 0;
+                label[w] = v;
+            } while (w != v);
+        }
+        if (search.depth() > 0) {
+            Vertex parent = search.pathVertex(search.depth() - 1);
+            low[parent] = std::min(low[parent], low[v]);
+        }
+    }
+};
+
+// Grow a frontier level by level; expand(v, next) appends the vertices v
+// claims for the next level. Each chunk collects into its own buffer, so
+// the only shared state is whatever expand() claims atomically.
+template <typename Expand>
+bool levels(std::vector<Vertex> frontier, RunControl *control, unsigned threads, Expand expand) {
+    std::vector<std::vector<Vertex>> buffers;
+    std::vector<Vertex> next;
+    while (!frontier.empty()) {
+        if (cancelled(control)) return false;
+        buffers.resize((frontier.size() + FrontierChunk - 1) / FrontierChunk);
+        parallelChunks(frontier.size(), FrontierChunk, threads, [&](std::size_t c, std::size_t begin, std::size_t end) {
+            buffers[c].clear();
+            for (std::size_t i = begin; i < end; ++i) expand(frontier[i], buffers[c]);
+        });
+        next.clear();
+        for (const auto &buffer : buffers) next.insert(next.end(), buffer.begin(), buffer.end());
+        frontier.swap(next);
+    }
+    return true;
+}
+
+// ---- Trim + forward-backward ----
+class ForwardBackward {
+public:
+    ForwardBackward(const CsrGraph &graph, std::vector<Vertex> &label, RunControl *control, unsigned threads)
+        : graph(graph), incoming(graph), label(label), control(control), threads(threads),
+          placed(graph.vertexCount()), inLive(graph.vertexCount()), outLive(graph.vertexCount()) {
+        for (std::size_t v = 0; v < placed.size(); ++v)
+            placed[v].store(label[v] != SccUnlabelled, std::memory_order_relaxed);
+    }
+
+    // Peel off every vertex left without a live arc in or out, and those
+    // that lose their last one as a result
+    bool trim() {
+        const std::size_t n = graph.vertexCount();
+        countLiveArcs();
+        std::vector<std::vector<Vertex>> seeds((n + VertexChunk - 1) / VertexChunk);
+        parallelChunks(n, VertexChunk, threads, [&](std::size_t c, std::size_t begin, std::size_t end) {
+            for (std::size_t v = begin; v < end; ++v)
+                if (!isPlaced(v) && (inLive[v].load(std::memory_order_relaxed) == 0 ||
+                                     outLive[v].load(std::memory_order_relaxed) == 0))
+                    seeds[c].push_back((Vertex)v);
+        });
+        std::vector<Vertex> frontier;
+        for (const auto &seed : seeds) frontier.insert(frontier.end(), seed.begin(), seed.end());
+        for (Vertex v : frontier) placed[v].store(1, std::memory_order_relaxed);
+
+        return levels(std::move(frontier), control, threads, [&](Vertex v, std::vector<Vertex> &next) {
+            label[v] = v;
+            for (std::size_t a = graph.arcBegin(v); a < graph.arcEnd(v); ++a) {
+                Vertex w = graph.target(a);
+                if (w != v && !isPlaced(w) && inLive[w].fetch_sub(1, std::memory_order_relaxed) == 1 && claim(w))
+                    next.push_back(w);
+            }
+            for (std::size_t i = incoming.begin(v); i < incoming.end(v); ++i) {
+                Vertex u = incoming.source(i);
+                if (u != v && !isPlaced(u) && outLive[u].fetch_sub(1, std::memory_order_relaxed) == 1 && claim(u))
+                    next.push_back(u);
+            }
+        });
+    }
+
+    // The component of the live vertex with the most (in x out) live arcs:
+    // those it reaches that also reach it
+    bool peelPivot() {
+        const std::size_t n = graph.vertexCount();
+        const Vertex pivot = busiestLive();
+        if (pivot == CsrGraph::npos) return true;
+
+        // bit 1: reached forwards, bit 2: backwards
+        std::vector<std::atomic<std::uint8_t>> reached(n);
+        parallelChunks(n, VertexChunk, threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (std::size_t v = begin; v < end; ++v) reached[v].store(0, std::memory_order_relaxed);
+        });
+        reached[pivot].store(3, std::memory_order_relaxed);
+        auto mark = [&](Vertex w, std::uint8_t bit) {
+            return !isPlaced(w) && !(reached[w].fetch_or(bit, std::memory_order_relaxed) & bit);
+        };
+
+        bool finished =
+            levels({pivot}, control, threads, [&](Vertex v, std::vector<Vertex> &next) {
+                for (std::size_t a = graph.arcBegin(v); a < graph.arcEnd(v); ++a)
+                    if (mark(graph.target(a), 1)) next.push_back(graph.target(a));
+            }) &&
+            levels({pivot}, control, threads, [&](Vertex v, std::vector<Vertex> &next) {
+                for (std::size_t i = incoming.begin(v); i < incoming.end(v); ++i)
+                    if (mark(incoming.source(i), 2)) next.push_back(incoming.source(i));
+            });
+        if (!finished) return false;
+
+        parallelChunks(n, VertexChunk, threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (std::size_t v = begin; v < end; ++v) {
+                if (reached[v].load(std::memory_order_relaxed) != 3) continue;
+                label[v] = pivot;
+                placed[v].store(1, std::memory_order_relaxed);
+            }
+        });
+        return true;
+    }
+
+private:
+    bool isPlaced(std::size_t v) const { return placed[v].load(std::memory_order_relaxed); }
+    // Place v; true if this caller was the one to
+    bool claim(Vertex v) { return !placed[v].exchange(1, std::memory_order_relaxed); }
+
+    // Arcs between distinct live vertices; self-loops don't keep a vertex
+    // out of a component of its own
+    void countLiveArcs() {
+        parallelChunks(graph.vertexCount(), VertexChunk, threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (std::size_t v = begin; v < end; ++v) {
+                std::uint32_t out = 0, in = 0;
+                if (!isPlaced(v)) {
+                    for (std::size_t a = graph.arcBegin((Vertex)v); a < graph.arcEnd((Vertex)v); ++a)
+                        out += graph.target(a) != v && !isPlaced(graph.target(a));
+                    for (std::size_t i = incoming.begin((Vertex)v); i < incoming.end((Vertex)v); ++i)
+                        in += incoming.source(i) != v && !isPlaced(incoming.source(i));
+                }
+                outLive[v].store(out, std::memory_order_relaxed);
+                inLive[v].store(in, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    // Live vertex with the highest in x out live degree, npos if none is left
+    Vertex busiestLive() {
+        const std::size_t n = graph.vertexCount();
+        std::vector<std::pair<std::uint64_t, Vertex>> best((n + VertexChunk - 1) / VertexChunk,
+                                                            {0, CsrGraph::npos});
+        parallelChunks(n, VertexChunk, threads, [&](std::size_t c, std::size_t begin, std::size_t end) {
+            for (std::size_t v = begin; v < end; ++v) {
+                if (isPlaced(v)) continue;
+                std::uint64_t score = (std::uint64_t)inLive[v].load(std::memory_order_relaxed) *
+                                      outLive[v].load(std::memory_order_relaxed);
+                if (best[c].second == CsrGraph::npos || score > best[c].first) best[c] = {score, (Vertex)v};
+            }
+        });
+        std::pair<std::uint64_t, Vertex> pick{0, CsrGraph::npos};
+        for (const auto &b : best)
+            if (b.second != CsrGraph::npos && (pick.second == CsrGraph::npos || b.first > pick.first)) pick = b;
+        return pick.second;
+    }
+
+    const CsrGraph &graph;
+    IncomingArcs incoming;
+    std::vector<Vertex> &label;
+    RunControl *control;
+    unsigned threads;
+    std::vector<std::atomic<std::uint8_t>> placed;            // labelled, or claimed by the trim frontier
+    std::vector<std::atomic<std::uint32_t>> inLive, outLive;  // arcs from / to other live vertices
+};
+
+} // namespace
+
+bool sccTarjan(const CsrGraph &graph, std::vector<Vertex> &label, RunControl *control) {
+    const std::size_t n = graph.vertexCount();
+    label.resize(n, SccUnlabelled);
+    DepthFirstSearch search(graph);
+    for (Vertex v = 0; v < n; ++v)
+        if (label[v] != SccUnlabelled) search.exclude(v);
+
+    TarjanVisitor tarjan(search, label, control);
+    for (Vertex v = 0; v < n; ++v) {
+        if (search.isVisited(v)) continue;
+        if (cancelled(control) || !search.search(v, tarjan)) return false;
+        if (control) control->report(v, n);
+    }
+    return true;
+}
+
+bool sccForwardBackward(const CsrGraph &graph, std::vector<Vertex> &label, RunControl *control, unsigned threads) {
+    label.resize(graph.vertexCount(), SccUnlabelled);
+    // one worker gains nothing from the extra passes
+    if (resolveThreads(threads) == 1) return sccTarjan(graph, label, control);
+    ForwardBackward split(graph, label, control, threads);
+    if (!split.trim() || !split.peelPivot() || !split.trim()) return false;
+    return sccTarjan(graph, label, control);
+}
+
+void sccCondense(const CsrGraph &graph, const std::vector<Vertex> &label, StrongComponents &out) {
+    const std::size_t n = graph.vertexCount();
+    out = StrongComponents();
+
+    // labels are vertex ids; renumber them in order of first appearance
+    std::vector<std::uint32_t> number(n, UINT32_MAX), size;
+    out.component.resize(n);
+    for (Vertex v = 0; v < n; ++v) {
+        std::uint32_t &c = number[label[v]];
+        if (c == UINT32_MAX) {
+            c = (std::uint32_t)size.size();
+            size.push_back(0);
+        }
+        out.component[v] = c;
+        ++size[c];
+    }
+    out.count = size.size();
+    out.cyclic.resize(out.count);
+    for (std::size_t c = 0; c < out.count; ++c) out.cyclic[c] = size[c] > 1;
+
+    // Arcs between components, bucketed by source, then deduplicated
+    out.dagBegin.assign(out.count + 1, 0);
+    for (Vertex u = 0; u < n; ++u) {
+        for (std::size_t a = graph.arcBegin(u); a < graph.arcEnd(u); ++a) {
+            if (graph.target(a) == u) out.cyclic[out.component[u]] = 1;
+            else if (out.component[graph.target(a)] != out.component[u]) ++out.dagBegin[out.component[u] + 1];
+        }
+    }
+    for (std::size_t c = 0; c < out.count; ++c) out.dagBegin[c + 1] += out.dagBegin[c];
+    out.dagTargets.resize(out.dagBegin[out.count]);
+    std::vector<std::size_t> fill(out.dagBegin.begin(), out.dagBegin.end() - 1);
+    for (Vertex u = 0; u < n; ++u) {
+        const std::uint32_t cu = out.component[u];
+        for (std::size_t a = graph.arcBegin(u); a < graph.arcEnd(u); ++a) {
+            const std::uint32_t cv = out.component[graph.target(a)];
+            if (cv != cu) out.dagTargets[fill[cu]++] = cv;
+        }
+    }
+    std::size_t kept = 0;
+    for (std::size_t c = 0; c < out.count; ++c) {
+        auto first = out.dagTargets.begin() + out.dagBegin[c], last = out.dagTargets.begin() + out.dagBegin[c + 1];
+        std::sort(first, last);
+        last = std::unique(first, last);
+        out.dagBegin[c] = kept;
+        kept = std::copy(first, last, out.dagTargets.begin() + kept) - out.dagTargets.begin();
+    }
+    out.dagBegin[out.count] = kept;
+    out.dagTargets.resize(kept);
+
+    // Kahn's algorithm; sources are taken in id order
+    std::vector<std::uint32_t> indegree(out.count, 0);
+    for (std::uint32_t c : out.dagTargets) ++indegree[c];
+    out.order.reserve(out.count);
+    for (std::uint32_t c = 0; c < out.count; ++c)
+        if (indegree[c] == 0) out.order.push_back(c);
+    for (std::size_t i = 0; i < out.order.size(); ++i) {
+        const std::uint32_t c = out.order[i];
+        for (std::size_t j = out.dagBegin[c]; j < out.dagBegin[c + 1]; ++j)
+            if (--indegree[out.dagTargets[j]] == 0) out.order.push_back(out.dagTargets[j]);
+    }
+}
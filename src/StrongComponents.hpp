@@ -0,0 +1,41 @@
+#ifndef STRONGCOMPONENTS_HPP
+#define STRONGCOMPONENTS_HPP
+
+#include "Algorithms.hpp"
+#include <cstdint>
+#include <vector>
+
+// Strongly connected components behind strongComponents(), over the arcs
+// of a CsrGraph (an undirected edge joins its ends both ways).
+//
+// The engines label every vertex with a representative vertex of its
+// component; sccCondense() turns the labels into StrongComponents, so
+// the ids do not depend on which engine ran.
+
+// Label of a vertex no engine has placed yet
+constexpr CsrGraph::Vertex SccUnlabelled = CsrGraph::npos;
+
+// Tarjan's algorithm on the iterative DepthFirstSearch, over the vertices
+// still SccUnlabelled (the others are stepped over as if already done).
+// Each component is labelled with its DFS root. Returns false if cancelled.
+bool sccTarjan(const CsrGraph &graph, std::vector<CsrGraph::Vertex> &label, RunControl *control = nullptr);
+
+// Parallel decomposition for large graphs (after Hong, Rodia & Olukotun,
+// "On Fast Parallel Detection of Strongly Connected Components"):
+//   1. trim: a vertex with no live arc in, or none out, is a component of
+//      its own; removing it may expose more, level by level;
+//   2. forward-backward: the vertices both reachable from and reaching a
+//      high-degree pivot form its component, usually the giant one;
+//   3. trim again and hand what is left, typically small components, to
+//      sccTarjan().
+// Trimming and the two reachability searches run level-synchronously on
+// `threads` workers (0 = all cores); a single worker runs sccTarjan()
+// alone. Returns false if cancelled.
+bool sccForwardBackward(const CsrGraph &graph, std::vector<CsrGraph::Vertex> &label, RunControl *control = nullptr,
+                        unsigned threads = 0);
+
+// Number the labelled components by their smallest vertex and build the
+// condensation DAG and its topological order
+void sccCondense(const CsrGraph &graph, const std::vector<CsrGraph::Vertex> &label, StrongComponents &out);
+
+#endif // STRONGCOMPONENTS_HPP
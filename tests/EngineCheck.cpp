@@ -0,0 +1,434 @@
+// yggdrasilleon-check: runs every step-free engine of Algorithms.hpp
+// against a plain reference on seeded generated graphs and exits non-zero
+// on the first disagreements it prints.
+//
+// Graphs are directed and undirected, with ties, zero weights, negative
+// arcs (with and without a negative cycle) and unreachable parts. The
+// parallel engines run on several thread counts and must agree exactly
+// with the reference (distances, levels, forests, component ids) and
+// with themselves (BFS parents do not depend on the thread count).
+// Paths and trees are checked against the arcs they claim to follow.
+
+#include "Algorithms.hpp"
+#include "ContractionHierarchy.hpp"
+#include "Generators.hpp"
+#include "Landmarks.hpp"
+#include "PointToPoint.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Vertex = CsrGraph::Vertex;
+constexpr long long Unreachable = PathDistances::Unreachable;
+const unsigned ThreadCounts[] = {1, 2, 4, 8};
+
+// ---- Reporting ----
+int failures = 0;
+
+bool check(bool ok, const std::string &graph, const std::string &what) {
+    if (!ok && ++failures <= 20) std::printf("FAIL %s: %s\n", graph.c_str(), what.c_str());
+    return ok;
+}
+
+// ---- Graphs ----
+struct Case {
+    std::string name;
+    EdgeList edges;
+    CsrGraph graph;
+};
+
+bool generate(const std::string &spec, Case &out) {
+    GeneratorParams params;
+    params.threads = 2;
+    std::string error;
+    if (!parseGeneratorSpec(spec, params, &error) || !generateEdges(params, out.edges, &error)) {
+        std::printf("FAIL %s: %s\n", spec.c_str(), error.c_str());
+        ++failures;
+        return false;
+    }
+    out.name = spec;
+    return true;
+}
+
+// Negative arcs without a negative cycle: w + p(u) - p(v) keeps every
+// cycle's weight and shifts each path's by p(source) - p(target)
+void addPotentials(EdgeList &edges, unsigned seed) {
+    std::vector<int> potential(edges.nodeCount);
+    for (std::size_t v = 0; v < potential.size(); ++v) potential[v] = (int)((v * 2654435761u + seed) % 41);
+    for (std::size_t e = 0; e < edges.size(); ++e)
+        edges.weights[e] += potential[edges.from[e]] - potential[edges.to[e]];
+}
+
+std::vector<Case> buildCases() {
+    const char *plain[] = {
+        "erdos-renyi:nodes=300,edges=1200",
+        "erdos-renyi:nodes=300,edges=1200,directed=1",
+        "erdos-renyi:nodes=200,edges=150,directed=1",          // mostly unreachable
+        "erdos-renyi:nodes=250,edges=1500,wmin=0,wmax=3",      // zero weights and ties
+        "rmat:nodes=256,edges=1500,directed=1",
+        "barabasi-albert:nodes=300,m=3,wmin=1,wmax=5",
+        "grid:nodes=400",
+        "grid:nodes=300,directed=1,wmin=1,wmax=9",
+        "geometric:nodes=300,edges=1200",
+        "erdos-renyi:nodes=200,edges=900,directed=1,wmin=-3,wmax=30", // negative arcs, maybe cycles
+        "erdos-renyi:nodes=120,edges=300,wmin=-1,wmax=10",            // negative undirected edges: cycles
+    };
+    std::vector<Case> cases;
+    for (unsigned seed = 1; seed <= 3; ++seed) {
+        for (const char *spec : plain) {
+            Case c;
+            if (generate(std::string(spec) + ",seed=" + std::to_string(seed), c)) cases.push_back(std::move(c));
+        }
+        for (const char *spec : {"erdos-renyi:nodes=250,edges=1000,directed=1", "grid:nodes=225,directed=1"}) {
+            Case c;
+            if (!generate(std::string(spec) + ",seed=" + std::to_string(seed), c)) continue;
+            addPotentials(c.edges, seed);
+            c.name += " +potentials";
+            cases.push_back(std::move(c));
+        }
+    }
+    for (Case &c : cases) c.graph = toCsr(c.edges, 2);
+    return cases;
+}
+
+// ---- References ----
+// Cheapest arc u -> v, or Unreachable
+long long arcWeight(const CsrGraph &g, Vertex u, Vertex v) {
+    long long best = Unreachable;
+    for (std::size_t a = g.arcBegin(u); a < g.arcEnd(u); ++a)
+        if (g.target(a) == v) best = std::min(best, (long long)g.weight(a));
+    return best;
+}
+
+// Length of a source, ..., target walk along arcs, or Unreachable if it
+// leaves them
+long long walkLength(const CsrGraph &g, const std::vector<Vertex> &path) {
+    long long length = 0;
+    for (std::size_t i = 1; i < path.size(); ++i) {
+        long long w = arcWeight(g, path[i - 1], path[i]);
+        if (w == Unreachable) return Unreachable;
+        length += w;
+    }
+    return length;
+}
+
+std::vector<std::uint32_t> referenceLevels(const CsrGraph &g, Vertex s) {
+    std::vector<std::uint32_t> level(g.vertexCount(), BfsTree::Unreached);
+    std::deque<Vertex> queue{s};
+    level[s] = 0;
+    while (!queue.empty()) {
+        Vertex u = queue.front();
+        queue.pop_front();
+        for (std::size_t a = g.arcBegin(u); a < g.arcEnd(u); ++a) {
+            if (level[g.target(a)] != BfsTree::Unreached) continue;
+            level[g.target(a)] = level[u] + 1;
+            queue.push_back(g.target(a));
+        }
+    }
+    return level;
+}
+
+// Round-based Bellman-Ford; a relaxation in round n means a reachable
+// negative cycle
+struct Reference {
+    std::vector<long long> dist;
+    bool negativeCycle = false;
+};
+
+Reference referenceDistances(const CsrGraph &g, Vertex s) {
+    Reference ref;
+    ref.dist.assign(g.vertexCount(), Unreachable);
+    ref.dist[s] = 0;
+    for (std::size_t round = 0; round <= g.vertexCount(); ++round) {
+        bool changed = false;
+        for (Vertex u = 0; u < g.vertexCount(); ++u) {
+            if (ref.dist[u] == Unreachable) continue;
+            for (std::size_t a = g.arcBegin(u); a < g.arcEnd(u); ++a) {
+                if (ref.dist[u] + g.weight(a) >= ref.dist[g.target(a)]) continue;
+                ref.dist[g.target(a)] = ref.dist[u] + g.weight(a);
+                changed = true;
+            }
+        }
+        if (!changed) return ref;
+    }
+    ref.negativeCycle = true;
+    return ref;
+}
+
+// Textbook Floyd-Warshall; any negative diagonal entry is a negative cycle
+Reference referenceAllPairs(const CsrGraph &g) {
+    const std::size_t n = g.vertexCount();
+    Reference ref;
+    ref.dist.assign(n * n, Unreachable);
+    for (Vertex u = 0; u < n; ++u) {
+        ref.dist[u * n + u] = 0;
+        for (std::size_t a = g.arcBegin(u); a < g.arcEnd(u); ++a)
+            ref.dist[u * n + g.target(a)] = std::min(ref.dist[u * n + g.target(a)], (long long)g.weight(a));
+    }
+    for (std::size_t k = 0; k < n; ++k)
+        for (std::size_t i = 0; i < n; ++i) {
+            if (ref.dist[i * n + k] == Unreachable) continue;
+            for (std::size_t j = 0; j < n; ++j) {
+                if (ref.dist[k * n + j] == Unreachable) continue;
+                ref.dist[i * n + j] = std::min(ref.dist[i * n + j], ref.dist[i * n + k] + ref.dist[k * n + j]);
+            }
+        }
+    for (std::size_t i = 0; i < n; ++i) ref.negativeCycle |= ref.dist[i * n + i] < 0;
+    return ref;
+}
+
+// Kruskal over the edge list, edge directions ignored, ties by edge id
+std::vector<std::uint32_t> referenceForest(const CsrGraph &g, long long &weight) {
+    std::vector<std::uint32_t> order(g.edgeCount());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](std::uint32_t a, std::uint32_t b) { return g.edgeWeight(a) < g.edgeWeight(b); });
+    std::vector<Vertex> root(g.vertexCount());
+    std::iota(root.begin(), root.end(), 0);
+    auto find = [&](Vertex v) {
+        while (root[v] != v) v = root[v] = root[root[v]];
+        return v;
+    };
+    std::vector<std::uint32_t> forest;
+    weight = 0;
+    for (std::uint32_t e : order) {
+        Vertex a = find(g.edgeSource(e)), b = find(g.edgeTarget(e));
+        if (a == b) continue;
+        root[a] = b;
+        forest.push_back(e);
+        weight += g.edgeWeight(e);
+    }
+    std::sort(forest.begin(), forest.end());
+    return forest;
+}
+
+// Mutual reachability, numbered in order of each component's smallest vertex
+std::vector<std::uint32_t> referenceComponents(const CsrGraph &g, std::size_t &count) {
+    const std::size_t n = g.vertexCount();
+    std::vector<std::vector<char>> reaches(n);
+    for (Vertex s = 0; s < n; ++s) {
+        const std::vector<std::uint32_t> level = referenceLevels(g, s);
+        reaches[s].resize(n);
+        for (Vertex v = 0; v < n; ++v) reaches[s][v] = level[v] != BfsTree::Unreached;
+    }
+    std::vector<std::uint32_t> component(n, UINT32_MAX);
+    count = 0;
+    for (Vertex u = 0; u < n; ++u) {
+        if (component[u] != UINT32_MAX) continue;
+        for (Vertex v = u; v < n; ++v)
+            if (reaches[u][v] && reaches[v][u]) component[v] = (std::uint32_t)count;
+        ++count;
+    }
+    return component;
+}
+
+// ---- Checks ----
+void checkBfs(const Case &c, Vertex s) {
+    const CsrGraph &g = c.graph;
+    const std::vector<std::uint32_t> level = referenceLevels(g, s);
+    BfsTree first;
+    for (unsigned threads : ThreadCounts) {
+        BfsTree tree;
+        bfsTree(g, s, tree, nullptr, threads);
+        const std::string what = "bfsTree, " + std::to_string(threads) + " threads";
+        if (!check(tree.level == level, c.name, what + ": levels")) continue;
+        for (Vertex v = 0; v < g.vertexCount(); ++v) {
+            if (v == s || level[v] == BfsTree::Unreached) continue;
+            const Vertex p = tree.parent[v];
+            if (!check(p != CsrGraph::npos && level[p] + 1 == level[v] && arcWeight(g, p, v) != Unreachable,
+                       c.name, what + ": parent of " + std::to_string(v)))
+                break;
+        }
+        if (first.parent.empty()) first = tree;
+        else check(tree.parent == first.parent, c.name, what + ": parents differ from 1 thread");
+    }
+}
+
+void checkSingleSource(const Case &c, Vertex s) {
+    const CsrGraph &g = c.graph;
+    const Reference ref = referenceDistances(g, s);
+
+    for (unsigned threads : ThreadCounts) {
+        PathDistances out;
+        shortestDistances(g, s, out, nullptr, threads);
+        const std::string what = "shortestDistances, " + std::to_string(threads) + " threads";
+        if (check(out.negativeCycle == ref.negativeCycle, c.name, what + ": negative cycle") && !ref.negativeCycle)
+            check(out.dist == ref.dist, c.name, what + ": distances");
+    }
+
+    ShortestPathTree tree;
+    shortestPathTree(g, s, tree);
+    if (!check(tree.negativeCycle == ref.negativeCycle, c.name, "shortestPathTree: negative cycle") ||
+        ref.negativeCycle)
+        return;
+    if (!check(tree.dist == ref.dist, c.name, "shortestPathTree: distances")) return;
+    for (Vertex v = 0; v < g.vertexCount(); ++v) {
+        if (v == s || ref.dist[v] == Unreachable) continue;
+        const Vertex p = tree.parent[v];
+        if (!check(p != CsrGraph::npos && ref.dist[p] != Unreachable &&
+                       ref.dist[p] + arcWeight(g, p, v) == ref.dist[v],
+                   c.name, "shortestPathTree: parent of " + std::to_string(v)))
+            return;
+    }
+}
+
+void checkRoutes(const Case &c, Vertex s) {
+    const CsrGraph &g = c.graph;
+    const Reference ref = referenceDistances(g, s);
+    const bool negative = std::any_of(c.edges.weights.begin(), c.edges.weights.end(), [](int w) { return w < 0; });
+
+    ContractionHierarchy hierarchy;
+    LandmarkIndex landmarks;
+    if (!negative) {
+        check(hierarchy.build(g), c.name, "ContractionHierarchy::build");
+        check(landmarks.build(g), c.name, "LandmarkIndex::build");
+    }
+    ContractionHierarchy::Query hierarchyQuery(hierarchy);
+    RouteSearch search(g);
+
+    auto expect = [&](const Route &route, Vertex t, const std::string &what) {
+        if (!check(route.negativeCycle == ref.negativeCycle, c.name, what + ": negative cycle") || ref.negativeCycle)
+            return;
+        if (!check(route.distance == ref.dist[t], c.name, what + ": distance")) return;
+        if (ref.dist[t] == Unreachable) {
+            check(route.path.empty(), c.name, what + ": path without a route");
+            return;
+        }
+        check(!route.path.empty() && route.path.front() == s && route.path.back() == t &&
+                  walkLength(g, route.path) == ref.dist[t],
+              c.name, what + ": path");
+    };
+
+    for (Vertex t = 0; t < g.vertexCount(); t += 7) {
+        const std::string to = " to " + std::to_string(t);
+        Route route;
+        shortestRoute(g, s, t, route);
+        expect(route, t, "shortestRoute" + to);
+
+        Route reused;
+        search.bidirectional(s, t, reused);
+        expect(reused, t, "RouteSearch::bidirectional" + to);
+
+        if (!c.edges.coordinates.empty()) {
+            Route guided;
+            shortestRoute(g, s, t, c.edges.coordinates, guided);
+            expect(guided, t, "shortestRoute with coordinates" + to);
+        }
+        if (!hierarchy.empty()) {
+            Route climbed;
+            hierarchyQuery.route(s, t, climbed);
+            expect(climbed, t, "ContractionHierarchy" + to);
+        }
+        if (!landmarks.empty()) {
+            Route bounded;
+            routeAStar(g, s, t, landmarks.heuristic(t), bounded, nullptr);
+            expect(bounded, t, "landmark A*" + to);
+        }
+    }
+}
+
+void checkAllPairs(const Case &c) {
+    const CsrGraph &g = c.graph;
+    const std::size_t n = g.vertexCount();
+    const Reference ref = referenceAllPairs(g);
+    for (unsigned threads : ThreadCounts) {
+        AllPairsPaths out;
+        allPairsShortestPaths(g, out, nullptr, threads);
+        const std::string what = "allPairsShortestPaths, " + std::to_string(threads) + " threads";
+        if (!check(out.negativeCycle == ref.negativeCycle, c.name, what + ": negative cycle") || ref.negativeCycle)
+            continue;
+        if (!check(out.n == n && out.dist == ref.dist, c.name, what + ": distances")) continue;
+        for (Vertex i = 0; i < n; ++i)
+            for (Vertex j = 0; j < n; ++j) {
+                const std::vector<Vertex> path = out.path(i, j);
+                const bool ok = ref.dist[i * n + j] == Unreachable
+                                    ? path.empty() && out.next[i * n + j] == CsrGraph::npos
+                                    : !path.empty() && path.front() == i && path.back() == j &&
+                                          walkLength(g, path) == ref.dist[i * n + j];
+                if (!check(ok, c.name, what + ": path " + std::to_string(i) + " -> " + std::to_string(j))) {
+                    i = (Vertex)n;
+                    break;
+                }
+            }
+    }
+}
+
+void checkForest(const Case &c) {
+    long long weight;
+    const std::vector<std::uint32_t> edges = referenceForest(c.graph, weight);
+    for (MstMethod method : {MstMethod::Boruvka, MstMethod::FilterKruskal})
+        for (unsigned threads : ThreadCounts) {
+            SpanningForest out;
+            minimumSpanningForest(c.graph, out, method, nullptr, threads);
+            std::sort(out.edges.begin(), out.edges.end());
+            check(out.weight == weight && out.edges == edges, c.name,
+                  std::string(method == MstMethod::Boruvka ? "Boruvka" : "filter-Kruskal") + ", " +
+                      std::to_string(threads) + " threads: forest");
+        }
+}
+
+void checkComponents(const Case &c) {
+    const CsrGraph &g = c.graph;
+    std::size_t count;
+    const std::vector<std::uint32_t> component = referenceComponents(g, count);
+    std::vector<std::size_t> size(count, 0);
+    for (std::uint32_t id : component) ++size[id];
+
+    for (SccMethod method : {SccMethod::Tarjan, SccMethod::ForwardBackward})
+        for (unsigned threads : ThreadCounts) {
+            if (method == SccMethod::Tarjan && threads > 1) continue;
+            StrongComponents out;
+            strongComponents(g, out, method, nullptr, threads);
+            const std::string what = std::string(method == SccMethod::Tarjan ? "Tarjan" : "forward-backward") +
+                                     ", " + std::to_string(threads) + " threads";
+            if (!check(out.count == count && out.component == component, c.name, what + ": components")) continue;
+
+            std::vector<char> cyclic(count, 0);
+            std::vector<std::size_t> position(count);
+            for (std::size_t i = 0; i < out.order.size(); ++i) position[out.order[i]] = i;
+            bool dagOk = out.order.size() == count && out.dagBegin.size() == count + 1;
+            for (Vertex u = 0; u < g.vertexCount() && dagOk; ++u) {
+                const std::uint32_t cu = component[u];
+                if (size[cu] > 1) cyclic[cu] = 1;
+                for (std::size_t a = g.arcBegin(u); a < g.arcEnd(u) && dagOk; ++a) {
+                    const std::uint32_t cv = component[g.target(a)];
+                    if (g.target(a) == u) cyclic[cu] = 1;
+                    if (cu == cv) continue;
+                    auto first = out.dagTargets.begin() + out.dagBegin[cu];
+                    auto last = out.dagTargets.begin() + out.dagBegin[cu + 1];
+                    dagOk = std::count(first, last, cv) == 1 && position[cu] < position[cv];
+                }
+            }
+            check(dagOk, c.name, what + ": condensation");
+            check(out.cyclic == cyclic, c.name, what + ": cyclic components");
+        }
+}
+
+} // namespace
+
+int main() {
+    const std::vector<Case> cases = buildCases();
+    for (const Case &c : cases) {
+        const Vertex sources[] = {0, (Vertex)(c.graph.vertexCount() / 2)};
+        for (Vertex s : sources) {
+            checkBfs(c, s);
+            checkSingleSource(c, s);
+            checkRoutes(c, s);
+        }
+        checkAllPairs(c);
+        checkForest(c);
+        checkComponents(c);
+    }
+    if (failures) {
+        std::printf("%d checks failed on %zu graphs\n", failures, cases.size());
+        return 1;
+    }
+    std::printf("all engines agree with the references on %zu graphs\n", cases.size());
+    return 0;
+}